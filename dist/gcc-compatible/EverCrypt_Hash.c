@@ -60,6 +60,22 @@ C_String_t EverCrypt_Hash_string_of_alg(Spec_Hash_Definitions_hash_alg uu___)
       {
         return "Blake2B";
       }
+    case Spec_Hash_Definitions_SHA3_224:
+      {
+        return "SHA3_224";
+      }
+    case Spec_Hash_Definitions_SHA3_256:
+      {
+        return "SHA3_256";
+      }
+    case Spec_Hash_Definitions_SHA3_384:
+      {
+        return "SHA3_384";
+      }
+    case Spec_Hash_Definitions_SHA3_512:
+      {
+        return "SHA3_512";
+      }
     default:
       {
         KRML_HOST_EPRINTF("KreMLin incomplete match at %s:%d\n", __FILE__, __LINE__);
@@ -308,6 +324,126 @@ uint64_t
   KRML_HOST_EXIT(255U);
 }
 
+bool
+EverCrypt_Hash_uu___is_SHA3_224_s(
+  Spec_Hash_Definitions_hash_alg uu___,
+  EverCrypt_Hash_state_s projectee
+)
+{
+  if (projectee.tag == EverCrypt_Hash_SHA3_224_s)
+  {
+    return true;
+  }
+  return false;
+}
+
+uint64_t
+*EverCrypt_Hash___proj__SHA3_224_s__item__p(
+  Spec_Hash_Definitions_hash_alg uu___,
+  EverCrypt_Hash_state_s projectee
+)
+{
+  if (projectee.tag == EverCrypt_Hash_SHA3_224_s)
+  {
+    return projectee.case_SHA3_224_s;
+  }
+  KRML_HOST_EPRINTF("KreMLin abort at %s:%d\n%s\n",
+    __FILE__,
+    __LINE__,
+    "unreachable (pattern matches are exhaustive in F*)");
+  KRML_HOST_EXIT(255U);
+}
+
+bool
+EverCrypt_Hash_uu___is_SHA3_256_s(
+  Spec_Hash_Definitions_hash_alg uu___,
+  EverCrypt_Hash_state_s projectee
+)
+{
+  if (projectee.tag == EverCrypt_Hash_SHA3_256_s)
+  {
+    return true;
+  }
+  return false;
+}
+
+uint64_t
+*EverCrypt_Hash___proj__SHA3_256_s__item__p(
+  Spec_Hash_Definitions_hash_alg uu___,
+  EverCrypt_Hash_state_s projectee
+)
+{
+  if (projectee.tag == EverCrypt_Hash_SHA3_256_s)
+  {
+    return projectee.case_SHA3_256_s;
+  }
+  KRML_HOST_EPRINTF("KreMLin abort at %s:%d\n%s\n",
+    __FILE__,
+    __LINE__,
+    "unreachable (pattern matches are exhaustive in F*)");
+  KRML_HOST_EXIT(255U);
+}
+
+bool
+EverCrypt_Hash_uu___is_SHA3_384_s(
+  Spec_Hash_Definitions_hash_alg uu___,
+  EverCrypt_Hash_state_s projectee
+)
+{
+  if (projectee.tag == EverCrypt_Hash_SHA3_384_s)
+  {
+    return true;
+  }
+  return false;
+}
+
+uint64_t
+*EverCrypt_Hash___proj__SHA3_384_s__item__p(
+  Spec_Hash_Definitions_hash_alg uu___,
+  EverCrypt_Hash_state_s projectee
+)
+{
+  if (projectee.tag == EverCrypt_Hash_SHA3_384_s)
+  {
+    return projectee.case_SHA3_384_s;
+  }
+  KRML_HOST_EPRINTF("KreMLin abort at %s:%d\n%s\n",
+    __FILE__,
+    __LINE__,
+    "unreachable (pattern matches are exhaustive in F*)");
+  KRML_HOST_EXIT(255U);
+}
+
+bool
+EverCrypt_Hash_uu___is_SHA3_512_s(
+  Spec_Hash_Definitions_hash_alg uu___,
+  EverCrypt_Hash_state_s projectee
+)
+{
+  if (projectee.tag == EverCrypt_Hash_SHA3_512_s)
+  {
+    return true;
+  }
+  return false;
+}
+
+uint64_t
+*EverCrypt_Hash___proj__SHA3_512_s__item__p(
+  Spec_Hash_Definitions_hash_alg uu___,
+  EverCrypt_Hash_state_s projectee
+)
+{
+  if (projectee.tag == EverCrypt_Hash_SHA3_512_s)
+  {
+    return projectee.case_SHA3_512_s;
+  }
+  KRML_HOST_EPRINTF("KreMLin abort at %s:%d\n%s\n",
+    __FILE__,
+    __LINE__,
+    "unreachable (pattern matches are exhaustive in F*)");
+  KRML_HOST_EXIT(255U);
+}
+
 Spec_Hash_Definitions_hash_alg EverCrypt_Hash_alg_of_state(EverCrypt_Hash_state_s *s)
 {
   EverCrypt_Hash_state_s scrut = *s;
@@ -343,6 +479,22 @@ Spec_Hash_Definitions_hash_alg EverCrypt_Hash_alg_of_state(EverCrypt_Hash_state_
   {
     return Spec_Hash_Definitions_Blake2B;
   }
+  if (scrut.tag == EverCrypt_Hash_SHA3_224_s)
+  {
+    return Spec_Hash_Definitions_SHA3_224;
+  }
+  if (scrut.tag == EverCrypt_Hash_SHA3_256_s)
+  {
+    return Spec_Hash_Definitions_SHA3_256;
+  }
+  if (scrut.tag == EverCrypt_Hash_SHA3_384_s)
+  {
+    return Spec_Hash_Definitions_SHA3_384;
+  }
+  if (scrut.tag == EverCrypt_Hash_SHA3_512_s)
+  {
+    return Spec_Hash_Definitions_SHA3_512;
+  }
   KRML_HOST_EPRINTF("KreMLin abort at %s:%d\n%s\n",
     __FILE__,
     __LINE__,
@@ -407,6 +559,34 @@ EverCrypt_Hash_state_s *EverCrypt_Hash_create_in(Spec_Hash_Definitions_hash_alg
         s = ((EverCrypt_Hash_state_s){ .tag = EverCrypt_Hash_Blake2B_s, { .case_Blake2B_s = buf } });
         break;
       }
+    case Spec_Hash_Definitions_SHA3_224:
+      {
+        uint64_t *buf = KRML_HOST_CALLOC((uint32_t)25U, sizeof (uint64_t));
+        s =
+          ((EverCrypt_Hash_state_s){ .tag = EverCrypt_Hash_SHA3_224_s, { .case_SHA3_224_s = buf } });
+        break;
+      }
+    case Spec_Hash_Definitions_SHA3_256:
+      {
+        uint64_t *buf = KRML_HOST_CALLOC((uint32_t)25U, sizeof (uint64_t));
+        s =
+          ((EverCrypt_Hash_state_s){ .tag = EverCrypt_Hash_SHA3_256_s, { .case_SHA3_256_s = buf } });
+        break;
+      }
+    case Spec_Hash_Definitions_SHA3_384:
+      {
+        uint64_t *buf = KRML_HOST_CALLOC((uint32_t)25U, sizeof (uint64_t));
+        s =
+          ((EverCrypt_Hash_state_s){ .tag = EverCrypt_Hash_SHA3_384_s, { .case_SHA3_384_s = buf } });
+        break;
+      }
+    case Spec_Hash_Definitions_SHA3_512:
+      {
+        uint64_t *buf = KRML_HOST_CALLOC((uint32_t)25U, sizeof (uint64_t));
+        s =
+          ((EverCrypt_Hash_state_s){ .tag = EverCrypt_Hash_SHA3_512_s, { .case_SHA3_512_s = buf } });
+        break;
+      }
     default:
       {
         KRML_HOST_EPRINTF("KreMLin incomplete match at %s:%d\n", __FILE__, __LINE__);
@@ -535,6 +715,30 @@ void EverCrypt_Hash_init(EverCrypt_Hash_state_s *s)
     FStar_UInt128_uint128 uu____1 = FStar_UInt128_uint64_to_uint128((uint64_t)0U);
     return;
   }
+  if (scrut.tag == EverCrypt_Hash_SHA3_224_s)
+  {
+    uint64_t *p1 = scrut.case_SHA3_224_s;
+    memset(p1, 0U, (uint32_t)25U * sizeof (uint64_t));
+    return;
+  }
+  if (scrut.tag == EverCrypt_Hash_SHA3_256_s)
+  {
+    uint64_t *p1 = scrut.case_SHA3_256_s;
+    memset(p1, 0U, (uint32_t)25U * sizeof (uint64_t));
+    return;
+  }
+  if (scrut.tag == EverCrypt_Hash_SHA3_384_s)
+  {
+    uint64_t *p1 = scrut.case_SHA3_384_s;
+    memset(p1, 0U, (uint32_t)25U * sizeof (uint64_t));
+    return;
+  }
+  if (scrut.tag == EverCrypt_Hash_SHA3_512_s)
+  {
+    uint64_t *p1 = scrut.case_SHA3_512_s;
+    memset(p1, 0U, (uint32_t)25U * sizeof (uint64_t));
+    return;
+  }
   KRML_HOST_EPRINTF("KreMLin abort at %s:%d\n%s\n",
     __FILE__,
     __LINE__,
@@ -633,6 +837,34 @@ void EverCrypt_Hash_update2(EverCrypt_Hash_state_s *s, uint64_t prevlen, uint8_t
         block);
     return;
   }
+  if (scrut.tag == EverCrypt_Hash_SHA3_224_s)
+  {
+    uint64_t *p1 = scrut.case_SHA3_224_s;
+    Hacl_Impl_SHA3_loadState((uint32_t)144U, block, p1);
+    Hacl_Impl_SHA3_state_permute(p1);
+    return;
+  }
+  if (scrut.tag == EverCrypt_Hash_SHA3_256_s)
+  {
+    uint64_t *p1 = scrut.case_SHA3_256_s;
+    Hacl_Impl_SHA3_loadState((uint32_t)136U, block, p1);
+    Hacl_Impl_SHA3_state_permute(p1);
+    return;
+  }
+  if (scrut.tag == EverCrypt_Hash_SHA3_384_s)
+  {
+    uint64_t *p1 = scrut.case_SHA3_384_s;
+    Hacl_Impl_SHA3_loadState((uint32_t)104U, block, p1);
+    Hacl_Impl_SHA3_state_permute(p1);
+    return;
+  }
+  if (scrut.tag == EverCrypt_Hash_SHA3_512_s)
+  {
+    uint64_t *p1 = scrut.case_SHA3_512_s;
+    Hacl_Impl_SHA3_loadState((uint32_t)72U, block, p1);
+    Hacl_Impl_SHA3_state_permute(p1);
+    return;
+  }
   KRML_HOST_EPRINTF("KreMLin abort at %s:%d\n%s\n",
     __FILE__,
     __LINE__,
@@ -717,6 +949,50 @@ EverCrypt_Hash_update_multi2(
         n);
     return;
   }
+  if (scrut.tag == EverCrypt_Hash_SHA3_224_s)
+  {
+    uint64_t *p1 = scrut.case_SHA3_224_s;
+    uint32_t n = len / (uint32_t)144U;
+    for (uint32_t i = (uint32_t)0U; i < n; i++)
+    {
+      Hacl_Impl_SHA3_loadState((uint32_t)144U, blocks + i * (uint32_t)144U, p1);
+      Hacl_Impl_SHA3_state_permute(p1);
+    }
+    return;
+  }
+  if (scrut.tag == EverCrypt_Hash_SHA3_256_s)
+  {
+    uint64_t *p1 = scrut.case_SHA3_256_s;
+    uint32_t n = len / (uint32_t)136U;
+    for (uint32_t i = (uint32_t)0U; i < n; i++)
+    {
+      Hacl_Impl_SHA3_loadState((uint32_t)136U, blocks + i * (uint32_t)136U, p1);
+      Hacl_Impl_SHA3_state_permute(p1);
+    }
+    return;
+  }
+  if (scrut.tag == EverCrypt_Hash_SHA3_384_s)
+  {
+    uint64_t *p1 = scrut.case_SHA3_384_s;
+    uint32_t n = len / (uint32_t)104U;
+    for (uint32_t i = (uint32_t)0U; i < n; i++)
+    {
+      Hacl_Impl_SHA3_loadState((uint32_t)104U, blocks + i * (uint32_t)104U, p1);
+      Hacl_Impl_SHA3_state_permute(p1);
+    }
+    return;
+  }
+  if (scrut.tag == EverCrypt_Hash_SHA3_512_s)
+  {
+    uint64_t *p1 = scrut.case_SHA3_512_s;
+    uint32_t n = len / (uint32_t)72U;
+    for (uint32_t i = (uint32_t)0U; i < n; i++)
+    {
+      Hacl_Impl_SHA3_loadState((uint32_t)72U, blocks + i * (uint32_t)72U, p1);
+      Hacl_Impl_SHA3_state_permute(p1);
+    }
+    return;
+  }
   KRML_HOST_EPRINTF("KreMLin abort at %s:%d\n%s\n",
     __FILE__,
     __LINE__,
@@ -826,6 +1102,30 @@ EverCrypt_Hash_update_last2(
         last_len);
     return;
   }
+  if (scrut.tag == EverCrypt_Hash_SHA3_224_s)
+  {
+    uint64_t *p1 = scrut.case_SHA3_224_s;
+    Hacl_Impl_SHA3_absorb(p1, (uint32_t)144U, last_len, last, (uint8_t)0x06U);
+    return;
+  }
+  if (scrut.tag == EverCrypt_Hash_SHA3_256_s)
+  {
+    uint64_t *p1 = scrut.case_SHA3_256_s;
+    Hacl_Impl_SHA3_absorb(p1, (uint32_t)136U, last_len, last, (uint8_t)0x06U);
+    return;
+  }
+  if (scrut.tag == EverCrypt_Hash_SHA3_384_s)
+  {
+    uint64_t *p1 = scrut.case_SHA3_384_s;
+    Hacl_Impl_SHA3_absorb(p1, (uint32_t)104U, last_len, last, (uint8_t)0x06U);
+    return;
+  }
+  if (scrut.tag == EverCrypt_Hash_SHA3_512_s)
+  {
+    uint64_t *p1 = scrut.case_SHA3_512_s;
+    Hacl_Impl_SHA3_absorb(p1, (uint32_t)72U, last_len, last, (uint8_t)0x06U);
+    return;
+  }
   KRML_HOST_EPRINTF("KreMLin abort at %s:%d\n%s\n",
     __FILE__,
     __LINE__,
@@ -881,6 +1181,26 @@ void EverCrypt_Hash_update_last(EverCrypt_Hash_state_s *s, uint8_t *last, uint64
         sw = (uint32_t)128U;
         break;
       }
+    case Spec_Hash_Definitions_SHA3_224:
+      {
+        sw = (uint32_t)144U;
+        break;
+      }
+    case Spec_Hash_Definitions_SHA3_256:
+      {
+        sw = (uint32_t)136U;
+        break;
+      }
+    case Spec_Hash_Definitions_SHA3_384:
+      {
+        sw = (uint32_t)104U;
+        break;
+      }
+    case Spec_Hash_Definitions_SHA3_512:
+      {
+        sw = (uint32_t)72U;
+        break;
+      }
     default:
       {
         KRML_HOST_EPRINTF("KreMLin incomplete match at %s:%d\n", __FILE__, __LINE__);
@@ -945,6 +1265,30 @@ void EverCrypt_Hash_finish(EverCrypt_Hash_state_s *s, uint8_t *dst)
       dst);
     return;
   }
+  if (scrut.tag == EverCrypt_Hash_SHA3_224_s)
+  {
+    uint64_t *p1 = scrut.case_SHA3_224_s;
+    Hacl_Impl_SHA3_storeState((uint32_t)28U, p1, dst);
+    return;
+  }
+  if (scrut.tag == EverCrypt_Hash_SHA3_256_s)
+  {
+    uint64_t *p1 = scrut.case_SHA3_256_s;
+    Hacl_Impl_SHA3_storeState((uint32_t)32U, p1, dst);
+    return;
+  }
+  if (scrut.tag == EverCrypt_Hash_SHA3_384_s)
+  {
+    uint64_t *p1 = scrut.case_SHA3_384_s;
+    Hacl_Impl_SHA3_storeState((uint32_t)48U, p1, dst);
+    return;
+  }
+  if (scrut.tag == EverCrypt_Hash_SHA3_512_s)
+  {
+    uint64_t *p1 = scrut.case_SHA3_512_s;
+    Hacl_Impl_SHA3_storeState((uint32_t)64U, p1, dst);
+    return;
+  }
   KRML_HOST_EPRINTF("KreMLin abort at %s:%d\n%s\n",
     __FILE__,
     __LINE__,
@@ -995,6 +1339,26 @@ void EverCrypt_Hash_free(EverCrypt_Hash_state_s *s)
     uint64_t *p1 = scrut.case_Blake2B_s;
     KRML_HOST_FREE(p1);
   }
+  else if (scrut.tag == EverCrypt_Hash_SHA3_224_s)
+  {
+    uint64_t *p1 = scrut.case_SHA3_224_s;
+    KRML_HOST_FREE(p1);
+  }
+  else if (scrut.tag == EverCrypt_Hash_SHA3_256_s)
+  {
+    uint64_t *p1 = scrut.case_SHA3_256_s;
+    KRML_HOST_FREE(p1);
+  }
+  else if (scrut.tag == EverCrypt_Hash_SHA3_384_s)
+  {
+    uint64_t *p1 = scrut.case_SHA3_384_s;
+    KRML_HOST_FREE(p1);
+  }
+  else if (scrut.tag == EverCrypt_Hash_SHA3_512_s)
+  {
+    uint64_t *p1 = scrut.case_SHA3_512_s;
+    KRML_HOST_FREE(p1);
+  }
   else
   {
     KRML_HOST_EPRINTF("KreMLin abort at %s:%d\n%s\n",
@@ -1137,32 +1501,96 @@ void EverCrypt_Hash_copy(EverCrypt_Hash_state_s *s_src, EverCrypt_Hash_state_s *
     memcpy(p_dst, p_src, (uint32_t)16U * sizeof (uint64_t));
     return;
   }
-  KRML_HOST_EPRINTF("KreMLin abort at %s:%d\n%s\n",
-    __FILE__,
-    __LINE__,
-    "unreachable (pattern matches are exhaustive in F*)");
-  KRML_HOST_EXIT(255U);
-}
-
-void EverCrypt_Hash_hash_256(uint8_t *input, uint32_t input_len, uint8_t *dst)
-{
-  uint32_t
-  scrut[8U] =
-    {
-      (uint32_t)0x6a09e667U, (uint32_t)0xbb67ae85U, (uint32_t)0x3c6ef372U, (uint32_t)0xa54ff53aU,
-      (uint32_t)0x510e527fU, (uint32_t)0x9b05688cU, (uint32_t)0x1f83d9abU, (uint32_t)0x5be0cd19U
-    };
-  uint32_t *s = scrut;
-  uint32_t blocks_n0 = input_len / (uint32_t)64U;
-  uint32_t blocks_n1;
-  if (input_len % (uint32_t)64U == (uint32_t)0U && blocks_n0 > (uint32_t)0U)
+  if (scrut.tag == EverCrypt_Hash_SHA3_224_s)
   {
-    blocks_n1 = blocks_n0 - (uint32_t)1U;
+    uint64_t *p_src = scrut.case_SHA3_224_s;
+    EverCrypt_Hash_state_s x1 = *s_dst;
+    uint64_t *p_dst;
+    if (x1.tag == EverCrypt_Hash_SHA3_224_s)
+    {
+      p_dst = x1.case_SHA3_224_s;
+    }
+    else
+    {
+      p_dst = KRML_EABORT(uint64_t *, "unreachable (pattern matches are exhaustive in F*)");
+    }
+    memcpy(p_dst, p_src, (uint32_t)25U * sizeof (uint64_t));
+    return;
   }
-  else
+  if (scrut.tag == EverCrypt_Hash_SHA3_256_s)
   {
-    blocks_n1 = blocks_n0;
-  }
+    uint64_t *p_src = scrut.case_SHA3_256_s;
+    EverCrypt_Hash_state_s x1 = *s_dst;
+    uint64_t *p_dst;
+    if (x1.tag == EverCrypt_Hash_SHA3_256_s)
+    {
+      p_dst = x1.case_SHA3_256_s;
+    }
+    else
+    {
+      p_dst = KRML_EABORT(uint64_t *, "unreachable (pattern matches are exhaustive in F*)");
+    }
+    memcpy(p_dst, p_src, (uint32_t)25U * sizeof (uint64_t));
+    return;
+  }
+  if (scrut.tag == EverCrypt_Hash_SHA3_384_s)
+  {
+    uint64_t *p_src = scrut.case_SHA3_384_s;
+    EverCrypt_Hash_state_s x1 = *s_dst;
+    uint64_t *p_dst;
+    if (x1.tag == EverCrypt_Hash_SHA3_384_s)
+    {
+      p_dst = x1.case_SHA3_384_s;
+    }
+    else
+    {
+      p_dst = KRML_EABORT(uint64_t *, "unreachable (pattern matches are exhaustive in F*)");
+    }
+    memcpy(p_dst, p_src, (uint32_t)25U * sizeof (uint64_t));
+    return;
+  }
+  if (scrut.tag == EverCrypt_Hash_SHA3_512_s)
+  {
+    uint64_t *p_src = scrut.case_SHA3_512_s;
+    EverCrypt_Hash_state_s x1 = *s_dst;
+    uint64_t *p_dst;
+    if (x1.tag == EverCrypt_Hash_SHA3_512_s)
+    {
+      p_dst = x1.case_SHA3_512_s;
+    }
+    else
+    {
+      p_dst = KRML_EABORT(uint64_t *, "unreachable (pattern matches are exhaustive in F*)");
+    }
+    memcpy(p_dst, p_src, (uint32_t)25U * sizeof (uint64_t));
+    return;
+  }
+  KRML_HOST_EPRINTF("KreMLin abort at %s:%d\n%s\n",
+    __FILE__,
+    __LINE__,
+    "unreachable (pattern matches are exhaustive in F*)");
+  KRML_HOST_EXIT(255U);
+}
+
+void EverCrypt_Hash_hash_256(uint8_t *input, uint32_t input_len, uint8_t *dst)
+{
+  uint32_t
+  scrut[8U] =
+    {
+      (uint32_t)0x6a09e667U, (uint32_t)0xbb67ae85U, (uint32_t)0x3c6ef372U, (uint32_t)0xa54ff53aU,
+      (uint32_t)0x510e527fU, (uint32_t)0x9b05688cU, (uint32_t)0x1f83d9abU, (uint32_t)0x5be0cd19U
+    };
+  uint32_t *s = scrut;
+  uint32_t blocks_n0 = input_len / (uint32_t)64U;
+  uint32_t blocks_n1;
+  if (input_len % (uint32_t)64U == (uint32_t)0U && blocks_n0 > (uint32_t)0U)
+  {
+    blocks_n1 = blocks_n0 - (uint32_t)1U;
+  }
+  else
+  {
+    blocks_n1 = blocks_n0;
+  }
   uint32_t blocks_len0 = blocks_n1 * (uint32_t)64U;
   uint8_t *blocks0 = input;
   uint32_t rest_len0 = input_len - blocks_len0;
@@ -1210,6 +1638,86 @@ void EverCrypt_Hash_hash_224(uint8_t *input, uint32_t input_len, uint8_t *dst)
   Hacl_Hash_Core_SHA2_finish_224(s, dst);
 }
 
+/*
+  Hash `n` independent messages with SHA2-256: `dsts[i]` receives the digest of
+  the `input_lens[i]` bytes at `inputs[i]`. With SHA-NI, each message goes through
+  the Vale implementation; otherwise, this is Hacl_Hash_SHA2_256_mb.
+*/
+void
+EverCrypt_Hash_hash_256_mb(
+  uint32_t n,
+  uint8_t **inputs,
+  uint32_t *input_lens,
+  uint8_t **dsts
+)
+{
+  if (EverCrypt_AutoConfig2_has_shaext())
+  {
+    for (uint32_t i = (uint32_t)0U; i < n; i++)
+    {
+      EverCrypt_Hash_hash_256(inputs[i], input_lens[i], dsts[i]);
+    }
+    return;
+  }
+  Hacl_Hash_SHA2_256_mb(n, inputs, input_lens, dsts);
+}
+
+/*
+  Apply the SHA2-256 compression function to the 64-byte block made of the 32
+  bytes at `src1` followed by the 32 bytes at `src2`, starting from the SHA2-256
+  initial hash value and without padding, and write the resulting state to `dst`.
+  `dst` may alias `src1` or `src2`.
+*/
+void EverCrypt_Hash_compress_256(uint8_t *src1, uint8_t *src2, uint8_t *dst)
+{
+  uint32_t s[8U] = { 0U };
+  uint8_t block[64U] = { 0U };
+  memcpy(block, src1, (uint32_t)32U * sizeof (uint8_t));
+  memcpy(block + (uint32_t)32U, src2, (uint32_t)32U * sizeof (uint8_t));
+  Hacl_Hash_Core_SHA2_init_256(s);
+  EverCrypt_Hash_update_multi_256(s, block, (uint32_t)1U);
+  Hacl_Hash_Core_SHA2_finish_256(s, dst);
+}
+
+/*
+  Apply the SHA2-256 compression function to `n` independent 64-byte blocks,
+  starting from the SHA2-256 initial hash value and without padding: `dsts[i]`
+  receives the state after compressing the 32 bytes at `src1[i]` followed by the
+  32 bytes at `src2[i]`. This is the node hash of binary Merkle trees over
+  SHA2-256. When SHA-NI is not available, blocks are compressed 8 (vec256) or 4
+  (vec128) at a time, one block per vector lane.
+*/
+void
+EverCrypt_Hash_compress_256_mb(uint32_t n, uint8_t **src1, uint8_t **src2, uint8_t **dsts)
+{
+  bool shaext = EverCrypt_AutoConfig2_has_shaext();
+  bool vec256 = EverCrypt_AutoConfig2_has_vec256();
+  bool vec128 = EverCrypt_AutoConfig2_has_vec128();
+  uint32_t j = (uint32_t)0U;
+  #if HACL_CAN_COMPILE_VEC256
+  if (!shaext && vec256)
+  {
+    for (; j + (uint32_t)8U <= n; j = j + (uint32_t)8U)
+    {
+      Hacl_SHA2_Vec256_sha256_compress8(dsts + j, src1 + j, src2 + j);
+    }
+  }
+  #endif
+  #if HACL_CAN_COMPILE_VEC128
+  if (!shaext && vec128)
+  {
+    for (; j + (uint32_t)4U <= n; j = j + (uint32_t)4U)
+    {
+      Hacl_SHA2_Vec128_sha256_compress4(dsts + j, src1 + j, src2 + j);
+    }
+  }
+  #endif
+  for (; j < n; j++)
+  {
+    EverCrypt_Hash_compress_256(src1[j], src2[j], dsts[j]);
+  }
+}
+
 void
 EverCrypt_Hash_hash(
   Spec_Hash_Definitions_hash_alg a,
@@ -1260,6 +1768,26 @@ EverCrypt_Hash_hash(
         Hacl_Hash_Blake2_hash_blake2b_32(input, len, dst);
         break;
       }
+    case Spec_Hash_Definitions_SHA3_224:
+      {
+        Hacl_SHA3_sha3_224(len, input, dst);
+        break;
+      }
+    case Spec_Hash_Definitions_SHA3_256:
+      {
+        Hacl_SHA3_sha3_256(len, input, dst);
+        break;
+      }
+    case Spec_Hash_Definitions_SHA3_384:
+      {
+        Hacl_SHA3_sha3_384(len, input, dst);
+        break;
+      }
+    case Spec_Hash_Definitions_SHA3_512:
+      {
+        Hacl_SHA3_sha3_512(len, input, dst);
+        break;
+      }
     default:
       {
         KRML_HOST_EPRINTF("KreMLin incomplete match at %s:%d\n", __FILE__, __LINE__);
@@ -1304,6 +1832,22 @@ uint32_t EverCrypt_Hash_Incremental_hash_len(Spec_Hash_Definitions_hash_alg a)
       {
         return (uint32_t)64U;
       }
+    case Spec_Hash_Definitions_SHA3_224:
+      {
+        return (uint32_t)28U;
+      }
+    case Spec_Hash_Definitions_SHA3_256:
+      {
+        return (uint32_t)32U;
+      }
+    case Spec_Hash_Definitions_SHA3_384:
+      {
+        return (uint32_t)48U;
+      }
+    case Spec_Hash_Definitions_SHA3_512:
+      {
+        return (uint32_t)64U;
+      }
     default:
       {
         KRML_HOST_EPRINTF("KreMLin incomplete match at %s:%d\n", __FILE__, __LINE__);
@@ -1348,6 +1892,22 @@ uint32_t EverCrypt_Hash_Incremental_block_len(Spec_Hash_Definitions_hash_alg a)
       {
         return (uint32_t)128U;
       }
+    case Spec_Hash_Definitions_SHA3_224:
+      {
+        return (uint32_t)144U;
+      }
+    case Spec_Hash_Definitions_SHA3_256:
+      {
+        return (uint32_t)136U;
+      }
+    case Spec_Hash_Definitions_SHA3_384:
+      {
+        return (uint32_t)104U;
+      }
+    case Spec_Hash_Definitions_SHA3_512:
+      {
+        return (uint32_t)72U;
+      }
     default:
       {
         KRML_HOST_EPRINTF("KreMLin incomplete match at %s:%d\n", __FILE__, __LINE__);
@@ -2062,6 +2622,230 @@ EverCrypt_Hash_Incremental_finish_blake2b(
   EverCrypt_Hash_finish(&tmp_block_state, dst);
 }
 
+void
+EverCrypt_Hash_Incremental_finish_sha3_224(
+  Hacl_Streaming_Functor_state_s___EverCrypt_Hash_state_s____ *p,
+  uint8_t *dst
+)
+{
+  Hacl_Streaming_Functor_state_s___EverCrypt_Hash_state_s____ scrut = *p;
+  EverCrypt_Hash_state_s *block_state = scrut.block_state;
+  uint8_t *buf_ = scrut.buf;
+  uint64_t total_len = scrut.total_len;
+  uint32_t r;
+  if
+  (
+    total_len
+    % (uint64_t)EverCrypt_Hash_Incremental_block_len(Spec_Hash_Definitions_SHA3_224)
+    == (uint64_t)0U
+    && total_len > (uint64_t)0U
+  )
+  {
+    r = EverCrypt_Hash_Incremental_block_len(Spec_Hash_Definitions_SHA3_224);
+  }
+  else
+  {
+    r =
+      (uint32_t)(total_len
+      % (uint64_t)EverCrypt_Hash_Incremental_block_len(Spec_Hash_Definitions_SHA3_224));
+  }
+  uint8_t *buf_1 = buf_;
+  uint64_t buf[25U] = { 0U };
+  EverCrypt_Hash_state_s s = { .tag = EverCrypt_Hash_SHA3_224_s, { .case_SHA3_224_s = buf } };
+  EverCrypt_Hash_state_s tmp_block_state = s;
+  EverCrypt_Hash_copy(block_state, &tmp_block_state);
+  uint64_t prev_len = total_len - (uint64_t)r;
+  uint32_t ite;
+  if
+  (
+    r
+    % EverCrypt_Hash_Incremental_block_len(Spec_Hash_Definitions_SHA3_224)
+    == (uint32_t)0U
+    && r > (uint32_t)0U
+  )
+  {
+    ite = EverCrypt_Hash_Incremental_block_len(Spec_Hash_Definitions_SHA3_224);
+  }
+  else
+  {
+    ite = r % EverCrypt_Hash_Incremental_block_len(Spec_Hash_Definitions_SHA3_224);
+  }
+  uint8_t *buf_last = buf_1 + r - ite;
+  uint8_t *buf_multi = buf_1;
+  EverCrypt_Hash_update_multi2(&tmp_block_state, prev_len, buf_multi, (uint32_t)0U);
+  uint64_t prev_len_last = total_len - (uint64_t)r;
+  EverCrypt_Hash_update_last2(&tmp_block_state, prev_len_last, buf_last, r);
+  EverCrypt_Hash_finish(&tmp_block_state, dst);
+}
+
+void
+EverCrypt_Hash_Incremental_finish_sha3_256(
+  Hacl_Streaming_Functor_state_s___EverCrypt_Hash_state_s____ *p,
+  uint8_t *dst
+)
+{
+  Hacl_Streaming_Functor_state_s___EverCrypt_Hash_state_s____ scrut = *p;
+  EverCrypt_Hash_state_s *block_state = scrut.block_state;
+  uint8_t *buf_ = scrut.buf;
+  uint64_t total_len = scrut.total_len;
+  uint32_t r;
+  if
+  (
+    total_len
+    % (uint64_t)EverCrypt_Hash_Incremental_block_len(Spec_Hash_Definitions_SHA3_256)
+    == (uint64_t)0U
+    && total_len > (uint64_t)0U
+  )
+  {
+    r = EverCrypt_Hash_Incremental_block_len(Spec_Hash_Definitions_SHA3_256);
+  }
+  else
+  {
+    r =
+      (uint32_t)(total_len
+      % (uint64_t)EverCrypt_Hash_Incremental_block_len(Spec_Hash_Definitions_SHA3_256));
+  }
+  uint8_t *buf_1 = buf_;
+  uint64_t buf[25U] = { 0U };
+  EverCrypt_Hash_state_s s = { .tag = EverCrypt_Hash_SHA3_256_s, { .case_SHA3_256_s = buf } };
+  EverCrypt_Hash_state_s tmp_block_state = s;
+  EverCrypt_Hash_copy(block_state, &tmp_block_state);
+  uint64_t prev_len = total_len - (uint64_t)r;
+  uint32_t ite;
+  if
+  (
+    r
+    % EverCrypt_Hash_Incremental_block_len(Spec_Hash_Definitions_SHA3_256)
+    == (uint32_t)0U
+    && r > (uint32_t)0U
+  )
+  {
+    ite = EverCrypt_Hash_Incremental_block_len(Spec_Hash_Definitions_SHA3_256);
+  }
+  else
+  {
+    ite = r % EverCrypt_Hash_Incremental_block_len(Spec_Hash_Definitions_SHA3_256);
+  }
+  uint8_t *buf_last = buf_1 + r - ite;
+  uint8_t *buf_multi = buf_1;
+  EverCrypt_Hash_update_multi2(&tmp_block_state, prev_len, buf_multi, (uint32_t)0U);
+  uint64_t prev_len_last = total_len - (uint64_t)r;
+  EverCrypt_Hash_update_last2(&tmp_block_state, prev_len_last, buf_last, r);
+  EverCrypt_Hash_finish(&tmp_block_state, dst);
+}
+
+void
+EverCrypt_Hash_Incremental_finish_sha3_384(
+  Hacl_Streaming_Functor_state_s___EverCrypt_Hash_state_s____ *p,
+  uint8_t *dst
+)
+{
+  Hacl_Streaming_Functor_state_s___EverCrypt_Hash_state_s____ scrut = *p;
+  EverCrypt_Hash_state_s *block_state = scrut.block_state;
+  uint8_t *buf_ = scrut.buf;
+  uint64_t total_len = scrut.total_len;
+  uint32_t r;
+  if
+  (
+    total_len
+    % (uint64_t)EverCrypt_Hash_Incremental_block_len(Spec_Hash_Definitions_SHA3_384)
+    == (uint64_t)0U
+    && total_len > (uint64_t)0U
+  )
+  {
+    r = EverCrypt_Hash_Incremental_block_len(Spec_Hash_Definitions_SHA3_384);
+  }
+  else
+  {
+    r =
+      (uint32_t)(total_len
+      % (uint64_t)EverCrypt_Hash_Incremental_block_len(Spec_Hash_Definitions_SHA3_384));
+  }
+  uint8_t *buf_1 = buf_;
+  uint64_t buf[25U] = { 0U };
+  EverCrypt_Hash_state_s s = { .tag = EverCrypt_Hash_SHA3_384_s, { .case_SHA3_384_s = buf } };
+  EverCrypt_Hash_state_s tmp_block_state = s;
+  EverCrypt_Hash_copy(block_state, &tmp_block_state);
+  uint64_t prev_len = total_len - (uint64_t)r;
+  uint32_t ite;
+  if
+  (
+    r
+    % EverCrypt_Hash_Incremental_block_len(Spec_Hash_Definitions_SHA3_384)
+    == (uint32_t)0U
+    && r > (uint32_t)0U
+  )
+  {
+    ite = EverCrypt_Hash_Incremental_block_len(Spec_Hash_Definitions_SHA3_384);
+  }
+  else
+  {
+    ite = r % EverCrypt_Hash_Incremental_block_len(Spec_Hash_Definitions_SHA3_384);
+  }
+  uint8_t *buf_last = buf_1 + r - ite;
+  uint8_t *buf_multi = buf_1;
+  EverCrypt_Hash_update_multi2(&tmp_block_state, prev_len, buf_multi, (uint32_t)0U);
+  uint64_t prev_len_last = total_len - (uint64_t)r;
+  EverCrypt_Hash_update_last2(&tmp_block_state, prev_len_last, buf_last, r);
+  EverCrypt_Hash_finish(&tmp_block_state, dst);
+}
+
+void
+EverCrypt_Hash_Incremental_finish_sha3_512(
+  Hacl_Streaming_Functor_state_s___EverCrypt_Hash_state_s____ *p,
+  uint8_t *dst
+)
+{
+  Hacl_Streaming_Functor_state_s___EverCrypt_Hash_state_s____ scrut = *p;
+  EverCrypt_Hash_state_s *block_state = scrut.block_state;
+  uint8_t *buf_ = scrut.buf;
+  uint64_t total_len = scrut.total_len;
+  uint32_t r;
+  if
+  (
+    total_len
+    % (uint64_t)EverCrypt_Hash_Incremental_block_len(Spec_Hash_Definitions_SHA3_512)
+    == (uint64_t)0U
+    && total_len > (uint64_t)0U
+  )
+  {
+    r = EverCrypt_Hash_Incremental_block_len(Spec_Hash_Definitions_SHA3_512);
+  }
+  else
+  {
+    r =
+      (uint32_t)(total_len
+      % (uint64_t)EverCrypt_Hash_Incremental_block_len(Spec_Hash_Definitions_SHA3_512));
+  }
+  uint8_t *buf_1 = buf_;
+  uint64_t buf[25U] = { 0U };
+  EverCrypt_Hash_state_s s = { .tag = EverCrypt_Hash_SHA3_512_s, { .case_SHA3_512_s = buf } };
+  EverCrypt_Hash_state_s tmp_block_state = s;
+  EverCrypt_Hash_copy(block_state, &tmp_block_state);
+  uint64_t prev_len = total_len - (uint64_t)r;
+  uint32_t ite;
+  if
+  (
+    r
+    % EverCrypt_Hash_Incremental_block_len(Spec_Hash_Definitions_SHA3_512)
+    == (uint32_t)0U
+    && r > (uint32_t)0U
+  )
+  {
+    ite = EverCrypt_Hash_Incremental_block_len(Spec_Hash_Definitions_SHA3_512);
+  }
+  else
+  {
+    ite = r % EverCrypt_Hash_Incremental_block_len(Spec_Hash_Definitions_SHA3_512);
+  }
+  uint8_t *buf_last = buf_1 + r - ite;
+  uint8_t *buf_multi = buf_1;
+  EverCrypt_Hash_update_multi2(&tmp_block_state, prev_len, buf_multi, (uint32_t)0U);
+  uint64_t prev_len_last = total_len - (uint64_t)r;
+  EverCrypt_Hash_update_last2(&tmp_block_state, prev_len_last, buf_last, r);
+  EverCrypt_Hash_finish(&tmp_block_state, dst);
+}
+
 Spec_Hash_Definitions_hash_alg
 EverCrypt_Hash_Incremental_alg_of_state(
   Hacl_Streaming_Functor_state_s___EverCrypt_Hash_state_s____ *s
@@ -2121,6 +2905,26 @@ EverCrypt_Hash_Incremental_finish(
         EverCrypt_Hash_Incremental_finish_blake2b(s, dst);
         break;
       }
+    case Spec_Hash_Definitions_SHA3_224:
+      {
+        EverCrypt_Hash_Incremental_finish_sha3_224(s, dst);
+        break;
+      }
+    case Spec_Hash_Definitions_SHA3_256:
+      {
+        EverCrypt_Hash_Incremental_finish_sha3_256(s, dst);
+        break;
+      }
+    case Spec_Hash_Definitions_SHA3_384:
+      {
+        EverCrypt_Hash_Incremental_finish_sha3_384(s, dst);
+        break;
+      }
+    case Spec_Hash_Definitions_SHA3_512:
+      {
+        EverCrypt_Hash_Incremental_finish_sha3_512(s, dst);
+        break;
+      }
     default:
       {
         KRML_HOST_EPRINTF("KreMLin incomplete match at %s:%d\n", __FILE__, __LINE__);
@@ -43,6 +43,9 @@ extern "C" {
 #include "Hacl_Hash.h"
 #include "EverCrypt_AutoConfig2.h"
 #include "Hacl_Spec.h"
+#include "Hacl_SHA3.h"
+#include "Hacl_SHA2_Vec128.h"
+#include "Hacl_SHA2_Vec256.h"
 
 typedef Spec_Hash_Definitions_hash_alg EverCrypt_Hash_alg;
 
@@ -62,6 +65,10 @@ typedef void *EverCrypt_Hash_e_alg;
 #define EverCrypt_Hash_SHA2_512_s 5
 #define EverCrypt_Hash_Blake2S_s 6
 #define EverCrypt_Hash_Blake2B_s 7
+#define EverCrypt_Hash_SHA3_224_s 8
+#define EverCrypt_Hash_SHA3_256_s 9
+#define EverCrypt_Hash_SHA3_384_s 10
+#define EverCrypt_Hash_SHA3_512_s 11
 
 typedef uint8_t EverCrypt_Hash_state_s_tags;
 
@@ -77,6 +84,10 @@ typedef struct EverCrypt_Hash_state_s_s
     uint64_t *case_SHA2_512_s;
     uint32_t *case_Blake2S_s;
     uint64_t *case_Blake2B_s;
+    uint64_t *case_SHA3_224_s;
+    uint64_t *case_SHA3_256_s;
+    uint64_t *case_SHA3_384_s;
+    uint64_t *case_SHA3_512_s;
   }
   ;
 }
@@ -178,6 +189,54 @@ uint64_t
   EverCrypt_Hash_state_s projectee
 );
 
+bool
+EverCrypt_Hash_uu___is_SHA3_224_s(
+  Spec_Hash_Definitions_hash_alg uu___,
+  EverCrypt_Hash_state_s projectee
+);
+
+uint64_t
+*EverCrypt_Hash___proj__SHA3_224_s__item__p(
+  Spec_Hash_Definitions_hash_alg uu___,
+  EverCrypt_Hash_state_s projectee
+);
+
+bool
+EverCrypt_Hash_uu___is_SHA3_256_s(
+  Spec_Hash_Definitions_hash_alg uu___,
+  EverCrypt_Hash_state_s projectee
+);
+
+uint64_t
+*EverCrypt_Hash___proj__SHA3_256_s__item__p(
+  Spec_Hash_Definitions_hash_alg uu___,
+  EverCrypt_Hash_state_s projectee
+);
+
+bool
+EverCrypt_Hash_uu___is_SHA3_384_s(
+  Spec_Hash_Definitions_hash_alg uu___,
+  EverCrypt_Hash_state_s projectee
+);
+
+uint64_t
+*EverCrypt_Hash___proj__SHA3_384_s__item__p(
+  Spec_Hash_Definitions_hash_alg uu___,
+  EverCrypt_Hash_state_s projectee
+);
+
+bool
+EverCrypt_Hash_uu___is_SHA3_512_s(
+  Spec_Hash_Definitions_hash_alg uu___,
+  EverCrypt_Hash_state_s projectee
+);
+
+uint64_t
+*EverCrypt_Hash___proj__SHA3_512_s__item__p(
+  Spec_Hash_Definitions_hash_alg uu___,
+  EverCrypt_Hash_state_s projectee
+);
+
 Spec_Hash_Definitions_hash_alg EverCrypt_Hash_alg_of_state(EverCrypt_Hash_state_s *s);
 
 EverCrypt_Hash_state_s *EverCrypt_Hash_create_in(Spec_Hash_Definitions_hash_alg a);
@@ -236,6 +295,38 @@ void EverCrypt_Hash_hash_256(uint8_t *input, uint32_t input_len, uint8_t *dst);
 
 void EverCrypt_Hash_hash_224(uint8_t *input, uint32_t input_len, uint8_t *dst);
 
+/*
+  Hash `n` independent messages with SHA2-256: `dsts[i]` receives the digest of
+  the `input_lens[i]` bytes at `inputs[i]`. With SHA-NI, each message goes through
+  the Vale implementation; otherwise, this is Hacl_Hash_SHA2_256_mb.
+*/
+void
+EverCrypt_Hash_hash_256_mb(
+  uint32_t n,
+  uint8_t **inputs,
+  uint32_t *input_lens,
+  uint8_t **dsts
+);
+
+/*
+  Apply the SHA2-256 compression function to the 64-byte block made of the 32
+  bytes at `src1` followed by the 32 bytes at `src2`, starting from the SHA2-256
+  initial hash value and without padding, and write the resulting state to `dst`.
+  `dst` may alias `src1` or `src2`.
+*/
+void EverCrypt_Hash_compress_256(uint8_t *src1, uint8_t *src2, uint8_t *dst);
+
+/*
+  Apply the SHA2-256 compression function to `n` independent 64-byte blocks,
+  starting from the SHA2-256 initial hash value and without padding: `dsts[i]`
+  receives the state after compressing the 32 bytes at `src1[i]` followed by the
+  32 bytes at `src2[i]`. This is the node hash of binary Merkle trees over
+  SHA2-256. When SHA-NI is not available, blocks are compressed 8 (vec256) or 4
+  (vec128) at a time, one block per vector lane.
+*/
+void
+EverCrypt_Hash_compress_256_mb(uint32_t n, uint8_t **src1, uint8_t **src2, uint8_t **dsts);
+
 void
 EverCrypt_Hash_hash(
   Spec_Hash_Definitions_hash_alg a,
@@ -317,6 +408,30 @@ EverCrypt_Hash_Incremental_finish_blake2b(
   uint8_t *dst
 );
 
+void
+EverCrypt_Hash_Incremental_finish_sha3_224(
+  Hacl_Streaming_Functor_state_s___EverCrypt_Hash_state_s____ *p,
+  uint8_t *dst
+);
+
+void
+EverCrypt_Hash_Incremental_finish_sha3_256(
+  Hacl_Streaming_Functor_state_s___EverCrypt_Hash_state_s____ *p,
+  uint8_t *dst
+);
+
+void
+EverCrypt_Hash_Incremental_finish_sha3_384(
+  Hacl_Streaming_Functor_state_s___EverCrypt_Hash_state_s____ *p,
+  uint8_t *dst
+);
+
+void
+EverCrypt_Hash_Incremental_finish_sha3_512(
+  Hacl_Streaming_Functor_state_s___EverCrypt_Hash_state_s____ *p,
+  uint8_t *dst
+);
+
 Spec_Hash_Definitions_hash_alg
 EverCrypt_Hash_Incremental_alg_of_state(
   Hacl_Streaming_Functor_state_s___EverCrypt_Hash_state_s____ *s
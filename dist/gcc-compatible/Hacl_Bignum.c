@@ -24,6 +24,9 @@
 
 #include "Hacl_Bignum.h"
 
+#include "EverCrypt_AutoConfig2.h"
+#include "bignum-inline.h"
+
 void Hacl_Bignum_Convert_bn_from_bytes_be_uint64(uint32_t len, uint8_t *b, uint64_t *res)
 {
   uint32_t bnLen = (len - (uint32_t)1U) / (uint32_t)8U + (uint32_t)1U;
@@ -361,19 +364,7 @@ static inline void bn_sqr_u64(uint32_t aLen, uint64_t *a, uint64_t *res)
     uint64_t r = c;
     res[i0 + i0] = r;
   }
-  uint64_t c0 = Hacl_Bignum_Addition_bn_add_eq_len_u64(aLen + aLen, res, res, res);
-  KRML_CHECK_SIZE(sizeof (uint64_t), aLen + aLen);
-  uint64_t tmp[aLen + aLen];
-  memset(tmp, 0U, (aLen + aLen) * sizeof (uint64_t));
-  for (uint32_t i = (uint32_t)0U; i < aLen; i++)
-  {
-    FStar_UInt128_uint128 res1 = FStar_UInt128_mul_wide(a[i], a[i]);
-    uint64_t hi = FStar_UInt128_uint128_to_uint64(FStar_UInt128_shift_right(res1, (uint32_t)64U));
-    uint64_t lo = FStar_UInt128_uint128_to_uint64(res1);
-    tmp[(uint32_t)2U * i] = lo;
-    tmp[(uint32_t)2U * i + (uint32_t)1U] = hi;
-  }
-  uint64_t c1 = Hacl_Bignum_Addition_bn_add_eq_len_u64(aLen + aLen, res, tmp, res);
+  Hacl_Bignum_Base_bn_sqr_diag_add_u64(aLen, a, res);
 }
 
 void
@@ -1626,6 +1617,108 @@ bn_almost_mont_sqr_u32(
   bn_almost_mont_reduction_u32(len, n, nInv_u64, c, resM);
 }
 
+#if HACL_CAN_COMPILE_INLINE_ASM
+bool Hacl_Bignum_Montgomery_has_adx_bmi2(void)
+{
+  bool has_bmi2 = EverCrypt_AutoConfig2_has_bmi2();
+  bool has_adx = EverCrypt_AutoConfig2_has_adx();
+  return has_bmi2 && has_adx;
+}
+
+static inline void bn_mul_adx_u64(uint32_t aLen, uint64_t *a, uint64_t *b, uint64_t *res)
+{
+  memset(res, 0U, (aLen + aLen) * sizeof (uint64_t));
+  for (uint32_t i0 = (uint32_t)0U; i0 < aLen; i0++)
+  {
+    uint64_t r = bn_mul1_add_adx(res + i0, a, b[i0], (uint64_t)aLen);
+    res[aLen + i0] = r;
+  }
+}
+
+static inline void bn_sqr_adx_u64(uint32_t aLen, uint64_t *a, uint64_t *res)
+{
+  memset(res, 0U, (aLen + aLen) * sizeof (uint64_t));
+  for (uint32_t i0 = (uint32_t)1U; i0 < aLen; i0++)
+  {
+    uint64_t r = bn_mul1_add_adx(res + i0, a, a[i0], (uint64_t)i0);
+    res[i0 + i0] = r;
+  }
+  Hacl_Bignum_Base_bn_sqr_diag_add_u64(aLen, a, res);
+}
+
+static inline void
+bn_almost_mont_reduction_adx_u64(
+  uint32_t len,
+  uint64_t *n,
+  uint64_t nInv,
+  uint64_t *c,
+  uint64_t *res
+)
+{
+  uint64_t c0 = (uint64_t)0U;
+  for (uint32_t i0 = (uint32_t)0U; i0 < len; i0++)
+  {
+    uint64_t qj = nInv * c[i0];
+    uint64_t c10 = bn_mul1_add_adx(c + i0, n, qj, (uint64_t)len);
+    uint64_t *resb = c + len + i0;
+    uint64_t res_j = c[len + i0];
+    c0 = Lib_IntTypes_Intrinsics_add_carry_u64(c0, c10, res_j, resb);
+  }
+  memcpy(res, c + len, len * sizeof (uint64_t));
+  uint64_t c00 = c0;
+  KRML_CHECK_SIZE(sizeof (uint64_t), len);
+  uint64_t tmp[len];
+  memset(tmp, 0U, len * sizeof (uint64_t));
+  uint64_t c1 = Hacl_Bignum_Addition_bn_sub_eq_len_u64(len, res, n, tmp);
+  uint64_t m = (uint64_t)0U - c00;
+  for (uint32_t i = (uint32_t)0U; i < len; i++)
+  {
+    uint64_t *os = res;
+    uint64_t x = (m & tmp[i]) | (~m & res[i]);
+    os[i] = x;
+  }
+}
+
+/*
+  Almost Montgomery multiplication on top of the mulx/adcx/adox kernel of
+  bignum-inline.h. Callers must check Hacl_Bignum_Montgomery_has_adx_bmi2.
+*/
+void
+Hacl_Bignum_Montgomery_bn_almost_mont_mul_adx_u64(
+  uint32_t len,
+  uint64_t *n,
+  uint64_t nInv_u64,
+  uint64_t *aM,
+  uint64_t *bM,
+  uint64_t *resM
+)
+{
+  KRML_CHECK_SIZE(sizeof (uint64_t), len + len);
+  uint64_t c[len + len];
+  bn_mul_adx_u64(len, aM, bM, c);
+  bn_almost_mont_reduction_adx_u64(len, n, nInv_u64, c, resM);
+}
+
+/*
+  Almost Montgomery squaring on top of the mulx/adcx/adox kernel of
+  bignum-inline.h. Callers must check Hacl_Bignum_Montgomery_has_adx_bmi2.
+*/
+void
+Hacl_Bignum_Montgomery_bn_almost_mont_sqr_adx_u64(
+  uint32_t len,
+  uint64_t *n,
+  uint64_t nInv_u64,
+  uint64_t *aM,
+  uint64_t *resM
+)
+{
+  KRML_CHECK_SIZE(sizeof (uint64_t), len + len);
+  uint64_t c[len + len];
+  bn_sqr_adx_u64(len, aM, c);
+  bn_almost_mont_reduction_adx_u64(len, n, nInv_u64, c, resM);
+}
+#endif
+
 static void
 bn_almost_mont_reduction_u64(
   uint32_t len,
@@ -1693,6 +1786,13 @@ bn_almost_mont_mul_u64(
   uint64_t *resM
 )
 {
+  #if HACL_CAN_COMPILE_INLINE_ASM
+  if (Hacl_Bignum_Montgomery_has_adx_bmi2())
+  {
+    Hacl_Bignum_Montgomery_bn_almost_mont_mul_adx_u64(len, n, nInv_u64, aM, bM, resM);
+    return;
+  }
+  #endif
   KRML_CHECK_SIZE(sizeof (uint64_t), len + len);
   uint64_t c[len + len];
   memset(c, 0U, (len + len) * sizeof (uint64_t));
@@ -1712,6 +1812,13 @@ bn_almost_mont_sqr_u64(
   uint64_t *resM
 )
 {
+  #if HACL_CAN_COMPILE_INLINE_ASM
+  if (Hacl_Bignum_Montgomery_has_adx_bmi2())
+  {
+    Hacl_Bignum_Montgomery_bn_almost_mont_sqr_adx_u64(len, n, nInv_u64, aM, resM);
+    return;
+  }
+  #endif
   KRML_CHECK_SIZE(sizeof (uint64_t), len + len);
   uint64_t c[len + len];
   memset(c, 0U, (len + len) * sizeof (uint64_t));
@@ -1722,6 +1829,51 @@ bn_almost_mont_sqr_u64(
   bn_almost_mont_reduction_u64(len, n, nInv_u64, c, resM);
 }
 
+/*
+  Window width of the sliding-window variable-time exponentiation for an
+  exponent of bBits bits: the precomputed table holds 2^(l - 1) odd powers.
+*/
+uint32_t Hacl_Bignum_Exponentiation_bn_get_window_vartime(uint32_t bBits)
+{
+  if (bBits > (uint32_t)671U)
+  {
+    return (uint32_t)6U;
+  }
+  if (bBits > (uint32_t)239U)
+  {
+    return (uint32_t)5U;
+  }
+  if (bBits > (uint32_t)79U)
+  {
+    return (uint32_t)4U;
+  }
+  if (bBits > (uint32_t)23U)
+  {
+    return (uint32_t)3U;
+  }
+  return (uint32_t)1U;
+}
+
+/*
+  Window width of the fixed-window constant-time exponentiation for a len-limb
+  modulus and an exponent of bBits bits. Each window saves multiplications but
+  costs a masked scan of the whole table, which is cheap next to a Montgomery
+  multiplication only for large len: 4 bits up to 512-bit exponents, then 5,
+  and 6 past 1280 bits for moduli of 3072 bits and more.
+*/
+uint32_t Hacl_Bignum_Exponentiation_bn_get_window_consttime(uint32_t len, uint32_t bBits)
+{
+  if (len >= (uint32_t)48U && bBits > (uint32_t)1280U)
+  {
+    return (uint32_t)6U;
+  }
+  if (bBits > (uint32_t)512U)
+  {
+    return (uint32_t)5U;
+  }
+  return (uint32_t)4U;
+}
+
 uint32_t
 Hacl_Bignum_Exponentiation_bn_check_mod_exp_u32(
   uint32_t len,
@@ -2249,46 +2401,6 @@ Hacl_Bignum_Exponentiation_bn_mod_exp_vartime_precomp_u64(
   uint64_t *res
 )
 {
-  if (bBits < (uint32_t)200U)
-  {
-    KRML_CHECK_SIZE(sizeof (uint64_t), len);
-    uint64_t aM[len];
-    memset(aM, 0U, len * sizeof (uint64_t));
-    KRML_CHECK_SIZE(sizeof (uint64_t), len + len);
-    uint64_t c[len + len];
-    memset(c, 0U, (len + len) * sizeof (uint64_t));
-    KRML_CHECK_SIZE(sizeof (uint64_t), (uint32_t)4U * len);
-    uint64_t tmp0[(uint32_t)4U * len];
-    memset(tmp0, 0U, (uint32_t)4U * len * sizeof (uint64_t));
-    Hacl_Bignum_Karatsuba_bn_karatsuba_mul_uint64(len, a, r2, tmp0, c);
-    Hacl_Bignum_Montgomery_bn_mont_reduction_u64(len, n, mu, c, aM);
-    KRML_CHECK_SIZE(sizeof (uint64_t), len);
-    uint64_t resM[len];
-    memset(resM, 0U, len * sizeof (uint64_t));
-    KRML_CHECK_SIZE(sizeof (uint64_t), len + len);
-    uint64_t tmp1[len + len];
-    memset(tmp1, 0U, (len + len) * sizeof (uint64_t));
-    memcpy(tmp1, r2, len * sizeof (uint64_t));
-    Hacl_Bignum_Montgomery_bn_mont_reduction_u64(len, n, mu, tmp1, resM);
-    for (uint32_t i = (uint32_t)0U; i < bBits; i++)
-    {
-      uint32_t i1 = i / (uint32_t)64U;
-      uint32_t j = i % (uint32_t)64U;
-      uint64_t tmp = b[i1];
-      uint64_t bit = tmp >> j & (uint64_t)1U;
-      if (!(bit == (uint64_t)0U))
-      {
-        bn_almost_mont_mul_u64(len, n, mu, resM, aM, resM);
-      }
-      bn_almost_mont_sqr_u64(len, n, mu, aM, aM);
-    }
-    KRML_CHECK_SIZE(sizeof (uint64_t), len + len);
-    uint64_t tmp[len + len];
-    memset(tmp, 0U, (len + len) * sizeof (uint64_t));
-    memcpy(tmp, resM, len * sizeof (uint64_t));
-    Hacl_Bignum_Montgomery_bn_mont_reduction_u64(len, n, mu, tmp, res);
-    return;
-  }
   KRML_CHECK_SIZE(sizeof (uint64_t), len);
   uint64_t aM[len];
   memset(aM, 0U, len * sizeof (uint64_t));
@@ -2303,82 +2415,82 @@ Hacl_Bignum_Exponentiation_bn_mod_exp_vartime_precomp_u64(
   KRML_CHECK_SIZE(sizeof (uint64_t), len);
   uint64_t resM[len];
   memset(resM, 0U, len * sizeof (uint64_t));
-  uint32_t bLen;
-  if (bBits == (uint32_t)0U)
-  {
-    bLen = (uint32_t)1U;
-  }
-  else
-  {
-    bLen = (bBits - (uint32_t)1U) / (uint32_t)64U + (uint32_t)1U;
-  }
   KRML_CHECK_SIZE(sizeof (uint64_t), len + len);
   uint64_t tmp[len + len];
   memset(tmp, 0U, (len + len) * sizeof (uint64_t));
   memcpy(tmp, r2, len * sizeof (uint64_t));
   Hacl_Bignum_Montgomery_bn_mont_reduction_u64(len, n, mu, tmp, resM);
-  KRML_CHECK_SIZE(sizeof (uint64_t), (uint32_t)16U * len);
-  uint64_t table[(uint32_t)16U * len];
-  memset(table, 0U, (uint32_t)16U * len * sizeof (uint64_t));
-  memcpy(table, resM, len * sizeof (uint64_t));
-  uint64_t *t1 = table + len;
-  memcpy(t1, aM, len * sizeof (uint64_t));
-  for (uint32_t i = (uint32_t)0U; i < (uint32_t)14U; i++)
-  {
-    uint64_t *t11 = table + (i + (uint32_t)1U) * len;
-    uint64_t *t2 = table + (i + (uint32_t)2U) * len;
-    bn_almost_mont_mul_u64(len, n, mu, t11, aM, t2);
-  }
-  for (uint32_t i = (uint32_t)0U; i < bBits / (uint32_t)4U; i++)
+  uint32_t l = Hacl_Bignum_Exponentiation_bn_get_window_vartime(bBits);
+  uint32_t tLen = (uint32_t)1U << (l - (uint32_t)1U);
+  KRML_CHECK_SIZE(sizeof (uint64_t), tLen * len);
+  uint64_t table[tLen * len];
+  memset(table, 0U, tLen * len * sizeof (uint64_t));
+  memcpy(table, aM, len * sizeof (uint64_t));
+  if (l > (uint32_t)1U)
   {
-    for (uint32_t i0 = (uint32_t)0U; i0 < (uint32_t)4U; i0++)
-    {
-      bn_almost_mont_sqr_u64(len, n, mu, resM, resM);
-    }
-    uint64_t mask_l = (uint64_t)16U - (uint64_t)1U;
-    uint32_t i1 = (bBits - (uint32_t)4U * i - (uint32_t)4U) / (uint32_t)64U;
-    uint32_t j = (bBits - (uint32_t)4U * i - (uint32_t)4U) % (uint32_t)64U;
-    uint64_t p1 = b[i1] >> j;
-    uint64_t ite;
-    if (i1 + (uint32_t)1U < bLen && (uint32_t)0U < j)
-    {
-      ite = p1 | b[i1 + (uint32_t)1U] << ((uint32_t)64U - j);
-    }
-    else
+    KRML_CHECK_SIZE(sizeof (uint64_t), len);
+    uint64_t aM2[len];
+    memset(aM2, 0U, len * sizeof (uint64_t));
+    bn_almost_mont_sqr_u64(len, n, mu, aM, aM2);
+    for (uint32_t i = (uint32_t)0U; i < tLen - (uint32_t)1U; i++)
     {
-      ite = p1;
+      uint64_t *t1 = table + i * len;
+      uint64_t *t2 = table + (i + (uint32_t)1U) * len;
+      bn_almost_mont_mul_u64(len, n, mu, t1, aM2, t2);
     }
-    uint64_t bits_l = ite & mask_l;
-    uint32_t bits_l32 = (uint32_t)bits_l;
-    uint64_t *a_bits_l = table + bits_l32 * len;
-    bn_almost_mont_mul_u64(len, n, mu, resM, a_bits_l, resM);
   }
-  if (!(bBits % (uint32_t)4U == (uint32_t)0U))
+  bool is_one = true;
+  uint32_t i = bBits;
+  while (i > (uint32_t)0U)
   {
-    uint32_t c0 = bBits % (uint32_t)4U;
-    for (uint32_t i = (uint32_t)0U; i < c0; i++)
+    uint32_t k = i - (uint32_t)1U;
+    uint64_t bit = b[k / (uint32_t)64U] >> k % (uint32_t)64U & (uint64_t)1U;
+    if (bit == (uint64_t)0U)
     {
-      bn_almost_mont_sqr_u64(len, n, mu, resM, resM);
-    }
-    uint32_t c1 = bBits % (uint32_t)4U;
-    uint64_t mask_l = ((uint64_t)1U << c1) - (uint64_t)1U;
-    uint32_t i = (uint32_t)0U;
-    uint32_t j = (uint32_t)0U;
-    uint64_t p1 = b[i] >> j;
-    uint64_t ite;
-    if (i + (uint32_t)1U < bLen && (uint32_t)0U < j)
-    {
-      ite = p1 | b[i + (uint32_t)1U] << ((uint32_t)64U - j);
+      if (!is_one)
+      {
+        bn_almost_mont_sqr_u64(len, n, mu, resM, resM);
+      }
+      i = k;
     }
     else
     {
-      ite = p1;
+      uint32_t s0;
+      if (i < l)
+      {
+        s0 = (uint32_t)0U;
+      }
+      else
+      {
+        s0 = i - l;
+      }
+      uint32_t s = s0;
+      while ((b[s / (uint32_t)64U] >> s % (uint32_t)64U & (uint64_t)1U) == (uint64_t)0U)
+      {
+        s++;
+      }
+      uint64_t bits = (uint64_t)0U;
+      for (uint32_t j = i; j > s; j--)
+      {
+        uint32_t j1 = j - (uint32_t)1U;
+        bits = bits << (uint32_t)1U | (b[j1 / (uint32_t)64U] >> j1 % (uint32_t)64U & (uint64_t)1U);
+      }
+      uint64_t *a_bits = table + (uint32_t)(bits >> (uint32_t)1U) * len;
+      if (is_one)
+      {
+        memcpy(resM, a_bits, len * sizeof (uint64_t));
+        is_one = false;
+      }
+      else
+      {
+        for (uint32_t j = s; j < i; j++)
+        {
+          bn_almost_mont_sqr_u64(len, n, mu, resM, resM);
+        }
+        bn_almost_mont_mul_u64(len, n, mu, resM, a_bits, resM);
+      }
+      i = s;
     }
-    uint64_t bits_c = ite & mask_l;
-    uint64_t bits_c0 = bits_c;
-    uint32_t bits_c32 = (uint32_t)bits_c0;
-    uint64_t *a_bits_c = table + bits_c32 * len;
-    bn_almost_mont_mul_u64(len, n, mu, resM, a_bits_c, resM);
   }
   KRML_CHECK_SIZE(sizeof (uint64_t), len + len);
   uint64_t tmp1[len + len];
@@ -2387,9 +2499,17 @@ Hacl_Bignum_Exponentiation_bn_mod_exp_vartime_precomp_u64(
   Hacl_Bignum_Montgomery_bn_mont_reduction_u64(len, n, mu, tmp1, res);
 }
 
+/*
+  Fixed-window constant-time modular exponentiation with a window of l bits,
+  i.e. a table of 2^l Montgomery-form powers of a, each selected with a full
+  masked scan. Requires 1 <= l <= 8; other values abort. Larger windows trade fewer
+  multiplications for a bigger table and a longer scan per window; see
+  Hacl_Bignum_Exponentiation_bn_get_window_consttime for the defaults.
+*/
 void
-Hacl_Bignum_Exponentiation_bn_mod_exp_consttime_precomp_u64(
+Hacl_Bignum_Exponentiation_bn_mod_exp_consttime_precomp_fw_u64(
   uint32_t len,
+  uint32_t l,
   uint64_t *n,
   uint64_t mu,
   uint64_t *r2,
@@ -2399,58 +2519,13 @@ Hacl_Bignum_Exponentiation_bn_mod_exp_consttime_precomp_u64(
   uint64_t *res
 )
 {
-  if (bBits < (uint32_t)200U)
+  if (l == (uint32_t)0U || l > (uint32_t)8U)
   {
-    KRML_CHECK_SIZE(sizeof (uint64_t), len);
-    uint64_t aM[len];
-    memset(aM, 0U, len * sizeof (uint64_t));
-    KRML_CHECK_SIZE(sizeof (uint64_t), len + len);
-    uint64_t c[len + len];
-    memset(c, 0U, (len + len) * sizeof (uint64_t));
-    KRML_CHECK_SIZE(sizeof (uint64_t), (uint32_t)4U * len);
-    uint64_t tmp0[(uint32_t)4U * len];
-    memset(tmp0, 0U, (uint32_t)4U * len * sizeof (uint64_t));
-    Hacl_Bignum_Karatsuba_bn_karatsuba_mul_uint64(len, a, r2, tmp0, c);
-    Hacl_Bignum_Montgomery_bn_mont_reduction_u64(len, n, mu, c, aM);
-    KRML_CHECK_SIZE(sizeof (uint64_t), len);
-    uint64_t resM[len];
-    memset(resM, 0U, len * sizeof (uint64_t));
-    KRML_CHECK_SIZE(sizeof (uint64_t), len + len);
-    uint64_t tmp1[len + len];
-    memset(tmp1, 0U, (len + len) * sizeof (uint64_t));
-    memcpy(tmp1, r2, len * sizeof (uint64_t));
-    Hacl_Bignum_Montgomery_bn_mont_reduction_u64(len, n, mu, tmp1, resM);
-    uint64_t sw = (uint64_t)0U;
-    for (uint32_t i0 = (uint32_t)0U; i0 < bBits; i0++)
-    {
-      uint32_t i1 = (bBits - i0 - (uint32_t)1U) / (uint32_t)64U;
-      uint32_t j = (bBits - i0 - (uint32_t)1U) % (uint32_t)64U;
-      uint64_t tmp = b[i1];
-      uint64_t bit = tmp >> j & (uint64_t)1U;
-      uint64_t sw1 = bit ^ sw;
-      for (uint32_t i = (uint32_t)0U; i < len; i++)
-      {
-        uint64_t dummy = ((uint64_t)0U - sw1) & (resM[i] ^ aM[i]);
-        resM[i] = resM[i] ^ dummy;
-        aM[i] = aM[i] ^ dummy;
-      }
-      bn_almost_mont_mul_u64(len, n, mu, aM, resM, aM);
-      bn_almost_mont_sqr_u64(len, n, mu, resM, resM);
-      sw = bit;
-    }
-    uint64_t sw0 = sw;
-    for (uint32_t i = (uint32_t)0U; i < len; i++)
-    {
-      uint64_t dummy = ((uint64_t)0U - sw0) & (resM[i] ^ aM[i]);
-      resM[i] = resM[i] ^ dummy;
-      aM[i] = aM[i] ^ dummy;
-    }
-    KRML_CHECK_SIZE(sizeof (uint64_t), len + len);
-    uint64_t tmp[len + len];
-    memset(tmp, 0U, (len + len) * sizeof (uint64_t));
-    memcpy(tmp, resM, len * sizeof (uint64_t));
-    Hacl_Bignum_Montgomery_bn_mont_reduction_u64(len, n, mu, tmp, res);
-    return;
+    KRML_HOST_EPRINTF("Window size %u out of range [1, 8], aborting at %s:%d\n",
+      l,
+      __FILE__,
+      __LINE__);
+    KRML_HOST_EXIT(253U);
   }
   KRML_CHECK_SIZE(sizeof (uint64_t), len);
   uint64_t aM[len];
@@ -2480,27 +2555,36 @@ Hacl_Bignum_Exponentiation_bn_mod_exp_consttime_precomp_u64(
   memset(tmp, 0U, (len + len) * sizeof (uint64_t));
   memcpy(tmp, r2, len * sizeof (uint64_t));
   Hacl_Bignum_Montgomery_bn_mont_reduction_u64(len, n, mu, tmp, resM);
-  KRML_CHECK_SIZE(sizeof (uint64_t), (uint32_t)16U * len);
-  uint64_t table[(uint32_t)16U * len];
-  memset(table, 0U, (uint32_t)16U * len * sizeof (uint64_t));
+  uint32_t tLen = (uint32_t)1U << l;
+  KRML_CHECK_SIZE(sizeof (uint64_t), tLen * len);
+  uint64_t table[tLen * len];
+  memset(table, 0U, tLen * len * sizeof (uint64_t));
   memcpy(table, resM, len * sizeof (uint64_t));
   uint64_t *t1 = table + len;
   memcpy(t1, aM, len * sizeof (uint64_t));
-  for (uint32_t i = (uint32_t)0U; i < (uint32_t)14U; i++)
+  for (uint32_t i = (uint32_t)0U; i < tLen - (uint32_t)2U; i++)
   {
     uint64_t *t11 = table + (i + (uint32_t)1U) * len;
     uint64_t *t2 = table + (i + (uint32_t)2U) * len;
-    bn_almost_mont_mul_u64(len, n, mu, t11, aM, t2);
+    if (i % (uint32_t)2U == (uint32_t)0U)
+    {
+      uint64_t *t = table + (i + (uint32_t)2U) / (uint32_t)2U * len;
+      bn_almost_mont_sqr_u64(len, n, mu, t, t2);
+    }
+    else
+    {
+      bn_almost_mont_mul_u64(len, n, mu, t11, aM, t2);
+    }
   }
-  for (uint32_t i0 = (uint32_t)0U; i0 < bBits / (uint32_t)4U; i0++)
+  for (uint32_t i0 = (uint32_t)0U; i0 < bBits / l; i0++)
   {
-    for (uint32_t i = (uint32_t)0U; i < (uint32_t)4U; i++)
+    for (uint32_t i = (uint32_t)0U; i < l; i++)
     {
       bn_almost_mont_sqr_u64(len, n, mu, resM, resM);
     }
-    uint64_t mask_l = (uint64_t)16U - (uint64_t)1U;
-    uint32_t i1 = (bBits - (uint32_t)4U * i0 - (uint32_t)4U) / (uint32_t)64U;
-    uint32_t j = (bBits - (uint32_t)4U * i0 - (uint32_t)4U) % (uint32_t)64U;
+    uint64_t mask_l = ((uint64_t)1U << l) - (uint64_t)1U;
+    uint32_t i1 = (bBits - l * i0 - l) / (uint32_t)64U;
+    uint32_t j = (bBits - l * i0 - l) % (uint32_t)64U;
     uint64_t p1 = b[i1] >> j;
     uint64_t ite;
     if (i1 + (uint32_t)1U < bLen && (uint32_t)0U < j)
@@ -2516,7 +2600,7 @@ Hacl_Bignum_Exponentiation_bn_mod_exp_consttime_precomp_u64(
     uint64_t a_bits_l[len];
     memset(a_bits_l, 0U, len * sizeof (uint64_t));
     memcpy(a_bits_l, table, len * sizeof (uint64_t));
-    for (uint32_t i2 = (uint32_t)0U; i2 < (uint32_t)15U; i2++)
+    for (uint32_t i2 = (uint32_t)0U; i2 < tLen - (uint32_t)1U; i2++)
     {
       uint64_t c = FStar_UInt64_eq_mask(bits_l, (uint64_t)(i2 + (uint32_t)1U));
       uint64_t *res_j = table + (i2 + (uint32_t)1U) * len;
@@ -2529,14 +2613,14 @@ Hacl_Bignum_Exponentiation_bn_mod_exp_consttime_precomp_u64(
     }
     bn_almost_mont_mul_u64(len, n, mu, resM, a_bits_l, resM);
   }
-  if (!(bBits % (uint32_t)4U == (uint32_t)0U))
+  if (!(bBits % l == (uint32_t)0U))
   {
-    uint32_t c = bBits % (uint32_t)4U;
+    uint32_t c = bBits % l;
     for (uint32_t i = (uint32_t)0U; i < c; i++)
     {
       bn_almost_mont_sqr_u64(len, n, mu, resM, resM);
     }
-    uint32_t c10 = bBits % (uint32_t)4U;
+    uint32_t c10 = bBits % l;
     uint64_t mask_l = ((uint64_t)1U << c10) - (uint64_t)1U;
     uint32_t i0 = (uint32_t)0U;
     uint32_t j = (uint32_t)0U;
@@ -2556,7 +2640,7 @@ Hacl_Bignum_Exponentiation_bn_mod_exp_consttime_precomp_u64(
     uint64_t a_bits_c[len];
     memset(a_bits_c, 0U, len * sizeof (uint64_t));
     memcpy(a_bits_c, table, len * sizeof (uint64_t));
-    for (uint32_t i1 = (uint32_t)0U; i1 < (uint32_t)15U; i1++)
+    for (uint32_t i1 = (uint32_t)0U; i1 < tLen - (uint32_t)1U; i1++)
     {
       uint64_t c1 = FStar_UInt64_eq_mask(bits_c0, (uint64_t)(i1 + (uint32_t)1U));
       uint64_t *res_j = table + (i1 + (uint32_t)1U) * len;
@@ -2576,6 +2660,82 @@ Hacl_Bignum_Exponentiation_bn_mod_exp_consttime_precomp_u64(
   Hacl_Bignum_Montgomery_bn_mont_reduction_u64(len, n, mu, tmp1, res);
 }
 
+void
+Hacl_Bignum_Exponentiation_bn_mod_exp_consttime_precomp_u64(
+  uint32_t len,
+  uint64_t *n,
+  uint64_t mu,
+  uint64_t *r2,
+  uint64_t *a,
+  uint32_t bBits,
+  uint64_t *b,
+  uint64_t *res
+)
+{
+  if (bBits < (uint32_t)200U)
+  {
+    KRML_CHECK_SIZE(sizeof (uint64_t), len);
+    uint64_t aM[len];
+    memset(aM, 0U, len * sizeof (uint64_t));
+    KRML_CHECK_SIZE(sizeof (uint64_t), len + len);
+    uint64_t c[len + len];
+    memset(c, 0U, (len + len) * sizeof (uint64_t));
+    KRML_CHECK_SIZE(sizeof (uint64_t), (uint32_t)4U * len);
+    uint64_t tmp0[(uint32_t)4U * len];
+    memset(tmp0, 0U, (uint32_t)4U * len * sizeof (uint64_t));
+    Hacl_Bignum_Karatsuba_bn_karatsuba_mul_uint64(len, a, r2, tmp0, c);
+    Hacl_Bignum_Montgomery_bn_mont_reduction_u64(len, n, mu, c, aM);
+    KRML_CHECK_SIZE(sizeof (uint64_t), len);
+    uint64_t resM[len];
+    memset(resM, 0U, len * sizeof (uint64_t));
+    KRML_CHECK_SIZE(sizeof (uint64_t), len + len);
+    uint64_t tmp1[len + len];
+    memset(tmp1, 0U, (len + len) * sizeof (uint64_t));
+    memcpy(tmp1, r2, len * sizeof (uint64_t));
+    Hacl_Bignum_Montgomery_bn_mont_reduction_u64(len, n, mu, tmp1, resM);
+    uint64_t sw = (uint64_t)0U;
+    for (uint32_t i0 = (uint32_t)0U; i0 < bBits; i0++)
+    {
+      uint32_t i1 = (bBits - i0 - (uint32_t)1U) / (uint32_t)64U;
+      uint32_t j = (bBits - i0 - (uint32_t)1U) % (uint32_t)64U;
+      uint64_t tmp = b[i1];
+      uint64_t bit = tmp >> j & (uint64_t)1U;
+      uint64_t sw1 = bit ^ sw;
+      for (uint32_t i = (uint32_t)0U; i < len; i++)
+      {
+        uint64_t dummy = ((uint64_t)0U - sw1) & (resM[i] ^ aM[i]);
+        resM[i] = resM[i] ^ dummy;
+        aM[i] = aM[i] ^ dummy;
+      }
+      bn_almost_mont_mul_u64(len, n, mu, aM, resM, aM);
+      bn_almost_mont_sqr_u64(len, n, mu, resM, resM);
+      sw = bit;
+    }
+    uint64_t sw0 = sw;
+    for (uint32_t i = (uint32_t)0U; i < len; i++)
+    {
+      uint64_t dummy = ((uint64_t)0U - sw0) & (resM[i] ^ aM[i]);
+      resM[i] = resM[i] ^ dummy;
+      aM[i] = aM[i] ^ dummy;
+    }
+    KRML_CHECK_SIZE(sizeof (uint64_t), len + len);
+    uint64_t tmp[len + len];
+    memset(tmp, 0U, (len + len) * sizeof (uint64_t));
+    memcpy(tmp, resM, len * sizeof (uint64_t));
+    Hacl_Bignum_Montgomery_bn_mont_reduction_u64(len, n, mu, tmp, res);
+    return;
+  }
+  Hacl_Bignum_Exponentiation_bn_mod_exp_consttime_precomp_fw_u64(len,
+    Hacl_Bignum_Exponentiation_bn_get_window_consttime(len, bBits),
+    n,
+    mu,
+    r2,
+    a,
+    bBits,
+    b,
+    res);
+}
+
 void
 Hacl_Bignum_Exponentiation_bn_mod_exp_vartime_u64(
   uint32_t len,
@@ -249,6 +249,56 @@ Hacl_Bignum_Montgomery_bn_mont_sqr_u64(
   uint64_t *resM
 );
 
+#if HACL_CAN_COMPILE_INLINE_ASM
+/*
+  Returns true if the CPU supports BMI2 and ADX, i.e. if the _adx_u64 functions
+  below can be called. All the bignum code dispatches on this function.
+*/
+bool Hacl_Bignum_Montgomery_has_adx_bmi2(void);
+
+/*
+  Almost Montgomery multiplication on top of the mulx/adcx/adox kernel of
+  bignum-inline.h. Callers must check Hacl_Bignum_Montgomery_has_adx_bmi2.
+*/
+void
+Hacl_Bignum_Montgomery_bn_almost_mont_mul_adx_u64(
+  uint32_t len,
+  uint64_t *n,
+  uint64_t nInv_u64,
+  uint64_t *aM,
+  uint64_t *bM,
+  uint64_t *resM
+);
+
+/*
+  Almost Montgomery squaring on top of the mulx/adcx/adox kernel of
+  bignum-inline.h. Callers must check Hacl_Bignum_Montgomery_has_adx_bmi2.
+*/
+void
+Hacl_Bignum_Montgomery_bn_almost_mont_sqr_adx_u64(
+  uint32_t len,
+  uint64_t *n,
+  uint64_t nInv_u64,
+  uint64_t *aM,
+  uint64_t *resM
+);
+#endif
+
+/*
+  Window width of the sliding-window variable-time exponentiation for an
+  exponent of bBits bits: the precomputed table holds 2^(l - 1) odd powers.
+*/
+uint32_t Hacl_Bignum_Exponentiation_bn_get_window_vartime(uint32_t bBits);
+
+/*
+  Window width of the fixed-window constant-time exponentiation for a len-limb
+  modulus and an exponent of bBits bits. Each window saves multiplications but
+  costs a masked scan of the whole table, which is cheap next to a Montgomery
+  multiplication only for large len: 4 bits up to 512-bit exponents, then 5,
+  and 6 past 1280 bits for moduli of 3072 bits and more.
+*/
+uint32_t Hacl_Bignum_Exponentiation_bn_get_window_consttime(uint32_t len, uint32_t bBits);
+
 uint32_t
 Hacl_Bignum_Exponentiation_bn_check_mod_exp_u32(
   uint32_t len,
@@ -325,6 +375,26 @@ Hacl_Bignum_Exponentiation_bn_mod_exp_vartime_precomp_u64(
   uint64_t *res
 );
 
+/*
+  Fixed-window constant-time modular exponentiation with a window of l bits,
+  i.e. a table of 2^l Montgomery-form powers of a, each selected with a full
+  masked scan. Requires 1 <= l <= 8; other values abort. Larger windows trade fewer
+  multiplications for a bigger table and a longer scan per window; see
+  Hacl_Bignum_Exponentiation_bn_get_window_consttime for the defaults.
+*/
+void
+Hacl_Bignum_Exponentiation_bn_mod_exp_consttime_precomp_fw_u64(
+  uint32_t len,
+  uint32_t l,
+  uint64_t *n,
+  uint64_t mu,
+  uint64_t *r2,
+  uint64_t *a,
+  uint32_t bBits,
+  uint64_t *b,
+  uint64_t *res
+);
+
 void
 Hacl_Bignum_Exponentiation_bn_mod_exp_consttime_precomp_u64(
   uint32_t len,
@@ -24,6 +24,8 @@
 
 #include "Hacl_Bignum256.h"
 
+#include "bignum-inline.h"
+
 /*******************************************************************************
 
 A verified 256-bit bignum library.
@@ -359,17 +361,7 @@ void Hacl_Bignum256_sqr(uint64_t *a, uint64_t *res)
     uint64_t r = c;
     res[i0 + i0] = r;
   }
-  uint64_t c0 = Hacl_Bignum_Addition_bn_add_eq_len_u64((uint32_t)8U, res, res, res);
-  uint64_t tmp[8U] = { 0U };
-  for (uint32_t i = (uint32_t)0U; i < (uint32_t)4U; i++)
-  {
-    FStar_UInt128_uint128 res1 = FStar_UInt128_mul_wide(a[i], a[i]);
-    uint64_t hi = FStar_UInt128_uint128_to_uint64(FStar_UInt128_shift_right(res1, (uint32_t)64U));
-    uint64_t lo = FStar_UInt128_uint128_to_uint64(res1);
-    tmp[(uint32_t)2U * i] = lo;
-    tmp[(uint32_t)2U * i + (uint32_t)1U] = hi;
-  }
-  uint64_t c1 = Hacl_Bignum_Addition_bn_add_eq_len_u64((uint32_t)8U, res, tmp, res);
+  Hacl_Bignum_Base_bn_sqr_diag_add_u64((uint32_t)4U, a, res);
 }
 
 static inline void precompr2(uint32_t nBits, uint64_t *n, uint64_t *res)
@@ -507,9 +499,48 @@ static inline void areduction(uint64_t *n, uint64_t nInv, uint64_t *c, uint64_t
   }
 }
 
+#if HACL_CAN_COMPILE_INLINE_ASM
+static inline void areduction_adx(uint64_t *n, uint64_t nInv, uint64_t *c, uint64_t *res)
+{
+  uint64_t c0 = (uint64_t)0U;
+  for (uint32_t i0 = (uint32_t)0U; i0 < (uint32_t)4U; i0++)
+  {
+    uint64_t qj = nInv * c[i0];
+    uint64_t c10 = bn_mul1_add_adx(c + i0, n, qj, (uint64_t)4U);
+    uint64_t *resb = c + (uint32_t)4U + i0;
+    uint64_t res_j = c[(uint32_t)4U + i0];
+    c0 = Lib_IntTypes_Intrinsics_add_carry_u64(c0, c10, res_j, resb);
+  }
+  memcpy(res, c + (uint32_t)4U, (uint32_t)4U * sizeof (uint64_t));
+  uint64_t c00 = c0;
+  uint64_t tmp[4U] = { 0U };
+  uint64_t c1 = Hacl_Bignum256_sub(res, n, tmp);
+  uint64_t m = (uint64_t)0U - c00;
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)4U; i++)
+  {
+    uint64_t *os = res;
+    uint64_t x = (m & tmp[i]) | (~m & res[i]);
+    os[i] = x;
+  }
+}
+#endif
+
 static inline void
 amont_mul(uint64_t *n, uint64_t nInv_u64, uint64_t *aM, uint64_t *bM, uint64_t *resM)
 {
+  #if HACL_CAN_COMPILE_INLINE_ASM
+  if (Hacl_Bignum_Montgomery_has_adx_bmi2())
+  {
+    uint64_t c[8U] = { 0U };
+    for (uint32_t i0 = (uint32_t)0U; i0 < (uint32_t)4U; i0++)
+    {
+      uint64_t r = bn_mul1_add_adx(c + i0, aM, bM[i0], (uint64_t)4U);
+      c[(uint32_t)4U + i0] = r;
+    }
+    areduction_adx(n, nInv_u64, c, resM);
+    return;
+  }
+  #endif
   uint64_t c[8U] = { 0U };
   memset(c, 0U, (uint32_t)8U * sizeof (uint64_t));
   for (uint32_t i0 = (uint32_t)0U; i0 < (uint32_t)4U; i0++)
@@ -546,6 +577,20 @@ amont_mul(uint64_t *n, uint64_t nInv_u64, uint64_t *aM, uint64_t *bM, uint64_t *
 
 static inline void amont_sqr(uint64_t *n, uint64_t nInv_u64, uint64_t *aM, uint64_t *resM)
 {
+  #if HACL_CAN_COMPILE_INLINE_ASM
+  if (Hacl_Bignum_Montgomery_has_adx_bmi2())
+  {
+    uint64_t c[8U] = { 0U };
+    for (uint32_t i0 = (uint32_t)1U; i0 < (uint32_t)4U; i0++)
+    {
+      uint64_t r = bn_mul1_add_adx(c + i0, aM, aM[i0], (uint64_t)i0);
+      c[i0 + i0] = r;
+    }
+    Hacl_Bignum_Base_bn_sqr_diag_add_u64((uint32_t)4U, aM, c);
+    areduction_adx(n, nInv_u64, c, resM);
+    return;
+  }
+  #endif
   uint64_t c[8U] = { 0U };
   memset(c, 0U, (uint32_t)8U * sizeof (uint64_t));
   for (uint32_t i0 = (uint32_t)0U; i0 < (uint32_t)4U; i0++)
@@ -578,17 +623,7 @@ static inline void amont_sqr(uint64_t *n, uint64_t nInv_u64, uint64_t *aM, uint6
     uint64_t r = c1;
     c[i0 + i0] = r;
   }
-  uint64_t c0 = Hacl_Bignum_Addition_bn_add_eq_len_u64((uint32_t)8U, c, c, c);
-  uint64_t tmp[8U] = { 0U };
-  for (uint32_t i = (uint32_t)0U; i < (uint32_t)4U; i++)
-  {
-    FStar_UInt128_uint128 res = FStar_UInt128_mul_wide(aM[i], aM[i]);
-    uint64_t hi = FStar_UInt128_uint128_to_uint64(FStar_UInt128_shift_right(res, (uint32_t)64U));
-    uint64_t lo = FStar_UInt128_uint128_to_uint64(res);
-    tmp[(uint32_t)2U * i] = lo;
-    tmp[(uint32_t)2U * i + (uint32_t)1U] = hi;
-  }
-  uint64_t c1 = Hacl_Bignum_Addition_bn_add_eq_len_u64((uint32_t)8U, c, tmp, c);
+  Hacl_Bignum_Base_bn_sqr_diag_add_u64((uint32_t)4U, aM, c);
   areduction(n, nInv_u64, c, resM);
 }
 
@@ -813,7 +848,15 @@ exp_vartime_precomp(
   {
     uint64_t *t11 = table + (i + (uint32_t)1U) * (uint32_t)4U;
     uint64_t *t2 = table + (i + (uint32_t)2U) * (uint32_t)4U;
-    amont_mul(n, mu, t11, aM, t2);
+    if (i % (uint32_t)2U == (uint32_t)0U)
+    {
+      uint64_t *t = table + (i + (uint32_t)2U) / (uint32_t)2U * (uint32_t)4U;
+      amont_sqr(n, mu, t, t2);
+    }
+    else
+    {
+      amont_mul(n, mu, t11, aM, t2);
+    }
   }
   for (uint32_t i = (uint32_t)0U; i < bBits / (uint32_t)4U; i++)
   {
@@ -947,7 +990,15 @@ exp_consttime_precomp(
   {
     uint64_t *t11 = table + (i + (uint32_t)1U) * (uint32_t)4U;
     uint64_t *t2 = table + (i + (uint32_t)2U) * (uint32_t)4U;
-    amont_mul(n, mu, t11, aM, t2);
+    if (i % (uint32_t)2U == (uint32_t)0U)
+    {
+      uint64_t *t = table + (i + (uint32_t)2U) / (uint32_t)2U * (uint32_t)4U;
+      amont_sqr(n, mu, t, t2);
+    }
+    else
+    {
+      amont_mul(n, mu, t11, aM, t2);
+    }
   }
   for (uint32_t i0 = (uint32_t)0U; i0 < bBits / (uint32_t)4U; i0++)
   {
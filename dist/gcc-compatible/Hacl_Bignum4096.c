@@ -446,6 +446,13 @@ static inline void areduction(uint64_t *n, uint64_t nInv, uint64_t *c, uint64_t
 static inline void
 amont_mul(uint64_t *n, uint64_t nInv_u64, uint64_t *aM, uint64_t *bM, uint64_t *resM)
 {
+  #if HACL_CAN_COMPILE_INLINE_ASM
+  if (Hacl_Bignum_Montgomery_has_adx_bmi2())
+  {
+    Hacl_Bignum_Montgomery_bn_almost_mont_mul_adx_u64((uint32_t)64U, n, nInv_u64, aM, bM, resM);
+    return;
+  }
+  #endif
   uint64_t c[128U] = { 0U };
   uint64_t tmp[256U] = { 0U };
   Hacl_Bignum_Karatsuba_bn_karatsuba_mul_uint64((uint32_t)64U, aM, bM, tmp, c);
@@ -454,6 +461,13 @@ amont_mul(uint64_t *n, uint64_t nInv_u64, uint64_t *aM, uint64_t *bM, uint64_t *
 
 static inline void amont_sqr(uint64_t *n, uint64_t nInv_u64, uint64_t *aM, uint64_t *resM)
 {
+  #if HACL_CAN_COMPILE_INLINE_ASM
+  if (Hacl_Bignum_Montgomery_has_adx_bmi2())
+  {
+    Hacl_Bignum_Montgomery_bn_almost_mont_sqr_adx_u64((uint32_t)64U, n, nInv_u64, aM, resM);
+    return;
+  }
+  #endif
   uint64_t c[128U] = { 0U };
   uint64_t tmp[256U] = { 0U };
   Hacl_Bignum_Karatsuba_bn_karatsuba_sqr_uint64((uint32_t)64U, aM, tmp, c);
@@ -629,110 +643,81 @@ exp_vartime_precomp(
   uint64_t *res
 )
 {
-  if (bBits < (uint32_t)200U)
-  {
-    uint64_t aM[64U] = { 0U };
-    uint64_t c[128U] = { 0U };
-    Hacl_Bignum4096_mul(a, r2, c);
-    reduction(n, mu, c, aM);
-    uint64_t resM[64U] = { 0U };
-    uint64_t tmp0[128U] = { 0U };
-    memcpy(tmp0, r2, (uint32_t)64U * sizeof (uint64_t));
-    reduction(n, mu, tmp0, resM);
-    for (uint32_t i = (uint32_t)0U; i < bBits; i++)
-    {
-      uint32_t i1 = i / (uint32_t)64U;
-      uint32_t j = i % (uint32_t)64U;
-      uint64_t tmp = b[i1];
-      uint64_t bit = tmp >> j & (uint64_t)1U;
-      if (!(bit == (uint64_t)0U))
-      {
-        amont_mul(n, mu, resM, aM, resM);
-      }
-      amont_sqr(n, mu, aM, aM);
-    }
-    uint64_t tmp[128U] = { 0U };
-    memcpy(tmp, resM, (uint32_t)64U * sizeof (uint64_t));
-    reduction(n, mu, tmp, res);
-    return;
-  }
   uint64_t aM[64U] = { 0U };
   uint64_t c[128U] = { 0U };
   Hacl_Bignum4096_mul(a, r2, c);
   reduction(n, mu, c, aM);
   uint64_t resM[64U] = { 0U };
-  uint32_t bLen;
-  if (bBits == (uint32_t)0U)
-  {
-    bLen = (uint32_t)1U;
-  }
-  else
-  {
-    bLen = (bBits - (uint32_t)1U) / (uint32_t)64U + (uint32_t)1U;
-  }
   uint64_t tmp[128U] = { 0U };
   memcpy(tmp, r2, (uint32_t)64U * sizeof (uint64_t));
   reduction(n, mu, tmp, resM);
-  uint64_t table[1024U] = { 0U };
-  memcpy(table, resM, (uint32_t)64U * sizeof (uint64_t));
-  uint64_t *t1 = table + (uint32_t)64U;
-  memcpy(t1, aM, (uint32_t)64U * sizeof (uint64_t));
-  for (uint32_t i = (uint32_t)0U; i < (uint32_t)14U; i++)
-  {
-    uint64_t *t11 = table + (i + (uint32_t)1U) * (uint32_t)64U;
-    uint64_t *t2 = table + (i + (uint32_t)2U) * (uint32_t)64U;
-    amont_mul(n, mu, t11, aM, t2);
-  }
-  for (uint32_t i = (uint32_t)0U; i < bBits / (uint32_t)4U; i++)
-  {
-    for (uint32_t i0 = (uint32_t)0U; i0 < (uint32_t)4U; i0++)
+  uint32_t l = Hacl_Bignum_Exponentiation_bn_get_window_vartime(bBits);
+  uint32_t tLen = (uint32_t)1U << (l - (uint32_t)1U);
+  uint64_t table[2048U] = { 0U };
+  memcpy(table, aM, (uint32_t)64U * sizeof (uint64_t));
+  if (l > (uint32_t)1U)
+  {
+    uint64_t aM2[64U] = { 0U };
+    amont_sqr(n, mu, aM, aM2);
+    for (uint32_t i = (uint32_t)0U; i < tLen - (uint32_t)1U; i++)
     {
-      amont_sqr(n, mu, resM, resM);
+      uint64_t *t1 = table + i * (uint32_t)64U;
+      uint64_t *t2 = table + (i + (uint32_t)1U) * (uint32_t)64U;
+      amont_mul(n, mu, t1, aM2, t2);
     }
-    uint64_t mask_l = (uint64_t)16U - (uint64_t)1U;
-    uint32_t i1 = (bBits - (uint32_t)4U * i - (uint32_t)4U) / (uint32_t)64U;
-    uint32_t j = (bBits - (uint32_t)4U * i - (uint32_t)4U) % (uint32_t)64U;
-    uint64_t p1 = b[i1] >> j;
-    uint64_t ite;
-    if (i1 + (uint32_t)1U < bLen && (uint32_t)0U < j)
-    {
-      ite = p1 | b[i1 + (uint32_t)1U] << ((uint32_t)64U - j);
-    }
-    else
-    {
-      ite = p1;
-    }
-    uint64_t bits_l = ite & mask_l;
-    uint32_t bits_l32 = (uint32_t)bits_l;
-    uint64_t *a_bits_l = table + bits_l32 * (uint32_t)64U;
-    amont_mul(n, mu, resM, a_bits_l, resM);
   }
-  if (!(bBits % (uint32_t)4U == (uint32_t)0U))
+  bool is_one = true;
+  uint32_t i = bBits;
+  while (i > (uint32_t)0U)
   {
-    uint32_t c0 = bBits % (uint32_t)4U;
-    for (uint32_t i = (uint32_t)0U; i < c0; i++)
-    {
-      amont_sqr(n, mu, resM, resM);
-    }
-    uint32_t c1 = bBits % (uint32_t)4U;
-    uint64_t mask_l = ((uint64_t)1U << c1) - (uint64_t)1U;
-    uint32_t i = (uint32_t)0U;
-    uint32_t j = (uint32_t)0U;
-    uint64_t p1 = b[i] >> j;
-    uint64_t ite;
-    if (i + (uint32_t)1U < bLen && (uint32_t)0U < j)
+    uint32_t k = i - (uint32_t)1U;
+    uint64_t bit = b[k / (uint32_t)64U] >> k % (uint32_t)64U & (uint64_t)1U;
+    if (bit == (uint64_t)0U)
     {
-      ite = p1 | b[i + (uint32_t)1U] << ((uint32_t)64U - j);
+      if (!is_one)
+      {
+        amont_sqr(n, mu, resM, resM);
+      }
+      i = k;
     }
     else
     {
-      ite = p1;
+      uint32_t s0;
+      if (i < l)
+      {
+        s0 = (uint32_t)0U;
+      }
+      else
+      {
+        s0 = i - l;
+      }
+      uint32_t s = s0;
+      while ((b[s / (uint32_t)64U] >> s % (uint32_t)64U & (uint64_t)1U) == (uint64_t)0U)
+      {
+        s++;
+      }
+      uint64_t bits = (uint64_t)0U;
+      for (uint32_t j = i; j > s; j--)
+      {
+        uint32_t j1 = j - (uint32_t)1U;
+        bits = bits << (uint32_t)1U | (b[j1 / (uint32_t)64U] >> j1 % (uint32_t)64U & (uint64_t)1U);
+      }
+      uint64_t *a_bits = table + (uint32_t)(bits >> (uint32_t)1U) * (uint32_t)64U;
+      if (is_one)
+      {
+        memcpy(resM, a_bits, (uint32_t)64U * sizeof (uint64_t));
+        is_one = false;
+      }
+      else
+      {
+        for (uint32_t j = s; j < i; j++)
+        {
+          amont_sqr(n, mu, resM, resM);
+        }
+        amont_mul(n, mu, resM, a_bits, resM);
+      }
+      i = s;
     }
-    uint64_t bits_c = ite & mask_l;
-    uint64_t bits_c0 = bits_c;
-    uint32_t bits_c32 = (uint32_t)bits_c0;
-    uint64_t *a_bits_c = table + bits_c32 * (uint32_t)64U;
-    amont_mul(n, mu, resM, a_bits_c, resM);
   }
   uint64_t tmp0[128U] = { 0U };
   memcpy(tmp0, resM, (uint32_t)64U * sizeof (uint64_t));
@@ -807,25 +792,35 @@ exp_consttime_precomp(
   uint64_t tmp[128U] = { 0U };
   memcpy(tmp, r2, (uint32_t)64U * sizeof (uint64_t));
   reduction(n, mu, tmp, resM);
-  uint64_t table[1024U] = { 0U };
+  uint32_t l = Hacl_Bignum_Exponentiation_bn_get_window_consttime((uint32_t)64U, bBits);
+  uint32_t tLen = (uint32_t)1U << l;
+  uint64_t table[4096U] = { 0U };
   memcpy(table, resM, (uint32_t)64U * sizeof (uint64_t));
   uint64_t *t1 = table + (uint32_t)64U;
   memcpy(t1, aM, (uint32_t)64U * sizeof (uint64_t));
-  for (uint32_t i = (uint32_t)0U; i < (uint32_t)14U; i++)
+  for (uint32_t i = (uint32_t)0U; i < tLen - (uint32_t)2U; i++)
   {
     uint64_t *t11 = table + (i + (uint32_t)1U) * (uint32_t)64U;
     uint64_t *t2 = table + (i + (uint32_t)2U) * (uint32_t)64U;
-    amont_mul(n, mu, t11, aM, t2);
+    if (i % (uint32_t)2U == (uint32_t)0U)
+    {
+      uint64_t *t = table + (i + (uint32_t)2U) / (uint32_t)2U * (uint32_t)64U;
+      amont_sqr(n, mu, t, t2);
+    }
+    else
+    {
+      amont_mul(n, mu, t11, aM, t2);
+    }
   }
-  for (uint32_t i0 = (uint32_t)0U; i0 < bBits / (uint32_t)4U; i0++)
+  for (uint32_t i0 = (uint32_t)0U; i0 < bBits / l; i0++)
   {
-    for (uint32_t i = (uint32_t)0U; i < (uint32_t)4U; i++)
+    for (uint32_t i = (uint32_t)0U; i < l; i++)
     {
       amont_sqr(n, mu, resM, resM);
     }
-    uint64_t mask_l = (uint64_t)16U - (uint64_t)1U;
-    uint32_t i1 = (bBits - (uint32_t)4U * i0 - (uint32_t)4U) / (uint32_t)64U;
-    uint32_t j = (bBits - (uint32_t)4U * i0 - (uint32_t)4U) % (uint32_t)64U;
+    uint64_t mask_l = ((uint64_t)1U << l) - (uint64_t)1U;
+    uint32_t i1 = (bBits - l * i0 - l) / (uint32_t)64U;
+    uint32_t j = (bBits - l * i0 - l) % (uint32_t)64U;
     uint64_t p1 = b[i1] >> j;
     uint64_t ite;
     if (i1 + (uint32_t)1U < bLen && (uint32_t)0U < j)
@@ -839,7 +834,7 @@ exp_consttime_precomp(
     uint64_t bits_l = ite & mask_l;
     uint64_t a_bits_l[64U] = { 0U };
     memcpy(a_bits_l, table, (uint32_t)64U * sizeof (uint64_t));
-    for (uint32_t i2 = (uint32_t)0U; i2 < (uint32_t)15U; i2++)
+    for (uint32_t i2 = (uint32_t)0U; i2 < tLen - (uint32_t)1U; i2++)
     {
       uint64_t c = FStar_UInt64_eq_mask(bits_l, (uint64_t)(i2 + (uint32_t)1U));
       uint64_t *res_j = table + (i2 + (uint32_t)1U) * (uint32_t)64U;
@@ -852,14 +847,14 @@ exp_consttime_precomp(
     }
     amont_mul(n, mu, resM, a_bits_l, resM);
   }
-  if (!(bBits % (uint32_t)4U == (uint32_t)0U))
+  if (!(bBits % l == (uint32_t)0U))
   {
-    uint32_t c = bBits % (uint32_t)4U;
+    uint32_t c = bBits % l;
     for (uint32_t i = (uint32_t)0U; i < c; i++)
     {
       amont_sqr(n, mu, resM, resM);
     }
-    uint32_t c10 = bBits % (uint32_t)4U;
+    uint32_t c10 = bBits % l;
     uint64_t mask_l = ((uint64_t)1U << c10) - (uint64_t)1U;
     uint32_t i0 = (uint32_t)0U;
     uint32_t j = (uint32_t)0U;
@@ -877,7 +872,7 @@ exp_consttime_precomp(
     uint64_t bits_c0 = bits_c;
     uint64_t a_bits_c[64U] = { 0U };
     memcpy(a_bits_c, table, (uint32_t)64U * sizeof (uint64_t));
-    for (uint32_t i1 = (uint32_t)0U; i1 < (uint32_t)15U; i1++)
+    for (uint32_t i1 = (uint32_t)0U; i1 < tLen - (uint32_t)1U; i1++)
     {
       uint64_t c1 = FStar_UInt64_eq_mask(bits_c0, (uint64_t)(i1 + (uint32_t)1U));
       uint64_t *res_j = table + (i1 + (uint32_t)1U) * (uint32_t)64U;
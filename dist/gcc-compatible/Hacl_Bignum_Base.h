@@ -30,6 +30,7 @@ extern "C" {
 #endif
 
 #include "evercrypt_targetconfig.h"
+#include "lib_intrinsics.h"
 #include "libintvector.h"
 #include "kremlin/internal/types.h"
 #include "kremlin/lowstar_endianness.h"
@@ -70,6 +71,31 @@ Hacl_Bignum_Base_mul_wide_add2_u64(uint64_t a, uint64_t b, uint64_t c_in, uint64
   return FStar_UInt128_uint128_to_uint64(FStar_UInt128_shift_right(res, (uint32_t)64U));
 }
 
+/*
+  Last step of a squaring: res holds the cross products a[i] * a[j], i < j,
+  and is replaced by 2 * res + sum_i a[i]^2 * 2^(128 * i). Doubling and adding
+  the squares are fused in a single pass over the 2 * aLen limbs of res.
+*/
+static inline void
+Hacl_Bignum_Base_bn_sqr_diag_add_u64(uint32_t aLen, uint64_t *a, uint64_t *res)
+{
+  uint64_t c = (uint64_t)0U;
+  uint64_t hb = (uint64_t)0U;
+  for (uint32_t i = (uint32_t)0U; i < aLen; i++)
+  {
+    FStar_UInt128_uint128 sq = FStar_UInt128_mul_wide(a[i], a[i]);
+    uint64_t lo = FStar_UInt128_uint128_to_uint64(sq);
+    uint64_t hi = FStar_UInt128_uint128_to_uint64(FStar_UInt128_shift_right(sq, (uint32_t)64U));
+    uint64_t r0 = res[(uint32_t)2U * i];
+    uint64_t r1 = res[(uint32_t)2U * i + (uint32_t)1U];
+    uint64_t d0 = r0 << (uint32_t)1U | hb;
+    uint64_t d1 = r1 << (uint32_t)1U | r0 >> (uint32_t)63U;
+    hb = r1 >> (uint32_t)63U;
+    c = Lib_IntTypes_Intrinsics_add_carry_u64(c, d0, lo, res + (uint32_t)2U * i);
+    c = Lib_IntTypes_Intrinsics_add_carry_u64(c, d1, hi, res + (uint32_t)2U * i + (uint32_t)1U);
+  }
+}
+
 #if defined(__cplusplus)
 }
 #endif
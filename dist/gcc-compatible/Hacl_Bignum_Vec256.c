@@ -0,0 +1,347 @@
+/* MIT License
+ *
+ * Copyright (c) 2016-2020 INRIA, CMU and Microsoft Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "Hacl_Bignum_Vec256.h"
+
+/*
+  Four independent bignums, one per 64-bit lane of a vec256, in radix 2^26:
+  limb i of lane l is held in lane l of vector i. 26-bit limbs leave enough
+  headroom for vpmuludq products to be accumulated without carries.
+*/
+
+static inline uint32_t len26(uint32_t len)
+{
+  return ((uint32_t)64U * len + (uint32_t)2U - (uint32_t)1U) / (uint32_t)26U + (uint32_t)1U;
+}
+
+/*
+  Almost Montgomery multiplication modulo R = 2^(26 * l): for inputs below 2n,
+  res = a * b / R mod n with res < 2n. The scratch t holds 2 * l vectors.
+*/
+static inline void
+bn_almost_mont_mul_x4(
+  uint32_t l,
+  Lib_IntVector_Intrinsics_vec256 *n,
+  Lib_IntVector_Intrinsics_vec256 mu,
+  Lib_IntVector_Intrinsics_vec256 *a,
+  Lib_IntVector_Intrinsics_vec256 *b,
+  Lib_IntVector_Intrinsics_vec256 *t,
+  Lib_IntVector_Intrinsics_vec256 *res
+)
+{
+  Lib_IntVector_Intrinsics_vec256 mask26 = Lib_IntVector_Intrinsics_vec256_load64((uint64_t)0x3ffffffU);
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)2U * l; i++)
+  {
+    t[i] = Lib_IntVector_Intrinsics_vec256_zero;
+  }
+  for (uint32_t i = (uint32_t)0U; i < l; i++)
+  {
+    Lib_IntVector_Intrinsics_vec256 ai = a[i];
+    Lib_IntVector_Intrinsics_vec256 *ti = t + i;
+    Lib_IntVector_Intrinsics_vec256
+    t0 = Lib_IntVector_Intrinsics_vec256_add64(ti[0U], Lib_IntVector_Intrinsics_vec256_mul64(ai, b[0U]));
+    Lib_IntVector_Intrinsics_vec256
+    q =
+      Lib_IntVector_Intrinsics_vec256_and(Lib_IntVector_Intrinsics_vec256_mul64(t0, mu),
+        mask26);
+    t0 = Lib_IntVector_Intrinsics_vec256_add64(t0, Lib_IntVector_Intrinsics_vec256_mul64(q, n[0U]));
+    ti[1U] =
+      Lib_IntVector_Intrinsics_vec256_add64(ti[1U],
+        Lib_IntVector_Intrinsics_vec256_shift_right64(t0, (uint32_t)26U));
+    for (uint32_t j = (uint32_t)1U; j < l; j++)
+    {
+      Lib_IntVector_Intrinsics_vec256 ab = Lib_IntVector_Intrinsics_vec256_mul64(ai, b[j]);
+      Lib_IntVector_Intrinsics_vec256 qn = Lib_IntVector_Intrinsics_vec256_mul64(q, n[j]);
+      ti[j] =
+        Lib_IntVector_Intrinsics_vec256_add64(ti[j],
+          Lib_IntVector_Intrinsics_vec256_add64(ab, qn));
+    }
+  }
+  Lib_IntVector_Intrinsics_vec256 c = Lib_IntVector_Intrinsics_vec256_zero;
+  for (uint32_t i = (uint32_t)0U; i < l; i++)
+  {
+    Lib_IntVector_Intrinsics_vec256 x = Lib_IntVector_Intrinsics_vec256_add64(t[l + i], c);
+    res[i] = Lib_IntVector_Intrinsics_vec256_and(x, mask26);
+    c = Lib_IntVector_Intrinsics_vec256_shift_right64(x, (uint32_t)26U);
+  }
+}
+
+static inline void
+bn_from_limbs_x4(
+  uint32_t len,
+  uint32_t l,
+  uint64_t **a,
+  Lib_IntVector_Intrinsics_vec256 *res
+)
+{
+  for (uint32_t i = (uint32_t)0U; i < l; i++)
+  {
+    uint32_t bit = (uint32_t)26U * i;
+    uint32_t i1 = bit / (uint32_t)64U;
+    uint32_t j = bit % (uint32_t)64U;
+    uint64_t x[4U] = { 0U };
+    for (uint32_t k = (uint32_t)0U; k < (uint32_t)4U; k++)
+    {
+      uint64_t *ak = a[k];
+      uint64_t p1 = (uint64_t)0U;
+      if (i1 < len)
+      {
+        p1 = ak[i1] >> j;
+        if (i1 + (uint32_t)1U < len && (uint32_t)38U < j)
+        {
+          p1 = p1 | ak[i1 + (uint32_t)1U] << ((uint32_t)64U - j);
+        }
+      }
+      x[k] = p1 & (uint64_t)0x3ffffffU;
+    }
+    res[i] = Lib_IntVector_Intrinsics_vec256_load64s(x[0U], x[1U], x[2U], x[3U]);
+  }
+}
+
+static inline void
+bn_to_limbs_x4(
+  uint32_t len,
+  uint32_t l,
+  Lib_IntVector_Intrinsics_vec256 *a,
+  uint64_t **res
+)
+{
+  for (uint32_t k = (uint32_t)0U; k < (uint32_t)4U; k++)
+  {
+    memset(res[k], 0U, len * sizeof (uint64_t));
+  }
+  for (uint32_t i = (uint32_t)0U; i < l; i++)
+  {
+    uint32_t bit = (uint32_t)26U * i;
+    uint32_t i1 = bit / (uint32_t)64U;
+    uint32_t j = bit % (uint32_t)64U;
+    uint64_t x[4U] = { 0U };
+    x[0U] = Lib_IntVector_Intrinsics_vec256_extract64(a[i], 0);
+    x[1U] = Lib_IntVector_Intrinsics_vec256_extract64(a[i], 1);
+    x[2U] = Lib_IntVector_Intrinsics_vec256_extract64(a[i], 2);
+    x[3U] = Lib_IntVector_Intrinsics_vec256_extract64(a[i], 3);
+    for (uint32_t k = (uint32_t)0U; k < (uint32_t)4U; k++)
+    {
+      uint64_t *rk = res[k];
+      if (i1 < len)
+      {
+        rk[i1] = rk[i1] | x[k] << j;
+        if (i1 + (uint32_t)1U < len && (uint32_t)38U < j)
+        {
+          rk[i1 + (uint32_t)1U] = rk[i1 + (uint32_t)1U] | x[k] >> ((uint32_t)64U - j);
+        }
+      }
+    }
+  }
+}
+
+static inline bool get_bit(uint64_t *b, uint32_t i)
+{
+  return (b[i / (uint32_t)64U] >> i % (uint32_t)64U & (uint64_t)1U) == (uint64_t)1U;
+}
+
+static inline Lib_IntVector_Intrinsics_vec256 lane_mask(bool *c)
+{
+  return
+    Lib_IntVector_Intrinsics_vec256_load64s((uint64_t)0U - (uint64_t)c[0U],
+      (uint64_t)0U - (uint64_t)c[1U],
+      (uint64_t)0U - (uint64_t)c[2U],
+      (uint64_t)0U - (uint64_t)c[3U]);
+}
+
+static inline void
+bn_select_x4(
+  uint32_t l,
+  Lib_IntVector_Intrinsics_vec256 m,
+  Lib_IntVector_Intrinsics_vec256 *a,
+  Lib_IntVector_Intrinsics_vec256 *b,
+  Lib_IntVector_Intrinsics_vec256 *res
+)
+{
+  for (uint32_t i = (uint32_t)0U; i < l; i++)
+  {
+    res[i] =
+      Lib_IntVector_Intrinsics_vec256_or(Lib_IntVector_Intrinsics_vec256_and(m, a[i]),
+        Lib_IntVector_Intrinsics_vec256_and(Lib_IntVector_Intrinsics_vec256_lognot(m), b[i]));
+  }
+}
+
+/*
+Write `a[k] ^ b[k] mod n[k]` in `res[k]` for each of the four lanes 0 <= k < 4.
+
+  The arguments n[k], r2[k], a[k] and the outparams res[k] are meant to be `len`
+  limbs in size, i.e. uint64_t[len]; r2[k] is 2 ^ (128 * len) mod n[k], as
+  computed by Hacl_Bignum_Montgomery_bn_precomp_r2_mod_n_u64.
+  The argument b[k] is a bignum of any size, and bBits[k] is an upper bound
+  on its number of significant bits.
+
+  The four exponentiations share one squaring chain, which makes this a good
+  fit for verification with small public exponents. The moduli may differ,
+  but must all be `len` limbs in size.
+
+  The function is *NOT* constant-time on the arguments b[k].
+
+  Before calling this function, the caller will need to ensure that the following
+  preconditions are observed.
+  • n[k] % 2 = 1 and 1 < n[k]
+  • a[k] < n[k]
+*/
+void
+Hacl_Bignum_Vec256_bn_mod_exp_vartime_x4(
+  uint32_t len,
+  uint64_t **n,
+  uint64_t **r2,
+  uint64_t **a,
+  uint32_t *bBits,
+  uint64_t **b,
+  uint64_t **res
+)
+{
+  uint32_t l = len26(len);
+  uint32_t delta = (uint32_t)26U * l - (uint32_t)64U * len;
+  /* r2 * 2 ^ (2 * delta) mod n = 2 ^ (52 * l) mod n, i.e. R ^ 2 for the radix-2^26 domain */
+  KRML_CHECK_SIZE(sizeof (uint64_t), (uint32_t)4U * len);
+  uint64_t c2[(uint32_t)4U * len];
+  memset(c2, 0U, (uint32_t)4U * len * sizeof (uint64_t));
+  uint64_t *c2s[4U] = { c2, c2 + len, c2 + (uint32_t)2U * len, c2 + (uint32_t)3U * len };
+  uint64_t mu64[4U] = { 0U };
+  for (uint32_t k = (uint32_t)0U; k < (uint32_t)4U; k++)
+  {
+    memcpy(c2s[k], r2[k], len * sizeof (uint64_t));
+    for (uint32_t i = (uint32_t)0U; i < (uint32_t)2U * delta; i++)
+    {
+      Hacl_Bignum_bn_add_mod_n_u64(len, n[k], c2s[k], c2s[k], c2s[k]);
+    }
+    mu64[k] = Hacl_Bignum_ModInvLimb_mod_inv_uint64(n[k][0U]) & (uint64_t)0x3ffffffU;
+  }
+  Lib_IntVector_Intrinsics_vec256
+  mu = Lib_IntVector_Intrinsics_vec256_load64s(mu64[0U], mu64[1U], mu64[2U], mu64[3U]);
+  KRML_CHECK_SIZE(sizeof (Lib_IntVector_Intrinsics_vec256), (uint32_t)8U * l);
+  Lib_IntVector_Intrinsics_vec256 buf[(uint32_t)8U * l];
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)8U * l; i++)
+  {
+    buf[i] = Lib_IntVector_Intrinsics_vec256_zero;
+  }
+  Lib_IntVector_Intrinsics_vec256 *nv = buf;
+  Lib_IntVector_Intrinsics_vec256 *aM = buf + l;
+  Lib_IntVector_Intrinsics_vec256 *accM = buf + (uint32_t)2U * l;
+  Lib_IntVector_Intrinsics_vec256 *oneM = buf + (uint32_t)3U * l;
+  Lib_IntVector_Intrinsics_vec256 *tmp = buf + (uint32_t)4U * l;
+  Lib_IntVector_Intrinsics_vec256 *t = buf + (uint32_t)5U * l;
+  Lib_IntVector_Intrinsics_vec256 *c2v = buf + (uint32_t)7U * l;
+  bn_from_limbs_x4(len, l, n, nv);
+  bn_from_limbs_x4(len, l, c2s, c2v);
+  bn_from_limbs_x4(len, l, a, tmp);
+  bn_almost_mont_mul_x4(l, nv, mu, tmp, c2v, t, aM);
+  uint32_t top = (uint32_t)0U;
+  for (uint32_t k = (uint32_t)0U; k < (uint32_t)4U; k++)
+  {
+    for (uint32_t i = (uint32_t)0U; i < bBits[k]; i++)
+    {
+      if (get_bit(b[k], i) && top < i + (uint32_t)1U)
+      {
+        top = i + (uint32_t)1U;
+      }
+    }
+  }
+  /* lanes whose exponents have fewer bits multiply by one until their top bit */
+  bool uniform = true;
+  for (uint32_t i = (uint32_t)0U; i < top; i++)
+  {
+    for (uint32_t k = (uint32_t)1U; k < (uint32_t)4U; k++)
+    {
+      bool b0 = i < bBits[0U] && get_bit(b[0U], i);
+      bool bk = i < bBits[k] && get_bit(b[k], i);
+      if (b0 != bk)
+      {
+        uniform = false;
+      }
+    }
+  }
+  if (!uniform || top == (uint32_t)0U)
+  {
+    memset(tmp, 0U, l * sizeof (Lib_IntVector_Intrinsics_vec256));
+    tmp[0U] = Lib_IntVector_Intrinsics_vec256_load64((uint64_t)1U);
+    bn_almost_mont_mul_x4(l, nv, mu, c2v, tmp, t, oneM);
+  }
+  if (top == (uint32_t)0U)
+  {
+    memcpy(accM, oneM, l * sizeof (Lib_IntVector_Intrinsics_vec256));
+  }
+  else
+  {
+    bool c[4U] = { 0U };
+    for (uint32_t k = (uint32_t)0U; k < (uint32_t)4U; k++)
+    {
+      c[k] = top - (uint32_t)1U < bBits[k] && get_bit(b[k], top - (uint32_t)1U);
+    }
+    if (uniform)
+    {
+      memcpy(accM, aM, l * sizeof (Lib_IntVector_Intrinsics_vec256));
+    }
+    else
+    {
+      bn_select_x4(l, lane_mask(c), aM, oneM, accM);
+    }
+    for (uint32_t i0 = (uint32_t)0U; i0 < top - (uint32_t)1U; i0++)
+    {
+      uint32_t i = top - i0 - (uint32_t)2U;
+      bn_almost_mont_mul_x4(l, nv, mu, accM, accM, t, accM);
+      bool any = false;
+      for (uint32_t k = (uint32_t)0U; k < (uint32_t)4U; k++)
+      {
+        c[k] = i < bBits[k] && get_bit(b[k], i);
+        any = any || c[k];
+      }
+      if (any)
+      {
+        if (uniform)
+        {
+          bn_almost_mont_mul_x4(l, nv, mu, accM, aM, t, accM);
+        }
+        else
+        {
+          bn_select_x4(l, lane_mask(c), aM, oneM, tmp);
+          bn_almost_mont_mul_x4(l, nv, mu, accM, tmp, t, accM);
+        }
+      }
+    }
+  }
+  memset(tmp, 0U, l * sizeof (Lib_IntVector_Intrinsics_vec256));
+  tmp[0U] = Lib_IntVector_Intrinsics_vec256_load64((uint64_t)1U);
+  bn_almost_mont_mul_x4(l, nv, mu, accM, tmp, t, accM);
+  bn_to_limbs_x4(len, l, accM, res);
+  /* accM / R mod n is at most n: one conditional subtraction */
+  KRML_CHECK_SIZE(sizeof (uint64_t), len);
+  uint64_t r[len];
+  memset(r, 0U, len * sizeof (uint64_t));
+  for (uint32_t k = (uint32_t)0U; k < (uint32_t)4U; k++)
+  {
+    uint64_t c0 = Hacl_Bignum_Addition_bn_sub_eq_len_u64(len, res[k], n[k], r);
+    if (c0 == (uint64_t)0U)
+    {
+      memcpy(res[k], r, len * sizeof (uint64_t));
+    }
+  }
+}
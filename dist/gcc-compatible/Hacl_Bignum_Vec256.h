@@ -0,0 +1,79 @@
+/* MIT License
+ *
+ * Copyright (c) 2016-2020 INRIA, CMU and Microsoft Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef __Hacl_Bignum_Vec256_H
+#define __Hacl_Bignum_Vec256_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include "evercrypt_targetconfig.h"
+#include "libintvector.h"
+#include "kremlin/internal/types.h"
+#include "kremlin/lowstar_endianness.h"
+#include <string.h>
+#include "kremlin/internal/target.h"
+
+
+#include "Hacl_Kremlib.h"
+#include "Hacl_Bignum.h"
+
+/*
+Write `a[k] ^ b[k] mod n[k]` in `res[k]` for each of the four lanes 0 <= k < 4.
+
+  The arguments n[k], r2[k], a[k] and the outparams res[k] are meant to be `len`
+  limbs in size, i.e. uint64_t[len]; r2[k] is 2 ^ (128 * len) mod n[k], as
+  computed by Hacl_Bignum_Montgomery_bn_precomp_r2_mod_n_u64.
+  The argument b[k] is a bignum of any size, and bBits[k] is an upper bound
+  on its number of significant bits.
+
+  The four exponentiations share one squaring chain, which makes this a good
+  fit for verification with small public exponents. The moduli may differ,
+  but must all be `len` limbs in size.
+
+  The function is *NOT* constant-time on the arguments b[k].
+
+  Before calling this function, the caller will need to ensure that the following
+  preconditions are observed.
+  • n[k] % 2 = 1 and 1 < n[k]
+  • a[k] < n[k]
+*/
+void
+Hacl_Bignum_Vec256_bn_mod_exp_vartime_x4(
+  uint32_t len,
+  uint64_t **n,
+  uint64_t **r2,
+  uint64_t **a,
+  uint32_t *bBits,
+  uint64_t **b,
+  uint64_t **res
+);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#define __Hacl_Bignum_Vec256_H_DEFINED
+#endif
@@ -906,26 +906,19 @@ poly1305_padded_256(Lib_IntVector_Intrinsics_vec256 *ctx, uint32_t len, uint8_t
   }
 }
 
+/*
+  Absorbs the final block of lengths and writes the tag to out.
+*/
 static inline void
-poly1305_do_256(
+poly1305_do_finish_256(
+  Lib_IntVector_Intrinsics_vec256 *ctx,
   uint8_t *k,
   uint32_t aadlen,
-  uint8_t *aad,
   uint32_t mlen,
-  uint8_t *m,
   uint8_t *out
 )
 {
-  Lib_IntVector_Intrinsics_vec256 ctx[25U];
-  for (uint32_t _i = 0U; _i < (uint32_t)25U; ++_i)
-    ctx[_i] = Lib_IntVector_Intrinsics_vec256_zero;
   uint8_t block[16U] = { 0U };
-  Hacl_Poly1305_256_poly1305_init(ctx, k);
-  if (aadlen != (uint32_t)0U)
-  {
-    poly1305_padded_256(ctx, aadlen, aad);
-  }
-  poly1305_padded_256(ctx, mlen, m);
   store64_le(block, (uint64_t)aadlen);
   store64_le(block + (uint32_t)8U, (uint64_t)mlen);
   Lib_IntVector_Intrinsics_vec256 *pre = ctx + (uint32_t)5U;
@@ -1138,6 +1131,11 @@ poly1305_do_256(
   Hacl_Poly1305_256_poly1305_finish(out, k, ctx);
 }
 
+/*
+  Encryption makes a single pass over the message: it is processed in chunks of
+  4096 bytes, and each chunk of ciphertext is absorbed by Poly1305 right after it
+  is produced, while it is still in the L1 cache.
+*/
 void
 Hacl_Chacha20Poly1305_256_aead_encrypt(
   uint8_t *k,
@@ -1150,11 +1148,39 @@ Hacl_Chacha20Poly1305_256_aead_encrypt(
   uint8_t *mac
 )
 {
-  Hacl_Chacha20_Vec256_chacha20_encrypt_256(mlen, cipher, m, k, n, (uint32_t)1U);
   uint8_t tmp[64U] = { 0U };
   Hacl_Chacha20_Vec256_chacha20_encrypt_256((uint32_t)64U, tmp, tmp, k, n, (uint32_t)0U);
   uint8_t *key = tmp;
-  poly1305_do_256(key, aadlen, aad, mlen, cipher, mac);
+  Lib_IntVector_Intrinsics_vec256 ctx[25U];
+  for (uint32_t _i = 0U; _i < (uint32_t)25U; ++_i)
+    ctx[_i] = Lib_IntVector_Intrinsics_vec256_zero;
+  Hacl_Poly1305_256_poly1305_init(ctx, key);
+  if (aadlen != (uint32_t)0U)
+  {
+    poly1305_padded_256(ctx, aadlen, aad);
+  }
+  uint32_t nb = mlen / (uint32_t)4096U;
+  uint32_t rem = mlen % (uint32_t)4096U;
+  for (uint32_t i = (uint32_t)0U; i < nb; i++)
+  {
+    uint8_t *mi = m + i * (uint32_t)4096U;
+    uint8_t *ci = cipher + i * (uint32_t)4096U;
+    Hacl_Chacha20_Vec256_chacha20_encrypt_256((uint32_t)4096U,
+      ci,
+      mi,
+      k,
+      n,
+      (uint32_t)1U + i * (uint32_t)64U);
+    poly1305_padded_256(ctx, (uint32_t)4096U, ci);
+  }
+  if (rem > (uint32_t)0U)
+  {
+    uint8_t *mi = m + nb * (uint32_t)4096U;
+    uint8_t *ci = cipher + nb * (uint32_t)4096U;
+    Hacl_Chacha20_Vec256_chacha20_encrypt_256(rem, ci, mi, k, n, (uint32_t)1U + nb * (uint32_t)64U);
+    poly1305_padded_256(ctx, rem, ci);
+  }
+  poly1305_do_finish_256(ctx, key, aadlen, mlen, mac);
 }
 
 uint32_t
@@ -1173,7 +1199,16 @@ Hacl_Chacha20Poly1305_256_aead_decrypt(
   uint8_t tmp[64U] = { 0U };
   Hacl_Chacha20_Vec256_chacha20_encrypt_256((uint32_t)64U, tmp, tmp, k, n, (uint32_t)0U);
   uint8_t *key = tmp;
-  poly1305_do_256(key, aadlen, aad, mlen, cipher, computed_mac);
+  Lib_IntVector_Intrinsics_vec256 ctx[25U];
+  for (uint32_t _i = 0U; _i < (uint32_t)25U; ++_i)
+    ctx[_i] = Lib_IntVector_Intrinsics_vec256_zero;
+  Hacl_Poly1305_256_poly1305_init(ctx, key);
+  if (aadlen != (uint32_t)0U)
+  {
+    poly1305_padded_256(ctx, aadlen, aad);
+  }
+  poly1305_padded_256(ctx, mlen, cipher);
+  poly1305_do_finish_256(ctx, key, aadlen, mlen, computed_mac);
   uint8_t res = (uint8_t)255U;
   for (uint32_t i = (uint32_t)0U; i < (uint32_t)16U; i++)
   {
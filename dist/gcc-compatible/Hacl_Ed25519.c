@@ -24,6 +24,8 @@
 
 #include "Hacl_Ed25519.h"
 
+#include "Hacl_Ed25519_PrecompTable.h"
+
 static inline void fsum(uint64_t *a, uint64_t *b)
 {
   Hacl_Impl_Curve25519_Field51_fadd(a, a, b);
@@ -455,9 +457,8 @@ void Hacl_Impl_Ed25519_Ladder_point_mul(uint64_t *result, uint8_t *scalar, uint6
   memcpy(result, nq, (uint32_t)20U * sizeof (uint64_t));
 }
 
-static inline void point_mul_g(uint64_t *result, uint8_t *scalar)
+static inline void make_g(uint64_t *g)
 {
-  uint64_t g[20U] = { 0U };
   uint64_t *gx = g;
   uint64_t *gy = g + (uint32_t)5U;
   uint64_t *gz = g + (uint32_t)10U;
@@ -482,7 +483,97 @@ static inline void point_mul_g(uint64_t *result, uint8_t *scalar)
   gt[2U] = (uint64_t)0x0002af8df483c27eU;
   gt[3U] = (uint64_t)0x000332b375274732U;
   gt[4U] = (uint64_t)0x00067875f0fd78b7U;
-  Hacl_Impl_Ed25519_Ladder_point_mul(result, scalar, g);
+}
+
+static inline void make_point_inf(uint64_t *b)
+{
+  uint64_t *x = b;
+  uint64_t *y = b + (uint32_t)5U;
+  uint64_t *z = b + (uint32_t)10U;
+  uint64_t *t = b + (uint32_t)15U;
+  x[0U] = (uint64_t)0U;
+  x[1U] = (uint64_t)0U;
+  x[2U] = (uint64_t)0U;
+  x[3U] = (uint64_t)0U;
+  x[4U] = (uint64_t)0U;
+  y[0U] = (uint64_t)1U;
+  y[1U] = (uint64_t)0U;
+  y[2U] = (uint64_t)0U;
+  y[3U] = (uint64_t)0U;
+  y[4U] = (uint64_t)0U;
+  z[0U] = (uint64_t)1U;
+  z[1U] = (uint64_t)0U;
+  z[2U] = (uint64_t)0U;
+  z[3U] = (uint64_t)0U;
+  z[4U] = (uint64_t)0U;
+  t[0U] = (uint64_t)0U;
+  t[1U] = (uint64_t)0U;
+  t[2U] = (uint64_t)0U;
+  t[3U] = (uint64_t)0U;
+  t[4U] = (uint64_t)0U;
+}
+
+static inline void
+precomp_get_consttime(const uint64_t *table, uint64_t bits_l, uint64_t *tmp)
+{
+  memcpy(tmp, table, (uint32_t)20U * sizeof (uint64_t));
+  for (uint32_t i0 = (uint32_t)0U; i0 < (uint32_t)15U; i0++)
+  {
+    uint64_t c = FStar_UInt64_eq_mask(bits_l, (uint64_t)(i0 + (uint32_t)1U));
+    const uint64_t *res_j = table + (i0 + (uint32_t)1U) * (uint32_t)20U;
+    for (uint32_t i = (uint32_t)0U; i < (uint32_t)20U; i++)
+    {
+      uint64_t *os = tmp;
+      uint64_t x = (c & res_j[i]) | (~c & tmp[i]);
+      os[i] = x;
+    }
+  }
+}
+
+/*
+  Constant-time fixed-base multiplication [scalar]G. The scalar is split into
+  four 64-bit words b0 + 2^64 b1 + 2^128 b2 + 2^192 b3, and the four words are
+  processed together with 4-bit windows over the precomputed tables of
+  [j]G, [j 2^64]G, [j 2^128]G and [j 2^192]G: 60 doublings and 64 additions,
+  with every table access done by a masked scan.
+*/
+static inline void point_mul_g(uint64_t *result, uint8_t *scalar)
+{
+  uint64_t bscalar[4U] = { 0U };
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)4U; i++)
+  {
+    uint64_t *os = bscalar;
+    uint8_t *bj = scalar + i * (uint32_t)8U;
+    uint64_t u = load64_le(bj);
+    uint64_t r = u;
+    uint64_t x = r;
+    os[i] = x;
+  }
+  uint64_t tmp[20U] = { 0U };
+  make_point_inf(result);
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)16U; i++)
+  {
+    if (i > (uint32_t)0U)
+    {
+      point_double(result, result);
+      point_double(result, result);
+      point_double(result, result);
+      point_double(result, result);
+    }
+    uint32_t k = (uint32_t)60U - (uint32_t)4U * i;
+    uint64_t bits_l0 = bscalar[3U] >> k & (uint64_t)15U;
+    precomp_get_consttime(Hacl_Ed25519_PrecompTable_precomp_g_pow2_192_table_w4, bits_l0, tmp);
+    Hacl_Impl_Ed25519_PointAdd_point_add(result, result, tmp);
+    uint64_t bits_l1 = bscalar[2U] >> k & (uint64_t)15U;
+    precomp_get_consttime(Hacl_Ed25519_PrecompTable_precomp_g_pow2_128_table_w4, bits_l1, tmp);
+    Hacl_Impl_Ed25519_PointAdd_point_add(result, result, tmp);
+    uint64_t bits_l2 = bscalar[1U] >> k & (uint64_t)15U;
+    precomp_get_consttime(Hacl_Ed25519_PrecompTable_precomp_g_pow2_64_table_w4, bits_l2, tmp);
+    Hacl_Impl_Ed25519_PointAdd_point_add(result, result, tmp);
+    uint64_t bits_l3 = bscalar[0U] >> k & (uint64_t)15U;
+    precomp_get_consttime(Hacl_Ed25519_PrecompTable_precomp_basepoint_table_w4, bits_l3, tmp);
+    Hacl_Impl_Ed25519_PointAdd_point_add(result, result, tmp);
+  }
 }
 
 void Hacl_Impl_Ed25519_PointCompress_point_compress(uint8_t *z, uint64_t *p)
@@ -1659,6 +1750,226 @@ void Hacl_Impl_Ed25519_PointNegate_point_negate(uint64_t *p, uint64_t *out)
   Hacl_Bignum25519_reduce_513(t1);
 }
 
+static inline bool point_is_inf(uint64_t *p)
+{
+  uint64_t tmp[15U] = { 0U };
+  uint64_t *x = tmp;
+  uint64_t *y = tmp + (uint32_t)5U;
+  uint64_t *z = tmp + (uint32_t)10U;
+  memcpy(x, p, (uint32_t)5U * sizeof (uint64_t));
+  memcpy(y, p + (uint32_t)5U, (uint32_t)5U * sizeof (uint64_t));
+  memcpy(z, p + (uint32_t)10U, (uint32_t)5U * sizeof (uint64_t));
+  reduce(x);
+  reduce(y);
+  reduce(z);
+  return is_0(x) && eq(y, z);
+}
+
+/*
+  Width-w non-adjacent form of a 256-bit little-endian scalar: on return,
+  scalar = sum naf[i] 2^i, where every non-zero digit is odd, |naf[i]| < 2^(w-1)
+  and any w consecutive digits contain at most one non-zero digit.
+  Returns the number of significant digits. Variable-time.
+*/
+static inline uint32_t wnaf(int8_t *naf, uint8_t *scalar, uint32_t w)
+{
+  uint64_t k[5U] = { 0U };
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)4U; i++)
+  {
+    k[i] = load64_le(scalar + i * (uint32_t)8U);
+  }
+  memset(naf, 0U, (uint32_t)257U * sizeof (int8_t));
+  uint64_t mask = ((uint64_t)1U << w) - (uint64_t)1U;
+  uint64_t half = (uint64_t)1U << (w - (uint32_t)1U);
+  uint32_t len = (uint32_t)0U;
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)257U; i++)
+  {
+    if ((k[0U] & (uint64_t)1U) == (uint64_t)1U)
+    {
+      uint64_t m = k[0U] & mask;
+      if (m < half)
+      {
+        naf[i] = (int8_t)m;
+        k[0U] = k[0U] - m;
+      }
+      else
+      {
+        uint64_t d = ((uint64_t)1U << w) - m;
+        naf[i] = (int8_t)((int32_t)m - ((int32_t)1 << w));
+        uint64_t c = (uint64_t)0U;
+        k[0U] = k[0U] + d;
+        c = (uint64_t)(k[0U] < d);
+        for (uint32_t j = (uint32_t)1U; j < (uint32_t)5U; j++)
+        {
+          k[j] = k[j] + c;
+          c = (uint64_t)(c == (uint64_t)1U && k[j] == (uint64_t)0U);
+        }
+      }
+      len = i + (uint32_t)1U;
+    }
+    for (uint32_t j = (uint32_t)0U; j < (uint32_t)4U; j++)
+    {
+      k[j] = k[j] >> (uint32_t)1U | k[j + (uint32_t)1U] << (uint32_t)63U;
+    }
+    k[4U] = k[4U] >> (uint32_t)1U;
+  }
+  return len;
+}
+
+/*
+  table[i] = [2 i + 1]p for i < n, i.e. the odd multiples used by a width-w NAF
+  with n = 2^(w-2).
+*/
+static inline void make_odd_table(uint64_t *table, uint64_t *p, uint32_t n)
+{
+  uint64_t p2[20U] = { 0U };
+  memcpy(table, p, (uint32_t)20U * sizeof (uint64_t));
+  point_double(p2, p);
+  for (uint32_t i = (uint32_t)1U; i < n; i++)
+  {
+    Hacl_Impl_Ed25519_PointAdd_point_add(table + i * (uint32_t)20U,
+      table + (i - (uint32_t)1U) * (uint32_t)20U,
+      p2);
+  }
+}
+
+/*
+  out = out + [d]table, for an odd wNAF digit d (table holds odd multiples).
+*/
+static inline void point_add_naf_digit(uint64_t *out, const uint64_t *table, int8_t d)
+{
+  uint64_t tmp[20U] = { 0U };
+  if (d > (int8_t)0)
+  {
+    memcpy(tmp, table + (uint32_t)(d >> 1) * (uint32_t)20U, (uint32_t)20U * sizeof (uint64_t));
+    Hacl_Impl_Ed25519_PointAdd_point_add(out, out, tmp);
+  }
+  else if (d < (int8_t)0)
+  {
+    uint64_t p[20U] = { 0U };
+    memcpy(p,
+      table + (uint32_t)(-(int32_t)d >> 1) * (uint32_t)20U,
+      (uint32_t)20U * sizeof (uint64_t));
+    Hacl_Impl_Ed25519_PointNegate_point_negate(p, tmp);
+    Hacl_Impl_Ed25519_PointAdd_point_add(out, out, tmp);
+  }
+}
+
+/*
+  Variable-time double-scalar multiplication out = [scalar1]G + [scalar2]q2
+  (Straus-Shamir). scalar1 is recoded in width-7 NAF over the static table of
+  odd multiples of G; scalar2 is recoded in width-w2 NAF over table2, which
+  holds the 2^(w2-2) odd multiples of q2. All inputs must be public.
+*/
+static inline void
+point_mul_g_double_vartime_table(
+  uint64_t *out,
+  uint8_t *scalar1,
+  uint8_t *scalar2,
+  const uint64_t *table2,
+  uint32_t w2
+)
+{
+  int8_t naf1[257U] = { 0U };
+  int8_t naf2[257U] = { 0U };
+  uint32_t len1 = wnaf(naf1, scalar1, (uint32_t)7U);
+  uint32_t len2 = wnaf(naf2, scalar2, w2);
+  uint32_t len;
+  if (len1 < len2)
+  {
+    len = len2;
+  }
+  else
+  {
+    len = len1;
+  }
+  make_point_inf(out);
+  for (uint32_t i0 = (uint32_t)0U; i0 < len; i0++)
+  {
+    uint32_t i = len - i0 - (uint32_t)1U;
+    if (i0 > (uint32_t)0U)
+    {
+      point_double(out, out);
+    }
+    point_add_naf_digit(out, Hacl_Ed25519_PrecompTable_precomp_basepoint_odd_table_w7, naf1[i]);
+    point_add_naf_digit(out, table2, naf2[i]);
+  }
+}
+
+/*
+  Checks [s]G + [h](-A) = R, where s and R are read from the signature and
+  table_a holds the 2^(w-2) odd multiples of -A.
+*/
+static inline bool
+verify_table(
+  uint8_t *pub,
+  const uint64_t *table_a,
+  uint32_t w,
+  uint32_t len,
+  uint8_t *msg,
+  uint8_t *signature
+)
+{
+  uint64_t r_[20U] = { 0U };
+  bool b_ = Hacl_Impl_Ed25519_PointDecompress_point_decompress(r_, signature);
+  if (!b_)
+  {
+    return false;
+  }
+  uint64_t s1[5U] = { 0U };
+  load_32_bytes(s1, signature + (uint32_t)32U);
+  if (gte_q(s1))
+  {
+    return false;
+  }
+  uint64_t r_2[5U] = { 0U };
+  uint8_t tmp_[32U] = { 0U };
+  sha512_modq_pre_pre2(r_2, signature, pub, len, msg);
+  store_56(tmp_, r_2);
+  uint64_t exp_d[20U] = { 0U };
+  point_mul_g_double_vartime_table(exp_d, signature + (uint32_t)32U, tmp_, table_a, w);
+  return Hacl_Impl_Ed25519_PointEqual_point_equal(exp_d, r_);
+}
+
+/*
+  Variable-time multi-scalar multiplication (Straus' method, width-5 NAF):
+  out = [scalars[0]]points[0] + ... + [scalars[n - 1]]points[n - 1], where the
+  scalars are 32-byte little-endian integers and the points are extended points.
+  All inputs must be public, and n is at most 17.
+*/
+static inline void
+point_mul_multi_vartime(uint64_t *out, uint32_t n, uint8_t *scalars, uint64_t *points)
+{
+  uint64_t table[2720U] = { 0U };
+  int8_t naf[4369U] = { 0U };
+  uint32_t len = (uint32_t)0U;
+  for (uint32_t i = (uint32_t)0U; i < n; i++)
+  {
+    uint32_t leni =
+      wnaf(naf + i * (uint32_t)257U,
+        scalars + i * (uint32_t)32U,
+        (uint32_t)5U);
+    if (len < leni)
+    {
+      len = leni;
+    }
+    make_odd_table(table + i * (uint32_t)160U, points + i * (uint32_t)20U, (uint32_t)8U);
+  }
+  make_point_inf(out);
+  for (uint32_t k0 = (uint32_t)0U; k0 < len; k0++)
+  {
+    uint32_t k = len - k0 - (uint32_t)1U;
+    if (k0 > (uint32_t)0U)
+    {
+      point_double(out, out);
+    }
+    for (uint32_t i = (uint32_t)0U; i < n; i++)
+    {
+      point_add_naf_digit(out, table + i * (uint32_t)160U, naf[i * (uint32_t)257U + k]);
+    }
+  }
+}
+
 void Hacl_Ed25519_sign(uint8_t *signature, uint8_t *priv, uint32_t len, uint8_t *msg)
 {
   uint8_t ks[96U] = { 0U };
@@ -1669,57 +1980,225 @@ void Hacl_Ed25519_sign(uint8_t *signature, uint8_t *priv, uint32_t len, uint8_t
 
 bool Hacl_Ed25519_verify(uint8_t *pub, uint32_t len, uint8_t *msg, uint8_t *signature)
 {
-  uint64_t tmp[45U] = { 0U };
-  uint8_t tmp_[32U] = { 0U };
+  uint64_t tmp[40U] = { 0U };
+  uint64_t table[160U] = { 0U };
   uint64_t *a_ = tmp;
-  uint64_t *r_ = tmp + (uint32_t)20U;
+  uint64_t *a_neg = tmp + (uint32_t)20U;
   bool b = Hacl_Impl_Ed25519_PointDecompress_point_decompress(a_, pub);
-  bool res;
-  if (b)
+  if (!b)
+  {
+    return false;
+  }
+  Hacl_Impl_Ed25519_PointNegate_point_negate(a_, a_neg);
+  make_odd_table(table, a_neg, (uint32_t)8U);
+  return verify_table(pub, table, (uint32_t)5U, len, msg, signature);
+}
+
+/*
+Heap-allocate a verification context for the public key `pub` (32 bytes).
+
+  The key is decompressed once and the context caches the odd multiples
+  [1]A', [3]A', ..., [31]A' of A' = -A used by Hacl_Ed25519_verify_with_ctx.
+
+  The function returns NULL if `pub` is not a valid encoding of a point.
+  Otherwise, the caller will need to call Hacl_Ed25519_pub_ctx_free on the
+  return value to avoid memory leaks.
+*/
+Hacl_Ed25519_pub_ctx *Hacl_Ed25519_new_pub_ctx(uint8_t *pub)
+{
+  uint64_t tmp[40U] = { 0U };
+  uint64_t *a_ = tmp;
+  uint64_t *a_neg = tmp + (uint32_t)20U;
+  bool b = Hacl_Impl_Ed25519_PointDecompress_point_decompress(a_, pub);
+  if (!b)
+  {
+    return NULL;
+  }
+  Hacl_Impl_Ed25519_PointNegate_point_negate(a_, a_neg);
+  uint8_t *pub1 = KRML_HOST_CALLOC((uint32_t)32U, sizeof (uint8_t));
+  uint64_t *table = KRML_HOST_CALLOC((uint32_t)320U, sizeof (uint64_t));
+  memcpy(pub1, pub, (uint32_t)32U * sizeof (uint8_t));
+  make_odd_table(table, a_neg, (uint32_t)16U);
+  Hacl_Ed25519_pub_ctx res = { .pub = pub1, .table = table };
+  KRML_CHECK_SIZE(sizeof (Hacl_Ed25519_pub_ctx), (uint32_t)1U);
+  Hacl_Ed25519_pub_ctx *buf = KRML_HOST_MALLOC(sizeof (Hacl_Ed25519_pub_ctx));
+  buf[0U] = res;
+  return buf;
+}
+
+/*
+Deallocate the memory previously allocated by Hacl_Ed25519_new_pub_ctx.
+*/
+void Hacl_Ed25519_pub_ctx_free(Hacl_Ed25519_pub_ctx *k)
+{
+  Hacl_Ed25519_pub_ctx k1 = *k;
+  KRML_HOST_FREE(k1.pub);
+  KRML_HOST_FREE(k1.table);
+  KRML_HOST_FREE(k);
+}
+
+/*
+Verify the signature `signature` (64 bytes) of the message `msg` of `len`
+bytes against the public key held by the context `k`.
+
+  This is equivalent to Hacl_Ed25519_verify, but skips the decompression of
+  the public key and the computation of its multiples.
+*/
+bool
+Hacl_Ed25519_verify_with_ctx(
+  Hacl_Ed25519_pub_ctx *k,
+  uint32_t len,
+  uint8_t *msg,
+  uint8_t *signature
+)
+{
+  return verify_table(k->pub, k->table, (uint32_t)6U, len, msg, signature);
+}
+
+/*
+  Checks up to 8 signatures with a single multi-scalar multiplication, using the
+  cofactored equation [8]([sum z_i s_i]B - sum [z_i]R_i - sum [z_i h_i]A_i) = O.
+  The 128-bit coefficients z_i are derived by hashing the whole chunk
+  (signatures, public keys and per-signature challenges h_i).
+*/
+static bool
+verify_batch_chunk(
+  uint32_t n,
+  uint8_t **pub,
+  uint32_t *len,
+  uint8_t **msg,
+  uint8_t **signature
+)
+{
+  uint64_t points[340U] = { 0U };
+  uint8_t scalars[544U] = { 0U };
+  uint64_t s[40U] = { 0U };
+  uint64_t h[40U] = { 0U };
+  uint8_t buf[128U] = { 0U };
+  uint64_t block_state[8U] = { 0U };
+  Hacl_Streaming_SHA2_state_sha2_384
+  st0 = { .block_state = block_state, .buf = buf, .total_len = (uint64_t)0U };
+  Hacl_Streaming_SHA2_state_sha2_384 p = st0;
+  Hacl_Hash_Core_SHA2_init_512(block_state);
+  Hacl_Streaming_SHA2_state_sha2_384 *st = &p;
+  make_g(points);
+  for (uint32_t i = (uint32_t)0U; i < n; i++)
+  {
+    uint64_t *a_ = points + ((uint32_t)2U * i + (uint32_t)1U) * (uint32_t)20U;
+    uint64_t *r_ = points + ((uint32_t)2U * i + (uint32_t)2U) * (uint32_t)20U;
+    uint64_t *si = s + i * (uint32_t)5U;
+    uint64_t *hi = h + i * (uint32_t)5U;
+    if (!Hacl_Impl_Ed25519_PointDecompress_point_decompress(a_, pub[i]))
+    {
+      return false;
+    }
+    if (!Hacl_Impl_Ed25519_PointDecompress_point_decompress(r_, signature[i]))
+    {
+      return false;
+    }
+    load_32_bytes(si, signature[i] + (uint32_t)32U);
+    if (gte_q(si))
+    {
+      return false;
+    }
+    uint8_t hb[32U] = { 0U };
+    sha512_modq_pre_pre2(hi, signature[i], pub[i], len[i], msg[i]);
+    store_56(hb, hi);
+    Hacl_Streaming_SHA2_update_512(st, signature[i], (uint32_t)64U);
+    Hacl_Streaming_SHA2_update_512(st, pub[i], (uint32_t)32U);
+    Hacl_Streaming_SHA2_update_512(st, hb, (uint32_t)32U);
+  }
+  uint8_t seed[68U] = { 0U };
+  Hacl_Streaming_SHA2_finish_512(st, seed);
+  uint64_t sb[5U] = { 0U };
+  for (uint32_t i = (uint32_t)0U; i < n; i++)
+  {
+    uint64_t *a_ = points + ((uint32_t)2U * i + (uint32_t)1U) * (uint32_t)20U;
+    uint64_t *r_ = points + ((uint32_t)2U * i + (uint32_t)2U) * (uint32_t)20U;
+    uint8_t *ha_bytes = scalars + ((uint32_t)2U * i + (uint32_t)1U) * (uint32_t)32U;
+    uint8_t *z_bytes = scalars + ((uint32_t)2U * i + (uint32_t)2U) * (uint32_t)32U;
+    uint8_t zh[64U] = { 0U };
+    uint64_t z[5U] = { 0U };
+    uint64_t tmp[5U] = { 0U };
+    uint64_t p_neg[20U] = { 0U };
+    store32_le(seed + (uint32_t)64U, i);
+    Hacl_Hash_SHA2_hash_512(seed, (uint32_t)68U, zh);
+    memcpy(z_bytes, zh, (uint32_t)16U * sizeof (uint8_t));
+    load_32_bytes(z, z_bytes);
+    mul_modq(tmp, z, s + i * (uint32_t)5U);
+    add_modq(sb, sb, tmp);
+    mul_modq(tmp, z, h + i * (uint32_t)5U);
+    store_56(ha_bytes, tmp);
+    Hacl_Impl_Ed25519_PointNegate_point_negate(a_, p_neg);
+    memcpy(a_, p_neg, (uint32_t)20U * sizeof (uint64_t));
+    Hacl_Impl_Ed25519_PointNegate_point_negate(r_, p_neg);
+    memcpy(r_, p_neg, (uint32_t)20U * sizeof (uint64_t));
+  }
+  store_56(scalars, sb);
+  uint64_t res[20U] = { 0U };
+  point_mul_multi_vartime(res, (uint32_t)2U * n + (uint32_t)1U, scalars, points);
+  point_double(res, res);
+  point_double(res, res);
+  point_double(res, res);
+  return point_is_inf(res);
+}
+
+/*
+Verify `n` signatures at once with the cofactored equation.
+
+  The i-th signature signature[i] (64 bytes) is checked against the public key
+  pub[i] (32 bytes) and the message msg[i] of len[i] bytes.
+
+  Signatures are checked in chunks of 8 with a single multi-scalar multiplication
+  over a random linear combination of the cofactored verification equations
+  [8][s]B = [8]R + [8][h]A. When a chunk does not pass, each of its signatures is
+  checked individually with Hacl_Ed25519_verify. On return, res[i] holds the
+  validity of the i-th signature and the function returns true iff all
+  signatures are valid.
+
+  Note: the semantics differ from Hacl_Ed25519_verify, which is cofactorless. A
+  chunk that passes the combined check is accepted as a whole, including
+  signatures whose equation is only off by a small-order point, which
+  Hacl_Ed25519_verify rejects. An honest signer never produces those; use
+  Hacl_Ed25519_verify when the exact cofactorless result matters.
+*/
+bool
+Hacl_Ed25519_verify_batch_cofactored(
+  uint32_t n,
+  uint8_t **pub,
+  uint32_t *len,
+  uint8_t **msg,
+  uint8_t **signature,
+  bool *res
+)
+{
+  bool ok = true;
+  for (uint32_t i0 = (uint32_t)0U; i0 < n; i0 = i0 + (uint32_t)8U)
   {
-    uint8_t *rs = signature;
-    bool b_ = Hacl_Impl_Ed25519_PointDecompress_point_decompress(r_, rs);
-    if (b_)
+    uint32_t k;
+    if (n - i0 < (uint32_t)8U)
+    {
+      k = n - i0;
+    }
+    else
+    {
+      k = (uint32_t)8U;
+    }
+    bool b = verify_batch_chunk(k, pub + i0, len + i0, msg + i0, signature + i0);
+    for (uint32_t i = i0; i < i0 + k; i++)
     {
-      uint8_t *rs1 = signature;
-      uint64_t *a_1 = tmp;
-      uint64_t *r_1 = tmp + (uint32_t)20U;
-      uint64_t *s1 = tmp + (uint32_t)40U;
-      load_32_bytes(s1, signature + (uint32_t)32U);
-      bool b__ = gte_q(s1);
-      if (b__)
+      if (b)
       {
-        res = false;
+        res[i] = true;
       }
       else
       {
-        uint64_t r_2[5U] = { 0U };
-        sha512_modq_pre_pre2(r_2, rs1, pub, len, msg);
-        store_56(tmp_, r_2);
-        uint8_t *uu____0 = signature + (uint32_t)32U;
-        uint64_t tmp1[60U] = { 0U };
-        uint64_t *hA = tmp1;
-        uint64_t *rhA = tmp1 + (uint32_t)20U;
-        uint64_t *sB = tmp1 + (uint32_t)40U;
-        point_mul_g(sB, uu____0);
-        Hacl_Impl_Ed25519_Ladder_point_mul(hA, tmp_, a_1);
-        Hacl_Impl_Ed25519_PointAdd_point_add(rhA, r_1, hA);
-        bool b1 = Hacl_Impl_Ed25519_PointEqual_point_equal(sB, rhA);
-        bool b10 = b1;
-        res = b10;
+        res[i] = Hacl_Ed25519_verify(pub[i], len[i], msg[i], signature[i]);
       }
-    }
-    else
-    {
-      res = false;
+      ok = ok && res[i];
     }
   }
-  else
-  {
-    res = false;
-  }
-  bool res0 = res;
-  return res0;
+  return ok;
 }
 
 void Hacl_Ed25519_secret_to_public(uint8_t *pub, uint8_t *priv)
@@ -67,6 +67,74 @@ void Hacl_Ed25519_sign(uint8_t *signature, uint8_t *priv, uint32_t len, uint8_t
 
 bool Hacl_Ed25519_verify(uint8_t *pub, uint32_t len, uint8_t *msg, uint8_t *signature);
 
+typedef struct Hacl_Ed25519_pub_ctx_s
+{
+  uint8_t *pub;
+  uint64_t *table;
+}
+Hacl_Ed25519_pub_ctx;
+
+/*
+Heap-allocate a verification context for the public key `pub` (32 bytes).
+
+  The key is decompressed once and the context caches the odd multiples
+  [1]A', [3]A', ..., [31]A' of A' = -A used by Hacl_Ed25519_verify_with_ctx.
+
+  The function returns NULL if `pub` is not a valid encoding of a point.
+  Otherwise, the caller will need to call Hacl_Ed25519_pub_ctx_free on the
+  return value to avoid memory leaks.
+*/
+Hacl_Ed25519_pub_ctx *Hacl_Ed25519_new_pub_ctx(uint8_t *pub);
+
+/*
+Deallocate the memory previously allocated by Hacl_Ed25519_new_pub_ctx.
+*/
+void Hacl_Ed25519_pub_ctx_free(Hacl_Ed25519_pub_ctx *k);
+
+/*
+Verify the signature `signature` (64 bytes) of the message `msg` of `len`
+bytes against the public key held by the context `k`.
+
+  This is equivalent to Hacl_Ed25519_verify, but skips the decompression of
+  the public key and the computation of its multiples.
+*/
+bool
+Hacl_Ed25519_verify_with_ctx(
+  Hacl_Ed25519_pub_ctx *k,
+  uint32_t len,
+  uint8_t *msg,
+  uint8_t *signature
+);
+
+/*
+Verify `n` signatures at once with the cofactored equation.
+
+  The i-th signature signature[i] (64 bytes) is checked against the public key
+  pub[i] (32 bytes) and the message msg[i] of len[i] bytes.
+
+  Signatures are checked in chunks of 8 with a single multi-scalar multiplication
+  over a random linear combination of the cofactored verification equations
+  [8][s]B = [8]R + [8][h]A. When a chunk does not pass, each of its signatures is
+  checked individually with Hacl_Ed25519_verify. On return, res[i] holds the
+  validity of the i-th signature and the function returns true iff all
+  signatures are valid.
+
+  Note: the semantics differ from Hacl_Ed25519_verify, which is cofactorless. A
+  chunk that passes the combined check is accepted as a whole, including
+  signatures whose equation is only off by a small-order point, which
+  Hacl_Ed25519_verify rejects. An honest signer never produces those; use
+  Hacl_Ed25519_verify when the exact cofactorless result matters.
+*/
+bool
+Hacl_Ed25519_verify_batch_cofactored(
+  uint32_t n,
+  uint8_t **pub,
+  uint32_t *len,
+  uint8_t **msg,
+  uint8_t **signature,
+  bool *res
+);
+
 void Hacl_Ed25519_secret_to_public(uint8_t *pub, uint8_t *priv);
 
 void Hacl_Ed25519_expand_keys(uint8_t *ks, uint8_t *priv);
@@ -212,6 +212,144 @@ ffdhe_compute_exp(
   Hacl_Bignum_Convert_bn_to_bytes_be_uint64(ffdhe_len(a), res_n, res);
 }
 
+static inline void
+ffdhe_amont_mul(uint32_t len, uint64_t *n, uint64_t mu, uint64_t *aM, uint64_t *bM, uint64_t *resM)
+{
+  #if HACL_CAN_COMPILE_INLINE_ASM
+  if (Hacl_Bignum_Montgomery_has_adx_bmi2())
+  {
+    Hacl_Bignum_Montgomery_bn_almost_mont_mul_adx_u64(len, n, mu, aM, bM, resM);
+    return;
+  }
+  #endif
+  Hacl_Bignum_Montgomery_bn_mont_mul_u64(len, n, mu, aM, bM, resM);
+}
+
+static inline void
+ffdhe_amont_sqr(uint32_t len, uint64_t *n, uint64_t mu, uint64_t *aM, uint64_t *resM)
+{
+  #if HACL_CAN_COMPILE_INLINE_ASM
+  if (Hacl_Bignum_Montgomery_has_adx_bmi2())
+  {
+    Hacl_Bignum_Montgomery_bn_almost_mont_sqr_adx_u64(len, n, mu, aM, resM);
+    return;
+  }
+  #endif
+  Hacl_Bignum_Montgomery_bn_mont_sqr_u64(len, n, mu, aM, resM);
+}
+
+/*
+  Fixed-base comb for g = 2 with 6 teeth: the exponent is split into six
+  rows of d = ceil(64 * nLen / 6) bits, and table[v] = prod (g ^ (2 ^ (i * d)))
+  over the bits i set in v, in Montgomery form (64 entries of nLen limbs).
+*/
+static inline uint32_t ffdhe_comb_d(uint32_t nLen)
+{
+  return ((uint32_t)64U * nLen - (uint32_t)1U) / (uint32_t)6U + (uint32_t)1U;
+}
+
+static inline void ffdhe_precomp_g(Spec_FFDHE_ffdhe_alg a, uint64_t *p_r2_n, uint64_t *table)
+{
+  uint32_t nLen = (ffdhe_len(a) - (uint32_t)1U) / (uint32_t)8U + (uint32_t)1U;
+  uint64_t *p_n = p_r2_n;
+  uint64_t *r2_n = p_r2_n + nLen;
+  uint64_t mu = Hacl_Bignum_ModInvLimb_mod_inv_uint64(p_n[0U]);
+  uint32_t d = ffdhe_comb_d(nLen);
+  KRML_CHECK_SIZE(sizeof (uint64_t), nLen);
+  uint64_t g_n[nLen];
+  memset(g_n, 0U, nLen * sizeof (uint64_t));
+  uint8_t g = (uint8_t)0U;
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)1U; i++)
+  {
+    uint8_t *os = &g;
+    uint8_t x = Hacl_Impl_FFDHE_Constants_ffdhe_g2[i];
+    os[i] = x;
+  }
+  Hacl_Bignum_Convert_bn_from_bytes_be_uint64((uint32_t)1U, &g, g_n);
+  KRML_CHECK_SIZE(sizeof (uint64_t), nLen);
+  uint64_t gM[nLen];
+  memset(gM, 0U, nLen * sizeof (uint64_t));
+  Hacl_Bignum_Montgomery_bn_to_mont_u64(nLen, p_n, mu, r2_n, g_n, gM);
+  Hacl_Bignum_Montgomery_bn_from_mont_u64(nLen, p_n, mu, r2_n, table);
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)6U; i++)
+  {
+    uint32_t k = (uint32_t)1U << i;
+    memcpy(table + k * nLen, gM, nLen * sizeof (uint64_t));
+    for (uint32_t j = (uint32_t)1U; j < k; j++)
+    {
+      uint64_t *t_j = table + j * nLen;
+      uint64_t *t_kj = table + (k + j) * nLen;
+      Hacl_Bignum_Montgomery_bn_mont_mul_u64(nLen, p_n, mu, t_j, gM, t_kj);
+    }
+    if (i < (uint32_t)5U)
+    {
+      for (uint32_t i0 = (uint32_t)0U; i0 < d; i0++)
+      {
+        Hacl_Bignum_Montgomery_bn_mont_sqr_u64(nLen, p_n, mu, gM, gM);
+      }
+    }
+  }
+}
+
+static inline void
+ffdhe_compute_exp_g(
+  Spec_FFDHE_ffdhe_alg a,
+  uint64_t *p_r2_n,
+  uint64_t *table,
+  uint64_t *sk_n,
+  uint8_t *res
+)
+{
+  uint32_t nLen = (ffdhe_len(a) - (uint32_t)1U) / (uint32_t)8U + (uint32_t)1U;
+  uint64_t *p_n = p_r2_n;
+  uint64_t mu = Hacl_Bignum_ModInvLimb_mod_inv_uint64(p_n[0U]);
+  uint32_t bBits = (uint32_t)64U * nLen;
+  uint32_t d = ffdhe_comb_d(nLen);
+  KRML_CHECK_SIZE(sizeof (uint64_t), nLen);
+  uint64_t accM[nLen];
+  memset(accM, 0U, nLen * sizeof (uint64_t));
+  KRML_CHECK_SIZE(sizeof (uint64_t), nLen);
+  uint64_t tmp[nLen];
+  memset(tmp, 0U, nLen * sizeof (uint64_t));
+  KRML_CHECK_SIZE(sizeof (uint64_t), nLen);
+  uint64_t res_n[nLen];
+  memset(res_n, 0U, nLen * sizeof (uint64_t));
+  memcpy(accM, table, nLen * sizeof (uint64_t));
+  for (uint32_t i0 = (uint32_t)0U; i0 < d; i0++)
+  {
+    uint32_t col = d - i0 - (uint32_t)1U;
+    uint64_t bits = (uint64_t)0U;
+    for (uint32_t i = (uint32_t)0U; i < (uint32_t)6U; i++)
+    {
+      uint32_t k = i * d + col;
+      if (k < bBits)
+      {
+        uint64_t bit = sk_n[k / (uint32_t)64U] >> k % (uint32_t)64U & (uint64_t)1U;
+        bits = bits | bit << i;
+      }
+    }
+    if (i0 > (uint32_t)0U)
+    {
+      ffdhe_amont_sqr(nLen, p_n, mu, accM, accM);
+    }
+    memcpy(tmp, table, nLen * sizeof (uint64_t));
+    for (uint32_t i1 = (uint32_t)0U; i1 < (uint32_t)63U; i1++)
+    {
+      uint64_t c = FStar_UInt64_eq_mask(bits, (uint64_t)(i1 + (uint32_t)1U));
+      uint64_t *res_j = table + (i1 + (uint32_t)1U) * nLen;
+      for (uint32_t i = (uint32_t)0U; i < nLen; i++)
+      {
+        uint64_t *os = tmp;
+        uint64_t x = (c & res_j[i]) | (~c & tmp[i]);
+        os[i] = x;
+      }
+    }
+    ffdhe_amont_mul(nLen, p_n, mu, accM, tmp, accM);
+  }
+  Hacl_Bignum_Montgomery_bn_from_mont_u64(nLen, p_n, mu, accM, res_n);
+  Hacl_Bignum_Convert_bn_to_bytes_be_uint64(ffdhe_len(a), res_n, res);
+}
+
 uint32_t Hacl_FFDHE_ffdhe_len(Spec_FFDHE_ffdhe_alg a)
 {
   return ffdhe_len(a);
@@ -232,6 +370,22 @@ uint64_t *Hacl_FFDHE_new_ffdhe_precomp_p(Spec_FFDHE_ffdhe_alg a)
   return res2;
 }
 
+uint64_t *Hacl_FFDHE_new_ffdhe_precomp_p_g(Spec_FFDHE_ffdhe_alg a)
+{
+  uint32_t nLen = (ffdhe_len(a) - (uint32_t)1U) / (uint32_t)8U + (uint32_t)1U;
+  KRML_CHECK_SIZE(sizeof (uint64_t), nLen + nLen + (uint32_t)64U * nLen);
+  uint64_t *res = KRML_HOST_CALLOC(nLen + nLen + (uint32_t)64U * nLen, sizeof (uint64_t));
+  if (res == NULL)
+  {
+    return res;
+  }
+  uint64_t *res1 = res;
+  uint64_t *res2 = res1;
+  ffdhe_precomp_p(a, res2);
+  ffdhe_precomp_g(a, res2, res2 + nLen + nLen);
+  return res2;
+}
+
 void
 Hacl_FFDHE_ffdhe_secret_to_public_precomp(
   Spec_FFDHE_ffdhe_alg a,
@@ -260,6 +414,23 @@ Hacl_FFDHE_ffdhe_secret_to_public_precomp(
   ffdhe_compute_exp(a, p_r2_n, sk_n, g_n, pk);
 }
 
+void
+Hacl_FFDHE_ffdhe_secret_to_public_precomp_g(
+  Spec_FFDHE_ffdhe_alg a,
+  uint64_t *p_r2_g,
+  uint8_t *sk,
+  uint8_t *pk
+)
+{
+  uint32_t len = ffdhe_len(a);
+  uint32_t nLen = (len - (uint32_t)1U) / (uint32_t)8U + (uint32_t)1U;
+  KRML_CHECK_SIZE(sizeof (uint64_t), nLen);
+  uint64_t sk_n[nLen];
+  memset(sk_n, 0U, nLen * sizeof (uint64_t));
+  Hacl_Bignum_Convert_bn_from_bytes_be_uint64(len, sk, sk_n);
+  ffdhe_compute_exp_g(a, p_r2_g, p_r2_g + nLen + nLen, sk_n, pk);
+}
+
 void Hacl_FFDHE_ffdhe_secret_to_public(Spec_FFDHE_ffdhe_alg a, uint8_t *sk, uint8_t *pk)
 {
   uint32_t len = ffdhe_len(a);
@@ -46,6 +46,8 @@ uint32_t Hacl_FFDHE_ffdhe_len(Spec_FFDHE_ffdhe_alg a);
 
 uint64_t *Hacl_FFDHE_new_ffdhe_precomp_p(Spec_FFDHE_ffdhe_alg a);
 
+uint64_t *Hacl_FFDHE_new_ffdhe_precomp_p_g(Spec_FFDHE_ffdhe_alg a);
+
 void
 Hacl_FFDHE_ffdhe_secret_to_public_precomp(
   Spec_FFDHE_ffdhe_alg a,
@@ -54,6 +56,14 @@ Hacl_FFDHE_ffdhe_secret_to_public_precomp(
   uint8_t *pk
 );
 
+void
+Hacl_FFDHE_ffdhe_secret_to_public_precomp_g(
+  Spec_FFDHE_ffdhe_alg a,
+  uint64_t *p_r2_g,
+  uint8_t *sk,
+  uint8_t *pk
+);
+
 void Hacl_FFDHE_ffdhe_secret_to_public(Spec_FFDHE_ffdhe_alg a, uint8_t *sk, uint8_t *pk);
 
 uint64_t
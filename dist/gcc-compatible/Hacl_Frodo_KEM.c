@@ -24,8 +24,46 @@
 
 #include "Hacl_Frodo_KEM.h"
 
+#include "Hacl_SHA3_Vec256.h"
+#include "EverCrypt_AutoConfig2.h"
+
 void randombytes_(uint32_t len, uint8_t *res)
 {
   bool b = Lib_RandomBuffer_System_randombytes(res, len);
 }
 
+void
+Hacl_Keccak_shake128_4x(
+  uint32_t input_len,
+  uint8_t *input0,
+  uint8_t *input1,
+  uint8_t *input2,
+  uint8_t *input3,
+  uint32_t output_len,
+  uint8_t *output0,
+  uint8_t *output1,
+  uint8_t *output2,
+  uint8_t *output3
+)
+{
+  #if HACL_CAN_COMPILE_VEC256
+  if (EverCrypt_AutoConfig2_has_vec256())
+  {
+    Hacl_SHA3_Vec256_shake128_vec256(input_len,
+      input0,
+      input1,
+      input2,
+      input3,
+      output_len,
+      output0,
+      output1,
+      output2,
+      output3);
+    return;
+  }
+  #endif
+  Hacl_SHA3_shake128_hacl(input_len, input0, output_len, output0);
+  Hacl_SHA3_shake128_hacl(input_len, input1, output_len, output1);
+  Hacl_SHA3_shake128_hacl(input_len, input2, output_len, output2);
+  Hacl_SHA3_shake128_hacl(input_len, input3, output_len, output3);
+}
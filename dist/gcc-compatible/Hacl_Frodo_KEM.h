@@ -42,7 +42,7 @@ extern "C" {
 #include "Hacl_Spec.h"
 #include "Hacl_SHA3.h"
 
-static inline void
+void
 Hacl_Keccak_shake128_4x(
   uint32_t input_len,
   uint8_t *input0,
@@ -54,13 +54,7 @@ Hacl_Keccak_shake128_4x(
   uint8_t *output1,
   uint8_t *output2,
   uint8_t *output3
-)
-{
-  Hacl_SHA3_shake128_hacl(input_len, input0, output_len, output0);
-  Hacl_SHA3_shake128_hacl(input_len, input1, output_len, output1);
-  Hacl_SHA3_shake128_hacl(input_len, input2, output_len, output2);
-  Hacl_SHA3_shake128_hacl(input_len, input3, output_len, output3);
-}
+);
 
 static inline void
 Hacl_Impl_Matrix_mod_pow2(uint32_t n1, uint32_t n2, uint32_t logq, uint16_t *a)
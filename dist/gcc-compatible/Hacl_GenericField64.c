@@ -598,3 +598,393 @@ Hacl_GenericField64_inverse(
   Hacl_GenericField64_exp_vartime(k, aM, k1.len * (uint32_t)64U, n2, aInvM);
 }
 
+/*
+Write `aM[i] ^ (-1) mod n` in `aInvM[i]` for every 0 <= i < nElems.
+
+  The argument aM and the outparam aInvM are meant to be `nElems * len` limbs in size,
+  i.e. uint64_t[nElems * len], and hold the elements one after the other.
+  The argument k is a montgomery context obtained through Hacl_GenericField64_field_init.
+
+  This function uses Montgomery's trick: a single call to inverse on the product of
+  all elements, plus 3 * (nElems - 1) multiplications. The prefix products are kept
+  in aInvM, so no scratch space proportional to nElems is needed.
+
+  Before calling this function, the caller will need to ensure that the following
+  preconditions are observed.
+  • n is a prime
+  • 0 < aM[i] for every element aM[i]
+  • aM and aInvM are disjoint
+*/
+void
+Hacl_GenericField64_inverse_batch(
+  Hacl_Bignum_MontArithmetic_bn_mont_ctx_u64 *k,
+  uint32_t nElems,
+  uint64_t *aM,
+  uint64_t *aInvM
+)
+{
+  if (nElems == (uint32_t)0U)
+  {
+    return;
+  }
+  Hacl_Bignum_MontArithmetic_bn_mont_ctx_u64 k1 = *k;
+  uint32_t len1 = k1.len;
+  memcpy(aInvM, aM, len1 * sizeof (uint64_t));
+  for (uint32_t i = (uint32_t)1U; i < nElems; i++)
+  {
+    uint64_t *c_prev = aInvM + (i - (uint32_t)1U) * len1;
+    uint64_t *c_i = aInvM + i * len1;
+    Hacl_Bignum_Montgomery_bn_mont_mul_u64(len1, k1.n, k1.mu, c_prev, aM + i * len1, c_i);
+  }
+  KRML_CHECK_SIZE(sizeof (uint64_t), len1);
+  uint64_t inv[len1];
+  memset(inv, 0U, len1 * sizeof (uint64_t));
+  Hacl_GenericField64_inverse(k, aInvM + (nElems - (uint32_t)1U) * len1, inv);
+  for (uint32_t i0 = (uint32_t)0U; i0 < nElems - (uint32_t)1U; i0++)
+  {
+    uint32_t i = nElems - i0 - (uint32_t)1U;
+    uint64_t *c_prev = aInvM + (i - (uint32_t)1U) * len1;
+    uint64_t *res_i = aInvM + i * len1;
+    Hacl_Bignum_Montgomery_bn_mont_mul_u64(len1, k1.n, k1.mu, inv, c_prev, res_i);
+    Hacl_Bignum_Montgomery_bn_mont_mul_u64(len1, k1.n, k1.mu, inv, aM + i * len1, inv);
+  }
+  memcpy(aInvM, inv, len1 * sizeof (uint64_t));
+}
+
+static inline uint64_t get_bits_l(uint32_t bLen, uint64_t *b, uint32_t i, uint32_t l)
+{
+  uint64_t mask_l = ((uint64_t)1U << l) - (uint64_t)1U;
+  uint32_t i1 = i / (uint32_t)64U;
+  uint32_t j = i % (uint32_t)64U;
+  uint64_t p1 = b[i1] >> j;
+  uint64_t ite;
+  if (i1 + (uint32_t)1U < bLen && (uint32_t)0U < j)
+  {
+    ite = p1 | b[i1 + (uint32_t)1U] << ((uint32_t)64U - j);
+  }
+  else
+  {
+    ite = p1;
+  }
+  return ite & mask_l;
+}
+
+static inline void
+precomp_tables(
+  Hacl_Bignum_MontArithmetic_bn_mont_ctx_u64 k1,
+  uint32_t nBases,
+  uint64_t *aM,
+  uint64_t *oneM,
+  uint64_t *table
+)
+{
+  uint32_t len1 = k1.len;
+  for (uint32_t i0 = (uint32_t)0U; i0 < nBases; i0++)
+  {
+    uint64_t *table_i = table + i0 * (uint32_t)16U * len1;
+    uint64_t *a_i = aM + i0 * len1;
+    memcpy(table_i, oneM, len1 * sizeof (uint64_t));
+    uint64_t *t1 = table_i + len1;
+    memcpy(t1, a_i, len1 * sizeof (uint64_t));
+    for (uint32_t i = (uint32_t)0U; i < (uint32_t)14U; i++)
+    {
+      uint64_t *t11 = table_i + (i + (uint32_t)1U) * len1;
+      uint64_t *t2 = table_i + (i + (uint32_t)2U) * len1;
+      Hacl_Bignum_Montgomery_bn_mont_mul_u64(len1, k1.n, k1.mu, t11, a_i, t2);
+    }
+  }
+}
+
+static inline void
+multi_exp_vartime_chunk(
+  Hacl_Bignum_MontArithmetic_bn_mont_ctx_u64 k1,
+  uint32_t nBases,
+  uint64_t *aM,
+  uint32_t bBits,
+  uint32_t bLen,
+  uint64_t *b,
+  uint64_t *table,
+  uint64_t *resM
+)
+{
+  uint32_t len1 = k1.len;
+  Hacl_Bignum_Montgomery_bn_from_mont_u64(len1, k1.n, k1.mu, k1.r2, resM);
+  precomp_tables(k1, nBases, aM, resM, table);
+  for (uint32_t i0 = (uint32_t)0U; i0 < bBits / (uint32_t)4U; i0++)
+  {
+    for (uint32_t i = (uint32_t)0U; i < (uint32_t)4U; i++)
+    {
+      Hacl_Bignum_Montgomery_bn_mont_sqr_u64(len1, k1.n, k1.mu, resM, resM);
+    }
+    for (uint32_t i = (uint32_t)0U; i < nBases; i++)
+    {
+      uint64_t
+      bits_l =
+        get_bits_l(bLen,
+          b + i * bLen,
+          bBits - (uint32_t)4U * i0 - (uint32_t)4U,
+          (uint32_t)4U);
+      if (!(bits_l == (uint64_t)0U))
+      {
+        uint32_t bits_l32 = (uint32_t)bits_l;
+        uint64_t *a_bits_l = table + (i * (uint32_t)16U + bits_l32) * len1;
+        Hacl_Bignum_Montgomery_bn_mont_mul_u64(len1, k1.n, k1.mu, resM, a_bits_l, resM);
+      }
+    }
+  }
+  if (!(bBits % (uint32_t)4U == (uint32_t)0U))
+  {
+    uint32_t c = bBits % (uint32_t)4U;
+    for (uint32_t i = (uint32_t)0U; i < c; i++)
+    {
+      Hacl_Bignum_Montgomery_bn_mont_sqr_u64(len1, k1.n, k1.mu, resM, resM);
+    }
+    for (uint32_t i = (uint32_t)0U; i < nBases; i++)
+    {
+      uint64_t bits_c = get_bits_l(bLen, b + i * bLen, (uint32_t)0U, c);
+      if (!(bits_c == (uint64_t)0U))
+      {
+        uint32_t bits_c32 = (uint32_t)bits_c;
+        uint64_t *a_bits_c = table + (i * (uint32_t)16U + bits_c32) * len1;
+        Hacl_Bignum_Montgomery_bn_mont_mul_u64(len1, k1.n, k1.mu, resM, a_bits_c, resM);
+      }
+    }
+  }
+}
+
+/*
+Write `aM[0] ^ b[0] * aM[1] ^ b[1] * ... * aM[nBases - 1] ^ b[nBases - 1] mod n` in `resM`.
+
+  The argument aM is meant to be `nBases * len` limbs in size, i.e. uint64_t[nBases * len],
+  and holds the bases one after the other. The outparam resM is `len` limbs in size.
+  The argument k is a montgomery context obtained through Hacl_GenericField64_field_init.
+
+  The argument b holds the exponents one after the other, each of them
+  bLen = (bBits - 1) / 64 + 1 limbs in size, i.e. uint64_t[nBases * bLen], and bBits is an
+  upper bound on the number of significant bits of every exponent.
+
+  Bases are processed in groups of at most 8. Within a group, all bases share a
+  single chain of squarings, interleaved with one multiplication per base and
+  4-bit window, and the results of the groups are multiplied together. The window
+  tables take at most 128 * len limbs of stack, whatever nBases is.
+
+  The function is *NOT* constant-time on the argument b. See the
+  multi_exp_consttime function for constant-time variant.
+
+  Before calling this function, the caller will need to ensure that the following
+  preconditions are observed.
+  • b[i] < pow2 bBits for every exponent b[i]
+*/
+void
+Hacl_GenericField64_multi_exp_vartime(
+  Hacl_Bignum_MontArithmetic_bn_mont_ctx_u64 *k,
+  uint32_t nBases,
+  uint64_t *aM,
+  uint32_t bBits,
+  uint64_t *b,
+  uint64_t *resM
+)
+{
+  Hacl_Bignum_MontArithmetic_bn_mont_ctx_u64 k1 = *k;
+  uint32_t len1 = k1.len;
+  uint32_t bLen;
+  if (bBits == (uint32_t)0U)
+  {
+    bLen = (uint32_t)1U;
+  }
+  else
+  {
+    bLen = (bBits - (uint32_t)1U) / (uint32_t)64U + (uint32_t)1U;
+  }
+  if (nBases == (uint32_t)0U)
+  {
+    Hacl_Bignum_Montgomery_bn_from_mont_u64(len1, k1.n, k1.mu, k1.r2, resM);
+    return;
+  }
+  uint32_t nChunk;
+  if (nBases < (uint32_t)8U)
+  {
+    nChunk = nBases;
+  }
+  else
+  {
+    nChunk = (uint32_t)8U;
+  }
+  if (len1 > (uint32_t)0xffffffffU / (uint32_t)128U)
+  {
+    KRML_HOST_EPRINTF("Maximum allocatable size exceeded, aborting before overflow at %s:%d\n",
+      __FILE__,
+      __LINE__);
+    KRML_HOST_EXIT(253U);
+  }
+  KRML_CHECK_SIZE(sizeof (uint64_t), nChunk * (uint32_t)16U * len1);
+  uint64_t table[nChunk * (uint32_t)16U * len1];
+  memset(table, 0U, nChunk * (uint32_t)16U * len1 * sizeof (uint64_t));
+  KRML_CHECK_SIZE(sizeof (uint64_t), len1);
+  uint64_t tmp[len1];
+  memset(tmp, 0U, len1 * sizeof (uint64_t));
+  multi_exp_vartime_chunk(k1, nChunk, aM, bBits, bLen, b, table, resM);
+  for (uint32_t i = nChunk; i < nBases; i = i + nChunk)
+  {
+    uint32_t n1;
+    if (nBases - i < nChunk)
+    {
+      n1 = nBases - i;
+    }
+    else
+    {
+      n1 = nChunk;
+    }
+    multi_exp_vartime_chunk(k1, n1, aM + i * len1, bBits, bLen, b + i * bLen, table, tmp);
+    Hacl_Bignum_Montgomery_bn_mont_mul_u64(len1, k1.n, k1.mu, resM, tmp, resM);
+  }
+}
+
+static inline void
+multi_exp_consttime_chunk(
+  Hacl_Bignum_MontArithmetic_bn_mont_ctx_u64 k1,
+  uint32_t nBases,
+  uint64_t *aM,
+  uint32_t bBits,
+  uint32_t bLen,
+  uint64_t *b,
+  uint64_t *table,
+  uint64_t *resM
+)
+{
+  uint32_t len1 = k1.len;
+  Hacl_Bignum_Montgomery_bn_from_mont_u64(len1, k1.n, k1.mu, k1.r2, resM);
+  precomp_tables(k1, nBases, aM, resM, table);
+  KRML_CHECK_SIZE(sizeof (uint64_t), len1);
+  uint64_t a_bits[len1];
+  memset(a_bits, 0U, len1 * sizeof (uint64_t));
+  uint32_t c = bBits % (uint32_t)4U;
+  for (uint32_t i0 = (uint32_t)0U; i0 < bBits / (uint32_t)4U + (uint32_t)1U; i0++)
+  {
+    uint32_t l;
+    uint32_t pos;
+    if (i0 < bBits / (uint32_t)4U)
+    {
+      l = (uint32_t)4U;
+      pos = bBits - (uint32_t)4U * i0 - (uint32_t)4U;
+    }
+    else
+    {
+      l = c;
+      pos = (uint32_t)0U;
+    }
+    if (!(l == (uint32_t)0U))
+    {
+      for (uint32_t i = (uint32_t)0U; i < l; i++)
+      {
+        Hacl_Bignum_Montgomery_bn_mont_sqr_u64(len1, k1.n, k1.mu, resM, resM);
+      }
+      for (uint32_t i = (uint32_t)0U; i < nBases; i++)
+      {
+        uint64_t bits_l = get_bits_l(bLen, b + i * bLen, pos, l);
+        uint64_t *table_i = table + i * (uint32_t)16U * len1;
+        memcpy(a_bits, table_i, len1 * sizeof (uint64_t));
+        for (uint32_t i2 = (uint32_t)0U; i2 < (uint32_t)15U; i2++)
+        {
+          uint64_t c1 = FStar_UInt64_eq_mask(bits_l, (uint64_t)(i2 + (uint32_t)1U));
+          uint64_t *res_j = table_i + (i2 + (uint32_t)1U) * len1;
+          for (uint32_t i1 = (uint32_t)0U; i1 < len1; i1++)
+          {
+            uint64_t *os = a_bits;
+            uint64_t x = (c1 & res_j[i1]) | (~c1 & a_bits[i1]);
+            os[i1] = x;
+          }
+        }
+        Hacl_Bignum_Montgomery_bn_mont_mul_u64(len1, k1.n, k1.mu, resM, a_bits, resM);
+      }
+    }
+  }
+}
+
+/*
+Write `aM[0] ^ b[0] * aM[1] ^ b[1] * ... * aM[nBases - 1] ^ b[nBases - 1] mod n` in `resM`.
+
+  The argument aM is meant to be `nBases * len` limbs in size, i.e. uint64_t[nBases * len],
+  and holds the bases one after the other. The outparam resM is `len` limbs in size.
+  The argument k is a montgomery context obtained through Hacl_GenericField64_field_init.
+
+  The argument b holds the exponents one after the other, each of them
+  bLen = (bBits - 1) / 64 + 1 limbs in size, i.e. uint64_t[nBases * bLen], and bBits is an
+  upper bound on the number of significant bits of every exponent.
+
+  Bases are processed in groups of at most 8. Within a group, all bases share a
+  single chain of squarings, interleaved with one multiplication per base and
+  4-bit window, and the results of the groups are multiplied together. The window
+  tables take at most 128 * len limbs of stack, whatever nBases is.
+
+  This function is constant-time over its argument b, at the cost of a slower
+  execution time than multi_exp_vartime.
+
+  Before calling this function, the caller will need to ensure that the following
+  preconditions are observed.
+  • b[i] < pow2 bBits for every exponent b[i]
+*/
+void
+Hacl_GenericField64_multi_exp_consttime(
+  Hacl_Bignum_MontArithmetic_bn_mont_ctx_u64 *k,
+  uint32_t nBases,
+  uint64_t *aM,
+  uint32_t bBits,
+  uint64_t *b,
+  uint64_t *resM
+)
+{
+  Hacl_Bignum_MontArithmetic_bn_mont_ctx_u64 k1 = *k;
+  uint32_t len1 = k1.len;
+  uint32_t bLen;
+  if (bBits == (uint32_t)0U)
+  {
+    bLen = (uint32_t)1U;
+  }
+  else
+  {
+    bLen = (bBits - (uint32_t)1U) / (uint32_t)64U + (uint32_t)1U;
+  }
+  if (nBases == (uint32_t)0U)
+  {
+    Hacl_Bignum_Montgomery_bn_from_mont_u64(len1, k1.n, k1.mu, k1.r2, resM);
+    return;
+  }
+  uint32_t nChunk;
+  if (nBases < (uint32_t)8U)
+  {
+    nChunk = nBases;
+  }
+  else
+  {
+    nChunk = (uint32_t)8U;
+  }
+  if (len1 > (uint32_t)0xffffffffU / (uint32_t)128U)
+  {
+    KRML_HOST_EPRINTF("Maximum allocatable size exceeded, aborting before overflow at %s:%d\n",
+      __FILE__,
+      __LINE__);
+    KRML_HOST_EXIT(253U);
+  }
+  KRML_CHECK_SIZE(sizeof (uint64_t), nChunk * (uint32_t)16U * len1);
+  uint64_t table[nChunk * (uint32_t)16U * len1];
+  memset(table, 0U, nChunk * (uint32_t)16U * len1 * sizeof (uint64_t));
+  KRML_CHECK_SIZE(sizeof (uint64_t), len1);
+  uint64_t tmp[len1];
+  memset(tmp, 0U, len1 * sizeof (uint64_t));
+  multi_exp_consttime_chunk(k1, nChunk, aM, bBits, bLen, b, table, resM);
+  for (uint32_t i = nChunk; i < nBases; i = i + nChunk)
+  {
+    uint32_t n1;
+    if (nBases - i < nChunk)
+    {
+      n1 = nBases - i;
+    }
+    else
+    {
+      n1 = nChunk;
+    }
+    multi_exp_consttime_chunk(k1, n1, aM + i * len1, bBits, bLen, b + i * bLen, table, tmp);
+    Hacl_Bignum_Montgomery_bn_mont_mul_u64(len1, k1.n, k1.mu, resM, tmp, resM);
+  }
+}
@@ -265,6 +265,97 @@ Hacl_GenericField64_inverse(
   uint64_t *aInvM
 );
 
+/*
+Write `aM[i] ^ (-1) mod n` in `aInvM[i]` for every 0 <= i < nElems.
+
+  The argument aM and the outparam aInvM are meant to be `nElems * len` limbs in size,
+  i.e. uint64_t[nElems * len], and hold the elements one after the other.
+  The argument k is a montgomery context obtained through Hacl_GenericField64_field_init.
+
+  This function uses Montgomery's trick: a single call to inverse on the product of
+  all elements, plus 3 * (nElems - 1) multiplications. The prefix products are kept
+  in aInvM, so no scratch space proportional to nElems is needed.
+
+  Before calling this function, the caller will need to ensure that the following
+  preconditions are observed.
+  • n is a prime
+  • 0 < aM[i] for every element aM[i]
+  • aM and aInvM are disjoint
+*/
+void
+Hacl_GenericField64_inverse_batch(
+  Hacl_Bignum_MontArithmetic_bn_mont_ctx_u64 *k,
+  uint32_t nElems,
+  uint64_t *aM,
+  uint64_t *aInvM
+);
+
+/*
+Write `aM[0] ^ b[0] * aM[1] ^ b[1] * ... * aM[nBases - 1] ^ b[nBases - 1] mod n` in `resM`.
+
+  The argument aM is meant to be `nBases * len` limbs in size, i.e. uint64_t[nBases * len],
+  and holds the bases one after the other. The outparam resM is `len` limbs in size.
+  The argument k is a montgomery context obtained through Hacl_GenericField64_field_init.
+
+  The argument b holds the exponents one after the other, each of them
+  bLen = (bBits - 1) / 64 + 1 limbs in size, i.e. uint64_t[nBases * bLen], and bBits is an
+  upper bound on the number of significant bits of every exponent.
+
+  Bases are processed in groups of at most 8. Within a group, all bases share a
+  single chain of squarings, interleaved with one multiplication per base and
+  4-bit window, and the results of the groups are multiplied together. The window
+  tables take at most 128 * len limbs of stack, whatever nBases is.
+
+  The function is *NOT* constant-time on the argument b. See the
+  multi_exp_consttime function for constant-time variant.
+
+  Before calling this function, the caller will need to ensure that the following
+  preconditions are observed.
+  • b[i] < pow2 bBits for every exponent b[i]
+*/
+void
+Hacl_GenericField64_multi_exp_vartime(
+  Hacl_Bignum_MontArithmetic_bn_mont_ctx_u64 *k,
+  uint32_t nBases,
+  uint64_t *aM,
+  uint32_t bBits,
+  uint64_t *b,
+  uint64_t *resM
+);
+
+/*
+Write `aM[0] ^ b[0] * aM[1] ^ b[1] * ... * aM[nBases - 1] ^ b[nBases - 1] mod n` in `resM`.
+
+  The argument aM is meant to be `nBases * len` limbs in size, i.e. uint64_t[nBases * len],
+  and holds the bases one after the other. The outparam resM is `len` limbs in size.
+  The argument k is a montgomery context obtained through Hacl_GenericField64_field_init.
+
+  The argument b holds the exponents one after the other, each of them
+  bLen = (bBits - 1) / 64 + 1 limbs in size, i.e. uint64_t[nBases * bLen], and bBits is an
+  upper bound on the number of significant bits of every exponent.
+
+  Bases are processed in groups of at most 8. Within a group, all bases share a
+  single chain of squarings, interleaved with one multiplication per base and
+  4-bit window, and the results of the groups are multiplied together. The window
+  tables take at most 128 * len limbs of stack, whatever nBases is.
+
+  This function is constant-time over its argument b, at the cost of a slower
+  execution time than multi_exp_vartime.
+
+  Before calling this function, the caller will need to ensure that the following
+  preconditions are observed.
+  • b[i] < pow2 bBits for every exponent b[i]
+*/
+void
+Hacl_GenericField64_multi_exp_consttime(
+  Hacl_Bignum_MontArithmetic_bn_mont_ctx_u64 *k,
+  uint32_t nBases,
+  uint64_t *aM,
+  uint32_t bBits,
+  uint64_t *b,
+  uint64_t *resM
+);
+
 #if defined(__cplusplus)
 }
 #endif
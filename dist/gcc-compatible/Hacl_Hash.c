@@ -24,6 +24,10 @@
 
 #include "Hacl_Hash.h"
 
+#include "Hacl_SHA2_Vec128.h"
+#include "Hacl_SHA2_Vec256.h"
+#include "EverCrypt_AutoConfig2.h"
+
 uint64_t Hacl_Hash_Core_Blake2_update_blake2s_32(uint32_t *s, uint64_t totlen, uint8_t *block)
 {
   uint32_t wv[16U] = { 0U };
@@ -3484,6 +3488,77 @@ void Hacl_Hash_SHA2_hash_256(uint8_t *input, uint32_t input_len, uint8_t *dst)
 
 typedef uint64_t *___uint64_t____;
 
+/*
+  Hash `n` independent messages with SHA2-256: `dsts[i]` receives the digest of
+  the `input_lens[i]` bytes at `inputs[i]`. Runs of consecutive messages of the
+  same length are hashed 8 (vec256) or 4 (vec128) at a time, one message per
+  vector lane, depending on the CPU; leftovers are hashed one at a time.
+*/
+void
+Hacl_Hash_SHA2_256_mb(uint32_t n, uint8_t **inputs, uint32_t *input_lens, uint8_t **dsts)
+{
+  bool vec256 = EverCrypt_AutoConfig2_has_vec256();
+  bool vec128 = EverCrypt_AutoConfig2_has_vec128();
+  uint32_t i = (uint32_t)0U;
+  while (i < n)
+  {
+    uint32_t len = input_lens[i];
+    uint32_t run = (uint32_t)1U;
+    while (i + run < n && input_lens[i + run] == len)
+    {
+      run++;
+    }
+    uint32_t j = i;
+    #if HACL_CAN_COMPILE_VEC256
+    if (vec256)
+    {
+      for (; j + (uint32_t)8U <= i + run; j = j + (uint32_t)8U)
+      {
+        Hacl_SHA2_Vec256_sha256_8(dsts[j],
+          dsts[j + (uint32_t)1U],
+          dsts[j + (uint32_t)2U],
+          dsts[j + (uint32_t)3U],
+          dsts[j + (uint32_t)4U],
+          dsts[j + (uint32_t)5U],
+          dsts[j + (uint32_t)6U],
+          dsts[j + (uint32_t)7U],
+          len,
+          inputs[j],
+          inputs[j + (uint32_t)1U],
+          inputs[j + (uint32_t)2U],
+          inputs[j + (uint32_t)3U],
+          inputs[j + (uint32_t)4U],
+          inputs[j + (uint32_t)5U],
+          inputs[j + (uint32_t)6U],
+          inputs[j + (uint32_t)7U]);
+      }
+    }
+    #endif
+    #if HACL_CAN_COMPILE_VEC128
+    if (vec128)
+    {
+      for (; j + (uint32_t)4U <= i + run; j = j + (uint32_t)4U)
+      {
+        Hacl_SHA2_Vec128_sha256_4(dsts[j],
+          dsts[j + (uint32_t)1U],
+          dsts[j + (uint32_t)2U],
+          dsts[j + (uint32_t)3U],
+          len,
+          inputs[j],
+          inputs[j + (uint32_t)1U],
+          inputs[j + (uint32_t)2U],
+          inputs[j + (uint32_t)3U]);
+      }
+    }
+    #endif
+    for (; j < i + run; j++)
+    {
+      Hacl_Hash_SHA2_hash_256(inputs[j], len, dsts[j]);
+    }
+    i = i + run;
+  }
+}
+
 void Hacl_Hash_SHA2_hash_384(uint8_t *input, uint32_t input_len, uint8_t *dst)
 {
   uint64_t
@@ -4159,6 +4234,22 @@ uint32_t Hacl_Hash_Definitions_word_len(Spec_Hash_Definitions_hash_alg a)
       {
         return (uint32_t)8U;
       }
+    case Spec_Hash_Definitions_SHA3_224:
+      {
+        return (uint32_t)8U;
+      }
+    case Spec_Hash_Definitions_SHA3_256:
+      {
+        return (uint32_t)8U;
+      }
+    case Spec_Hash_Definitions_SHA3_384:
+      {
+        return (uint32_t)8U;
+      }
+    case Spec_Hash_Definitions_SHA3_512:
+      {
+        return (uint32_t)8U;
+      }
     default:
       {
         KRML_HOST_EPRINTF("KreMLin incomplete match at %s:%d\n", __FILE__, __LINE__);
@@ -4203,6 +4294,22 @@ uint32_t Hacl_Hash_Definitions_block_len(Spec_Hash_Definitions_hash_alg a)
       {
         return (uint32_t)128U;
       }
+    case Spec_Hash_Definitions_SHA3_224:
+      {
+        return (uint32_t)144U;
+      }
+    case Spec_Hash_Definitions_SHA3_256:
+      {
+        return (uint32_t)136U;
+      }
+    case Spec_Hash_Definitions_SHA3_384:
+      {
+        return (uint32_t)104U;
+      }
+    case Spec_Hash_Definitions_SHA3_512:
+      {
+        return (uint32_t)72U;
+      }
     default:
       {
         KRML_HOST_EPRINTF("KreMLin incomplete match at %s:%d\n", __FILE__, __LINE__);
@@ -4291,6 +4398,22 @@ uint32_t Hacl_Hash_Definitions_hash_len(Spec_Hash_Definitions_hash_alg a)
       {
         return (uint32_t)64U;
       }
+    case Spec_Hash_Definitions_SHA3_224:
+      {
+        return (uint32_t)28U;
+      }
+    case Spec_Hash_Definitions_SHA3_256:
+      {
+        return (uint32_t)32U;
+      }
+    case Spec_Hash_Definitions_SHA3_384:
+      {
+        return (uint32_t)48U;
+      }
+    case Spec_Hash_Definitions_SHA3_512:
+      {
+        return (uint32_t)64U;
+      }
     default:
       {
         KRML_HOST_EPRINTF("KreMLin incomplete match at %s:%d\n", __FILE__, __LINE__);
@@ -198,6 +198,15 @@ void Hacl_Hash_SHA2_hash_224(uint8_t *input, uint32_t input_len, uint8_t *dst);
 
 void Hacl_Hash_SHA2_hash_256(uint8_t *input, uint32_t input_len, uint8_t *dst);
 
+/*
+  Hash `n` independent messages with SHA2-256: `dsts[i]` receives the digest of
+  the `input_lens[i]` bytes at `inputs[i]`. Runs of consecutive messages of the
+  same length are hashed 8 (vec256) or 4 (vec128) at a time, one message per
+  vector lane, depending on the CPU; leftovers are hashed one at a time.
+*/
+void
+Hacl_Hash_SHA2_256_mb(uint32_t n, uint8_t **inputs, uint32_t *input_lens, uint8_t **dsts);
+
 void Hacl_Hash_SHA2_hash_384(uint8_t *input, uint32_t input_len, uint8_t *dst);
 
 void Hacl_Hash_SHA2_hash_512(uint8_t *input, uint32_t input_len, uint8_t *dst);
@@ -24,6 +24,8 @@
 
 #include "Hacl_P256.h"
 
+#include "Hacl_P256_PrecompTable.h"
+
 static uint64_t isZero_uint64_CT(uint64_t *f)
 {
   uint64_t a0 = f[0U];
@@ -1377,6 +1379,93 @@ static void point_add(uint64_t *p, uint64_t *q, uint64_t *result, uint64_t *temp
   memcpy(result + (uint32_t)8U, z3_out1, (uint32_t)4U * sizeof (uint64_t));
 }
 
+static void uploadOneMont(uint64_t *f)
+{
+  f[0U] = (uint64_t)1U;
+  f[1U] = (uint64_t)18446744069414584320U;
+  f[2U] = (uint64_t)18446744073709551615U;
+  f[3U] = (uint64_t)4294967294U;
+}
+
+/*
+  Mixed addition of a Jacobian point p and an affine point q = (qX, qY), both in
+  the Montgomery domain, without any special case: p must not be at infinity,
+  and for p = q the result is (0, 0, 0) (for p = -q it is a point at infinity
+  with a non-zero X). Needs 40 limbs of tempBuffer.
+*/
+static void
+point_add_mixed_generic(uint64_t *p, uint64_t *q, uint64_t *result, uint64_t *tempBuffer)
+{
+  uint64_t *pX = p;
+  uint64_t *pY = p + (uint32_t)4U;
+  uint64_t *pZ = p + (uint32_t)8U;
+  uint64_t *qX = q;
+  uint64_t *qY = q + (uint32_t)4U;
+  uint64_t *x3 = result;
+  uint64_t *y3 = result + (uint32_t)4U;
+  uint64_t *z3 = result + (uint32_t)8U;
+  uint64_t *z1Square = tempBuffer;
+  uint64_t *z1Cube = tempBuffer + (uint32_t)4U;
+  uint64_t *u2 = tempBuffer + (uint32_t)8U;
+  uint64_t *s2 = tempBuffer + (uint32_t)12U;
+  uint64_t *h = tempBuffer + (uint32_t)16U;
+  uint64_t *r = tempBuffer + (uint32_t)20U;
+  uint64_t *hSquare = tempBuffer + (uint32_t)24U;
+  uint64_t *uh = tempBuffer + (uint32_t)28U;
+  uint64_t *hCube = tempBuffer + (uint32_t)32U;
+  uint64_t *tmp = tempBuffer + (uint32_t)36U;
+  montgomery_square_buffer(pZ, z1Square);
+  montgomery_multiplication_buffer(z1Square, pZ, z1Cube);
+  montgomery_multiplication_buffer(z1Square, qX, u2);
+  montgomery_multiplication_buffer(z1Cube, qY, s2);
+  p256_sub(u2, pX, h);
+  p256_sub(s2, pY, r);
+  montgomery_square_buffer(h, hSquare);
+  montgomery_multiplication_buffer(hSquare, pX, uh);
+  montgomery_multiplication_buffer(hSquare, h, hCube);
+  montgomery_square_buffer(r, x3);
+  p256_sub(x3, hCube, x3);
+  multByTwo(uh, tmp);
+  p256_sub(x3, tmp, x3);
+  p256_sub(uh, x3, tmp);
+  montgomery_multiplication_buffer(tmp, r, y3);
+  montgomery_multiplication_buffer(pY, hCube, tmp);
+  p256_sub(y3, tmp, y3);
+  montgomery_multiplication_buffer(pZ, h, z3);
+}
+
+/*
+  Mixed addition of a Jacobian point p and an affine point q = (qX, qY), both in
+  the Montgomery domain. Unlike point_add this one is complete: p = q falls back
+  to a doubling and p at infinity returns q, both selected in constant time, so
+  it can be used with any scalar in the fixed-base multiplication below.
+  Needs 68 limbs of tempBuffer.
+*/
+static void point_add_mixed(uint64_t *p, uint64_t *q, uint64_t *result, uint64_t *tempBuffer)
+{
+  uint64_t *pZ = p + (uint32_t)8U;
+  uint64_t *qX = q;
+  uint64_t *qY = q + (uint32_t)4U;
+  uint64_t *dbl = tempBuffer;
+  uint64_t *sum = tempBuffer + (uint32_t)12U;
+  uint64_t *x3 = sum;
+  uint64_t *y3 = sum + (uint32_t)4U;
+  uint64_t *z3 = sum + (uint32_t)8U;
+  point_double(p, dbl, tempBuffer + (uint32_t)24U);
+  point_add_mixed_generic(p, q, sum, tempBuffer + (uint32_t)24U);
+  uint64_t isDouble = isZero_uint64_CT(x3) & isZero_uint64_CT(z3);
+  copy_conditional(x3, dbl, isDouble);
+  copy_conditional(y3, dbl + (uint32_t)4U, isDouble);
+  copy_conditional(z3, dbl + (uint32_t)8U, isDouble);
+  uint64_t oneMont[4U] = { 0U };
+  uploadOneMont(oneMont);
+  uint64_t pInf = isZero_uint64_CT(pZ);
+  copy_conditional(x3, qX, pInf);
+  copy_conditional(y3, qY, pInf);
+  copy_conditional(z3, oneMont, pInf);
+  memcpy(result, sum, (uint32_t)12U * sizeof (uint64_t));
+}
+
 static void pointToDomain(uint64_t *p, uint64_t *result)
 {
   uint64_t *p_x = p;
@@ -1525,89 +1614,102 @@ scalarMultiplicationC(
   norm(q, result, buff);
 }
 
-static void uploadBasePoint(uint64_t *p)
-{
-  p[0U] = (uint64_t)8784043285714375740U;
-  p[1U] = (uint64_t)8483257759279461889U;
-  p[2U] = (uint64_t)8789745728267363600U;
-  p[3U] = (uint64_t)1770019616739251654U;
-  p[4U] = (uint64_t)15992936863339206154U;
-  p[5U] = (uint64_t)10037038012062884956U;
-  p[6U] = (uint64_t)15197544864945402661U;
-  p[7U] = (uint64_t)9615747158586711429U;
-  p[8U] = (uint64_t)1U;
-  p[9U] = (uint64_t)18446744069414584320U;
-  p[10U] = (uint64_t)18446744073709551615U;
-  p[11U] = (uint64_t)4294967294U;
-}
-
+/*
+  Adds [bits_l]T to result, where T is the point a precomputed table of
+  affine multiples [0..15]T was built for. The table entry is read with a
+  masked scan over the whole table and the zero window is handled by a
+  masked copy, so neither the memory accesses nor the control flow depend
+  on bits_l.
+*/
 static void
-scalarMultiplicationWithoutNorm(
-  uint64_t *p,
+point_add_precomp_consttime(
   uint64_t *result,
-  uint8_t *scalar,
+  const uint64_t *table,
+  uint64_t bits_l,
   uint64_t *tempBuffer
 )
 {
-  uint64_t *q = tempBuffer;
-  zero_buffer(q);
-  uint64_t *buff = tempBuffer + (uint32_t)12U;
-  pointToDomain(p, result);
-  for (uint32_t i = (uint32_t)0U; i < (uint32_t)256U; i++)
+  uint64_t pointT[8U] = { 0U };
+  for (uint32_t i0 = (uint32_t)0U; i0 < (uint32_t)15U; i0++)
   {
-    uint32_t bit0 = (uint32_t)255U - i;
-    uint64_t
-    bit =
-      (uint64_t)(scalar[(uint32_t)31U - bit0 / (uint32_t)8U] >> bit0 % (uint32_t)8U & (uint8_t)1U);
-    cswap(bit, q, result);
-    point_add(q, result, result, buff);
-    point_double(q, q, buff);
-    cswap(bit, q, result);
+    uint64_t c = FStar_UInt64_eq_mask(bits_l, (uint64_t)(i0 + (uint32_t)1U));
+    const uint64_t *res_j = table + (i0 + (uint32_t)1U) * (uint32_t)8U;
+    for (uint32_t i = (uint32_t)0U; i < (uint32_t)8U; i++)
+    {
+      uint64_t x = (c & res_j[i]) | (~c & pointT[i]);
+      pointT[i] = x;
+    }
+  }
+  uint64_t sum[12U] = { 0U };
+  point_add_mixed(result, pointT, sum, tempBuffer);
+  uint64_t mask = ~FStar_UInt64_eq_mask(bits_l, (uint64_t)0U);
+  copy_conditional(result, sum, mask);
+  copy_conditional(result + (uint32_t)4U, sum + (uint32_t)4U, mask);
+  copy_conditional(result + (uint32_t)8U, sum + (uint32_t)8U, mask);
+}
+
+/*
+  Constant-time fixed-base multiplication [scalar]G, result in Jacobian
+  coordinates in the Montgomery domain. The big-endian scalar is split into
+  four 64-bit words b0 + 2^64 b1 + 2^128 b2 + 2^192 b3 and the words are
+  processed together with 4-bit windows over the precomputed tables of
+  [j]G, [j 2^64]G, [j 2^128]G and [j 2^192]G: 60 doublings and 64 mixed
+  additions instead of the 256 doublings and additions of the ladder.
+*/
+static void point_mul_g(uint64_t *result, uint8_t *scalar, uint64_t *tempBuffer)
+{
+  uint64_t bscalar[4U] = { 0U };
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)4U; i++)
+  {
+    uint8_t *bj = scalar + ((uint32_t)3U - i) * (uint32_t)8U;
+    bscalar[i] = load64_be(bj);
+  }
+  zero_buffer(result);
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)16U; i++)
+  {
+    if (i > (uint32_t)0U)
+    {
+      point_double(result, result, tempBuffer);
+      point_double(result, result, tempBuffer);
+      point_double(result, result, tempBuffer);
+      point_double(result, result, tempBuffer);
+    }
+    uint32_t k = (uint32_t)60U - (uint32_t)4U * i;
+    uint64_t bits_l0 = bscalar[3U] >> k & (uint64_t)15U;
+    point_add_precomp_consttime(result,
+      Hacl_P256_PrecompTable_precomp_g_pow2_192_table_w4,
+      bits_l0,
+      tempBuffer);
+    uint64_t bits_l1 = bscalar[2U] >> k & (uint64_t)15U;
+    point_add_precomp_consttime(result,
+      Hacl_P256_PrecompTable_precomp_g_pow2_128_table_w4,
+      bits_l1,
+      tempBuffer);
+    uint64_t bits_l2 = bscalar[1U] >> k & (uint64_t)15U;
+    point_add_precomp_consttime(result,
+      Hacl_P256_PrecompTable_precomp_g_pow2_64_table_w4,
+      bits_l2,
+      tempBuffer);
+    uint64_t bits_l3 = bscalar[0U] >> k & (uint64_t)15U;
+    point_add_precomp_consttime(result,
+      Hacl_P256_PrecompTable_precomp_basepoint_table_w4,
+      bits_l3,
+      tempBuffer);
   }
-  copy_point(q, result);
 }
 
 void
 Hacl_Impl_P256_Core_secretToPublic(uint64_t *result, uint8_t *scalar, uint64_t *tempBuffer)
 {
-  uint64_t basePoint[12U] = { 0U };
-  uploadBasePoint(basePoint);
   uint64_t *q = tempBuffer;
   uint64_t *buff = tempBuffer + (uint32_t)12U;
-  zero_buffer(q);
-  for (uint32_t i = (uint32_t)0U; i < (uint32_t)256U; i++)
-  {
-    uint32_t bit0 = (uint32_t)255U - i;
-    uint64_t
-    bit =
-      (uint64_t)(scalar[(uint32_t)31U - bit0 / (uint32_t)8U] >> bit0 % (uint32_t)8U & (uint8_t)1U);
-    cswap(bit, q, basePoint);
-    point_add(q, basePoint, basePoint, buff);
-    point_double(q, q, buff);
-    cswap(bit, q, basePoint);
-  }
+  point_mul_g(q, scalar, buff);
   norm(q, result, buff);
 }
 
 static void secretToPublicWithoutNorm(uint64_t *result, uint8_t *scalar, uint64_t *tempBuffer)
 {
-  uint64_t basePoint[12U] = { 0U };
-  uploadBasePoint(basePoint);
-  uint64_t *q = tempBuffer;
-  uint64_t *buff = tempBuffer + (uint32_t)12U;
-  zero_buffer(q);
-  for (uint32_t i = (uint32_t)0U; i < (uint32_t)256U; i++)
-  {
-    uint32_t bit0 = (uint32_t)255U - i;
-    uint64_t
-    bit =
-      (uint64_t)(scalar[(uint32_t)31U - bit0 / (uint32_t)8U] >> bit0 % (uint32_t)8U & (uint8_t)1U);
-    cswap(bit, q, basePoint);
-    point_add(q, basePoint, basePoint, buff);
-    point_double(q, q, buff);
-    cswap(bit, q, basePoint);
-  }
-  copy_point(q, result);
+  point_mul_g(result, scalar, tempBuffer);
 }
 
 static const
@@ -2057,6 +2159,230 @@ static bool compare_felem_bool(uint64_t *a, uint64_t *b)
   return a_0 == b_0 && a_1 == b_1 && a_2 == b_2 && a_3 == b_3;
 }
 
+/*
+  Width-w non-adjacent form of a scalar given as four little-endian 64-bit limbs:
+  on return, scalar = sum naf[i] 2^i, where every non-zero digit is odd,
+  |naf[i]| < 2^(w-1) and any w consecutive digits contain at most one non-zero
+  digit. Returns the number of significant digits.
+
+   The input of the function is considered to be public,
+thus this code is not secret independent with respect to the operations done over the input.
+*/
+static uint32_t wnaf(int8_t *naf, uint64_t *scalar, uint32_t w)
+{
+  uint64_t k[5U] = { 0U };
+  memcpy(k, scalar, (uint32_t)4U * sizeof (uint64_t));
+  memset(naf, 0U, (uint32_t)257U * sizeof (int8_t));
+  uint64_t mask = ((uint64_t)1U << w) - (uint64_t)1U;
+  uint64_t half = (uint64_t)1U << (w - (uint32_t)1U);
+  uint32_t len = (uint32_t)0U;
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)257U; i++)
+  {
+    if ((k[0U] & (uint64_t)1U) == (uint64_t)1U)
+    {
+      uint64_t m = k[0U] & mask;
+      if (m < half)
+      {
+        naf[i] = (int8_t)m;
+        k[0U] = k[0U] - m;
+      }
+      else
+      {
+        uint64_t d = ((uint64_t)1U << w) - m;
+        naf[i] = (int8_t)((int32_t)m - ((int32_t)1 << w));
+        uint64_t c = (uint64_t)0U;
+        k[0U] = k[0U] + d;
+        c = (uint64_t)(k[0U] < d);
+        for (uint32_t j = (uint32_t)1U; j < (uint32_t)5U; j++)
+        {
+          k[j] = k[j] + c;
+          c = (uint64_t)(c == (uint64_t)1U && k[j] == (uint64_t)0U);
+        }
+      }
+      len = i + (uint32_t)1U;
+    }
+    for (uint32_t j = (uint32_t)0U; j < (uint32_t)4U; j++)
+    {
+      k[j] = k[j] >> (uint32_t)1U | k[j + (uint32_t)1U] << (uint32_t)63U;
+    }
+    k[4U] = k[4U] >> (uint32_t)1U;
+  }
+  return len;
+}
+
+/*
+  Complete addition of two Jacobian points: point_add already handles the
+  points at infinity, p = q is detected on its (0, 0, 0) output and redone as a
+  doubling.
+
+   The input of the function is considered to be public,
+thus this code is not secret independent with respect to the operations done over the input.
+*/
+static void point_add_vartime(uint64_t *p, uint64_t *q, uint64_t *result, uint64_t *tempBuffer)
+{
+  uint64_t sum[12U] = { 0U };
+  point_add(p, q, sum, tempBuffer);
+  bool pInf = isPointAtInfinityPublic(p);
+  bool qInf = isPointAtInfinityPublic(q);
+  bool sumIsZero = isPointAtInfinityPublic(sum) && isZero_uint64_CT(sum) != (uint64_t)0U;
+  if (!pInf && !qInf && sumIsZero)
+  {
+    point_double(p, result, tempBuffer);
+  }
+  else
+  {
+    memcpy(result, sum, (uint32_t)12U * sizeof (uint64_t));
+  }
+}
+
+/*
+  Complete mixed addition of a Jacobian point p and an affine point q.
+
+   The input of the function is considered to be public,
+thus this code is not secret independent with respect to the operations done over the input.
+*/
+static void
+point_add_mixed_vartime(uint64_t *p, uint64_t *q, uint64_t *result, uint64_t *tempBuffer)
+{
+  if (isPointAtInfinityPublic(p))
+  {
+    memcpy(result, q, (uint32_t)8U * sizeof (uint64_t));
+    uploadOneMont(result + (uint32_t)8U);
+  }
+  else
+  {
+    uint64_t sum[12U] = { 0U };
+    point_add_mixed_generic(p, q, sum, tempBuffer);
+    bool sumIsZero = isPointAtInfinityPublic(sum) && isZero_uint64_CT(sum) != (uint64_t)0U;
+    if (sumIsZero)
+    {
+      point_double(p, result, tempBuffer);
+    }
+    else
+    {
+      memcpy(result, sum, (uint32_t)12U * sizeof (uint64_t));
+    }
+  }
+}
+
+/*
+  out = out + [d]T for an odd wNAF digit d, where table holds the odd multiples
+  of T as affine points.
+*/
+static void
+point_add_naf_digit_affine(uint64_t *out, const uint64_t *table, int8_t d, uint64_t *tempBuffer)
+{
+  if (d != (int8_t)0)
+  {
+    uint64_t p[8U] = { 0U };
+    uint32_t j;
+    if (d > (int8_t)0)
+    {
+      j = (uint32_t)(d >> 1);
+    }
+    else
+    {
+      j = (uint32_t)(-(int32_t)d >> 1);
+    }
+    memcpy(p, table + j * (uint32_t)8U, (uint32_t)8U * sizeof (uint64_t));
+    if (d < (int8_t)0)
+    {
+      uint64_t zero[4U] = { 0U };
+      p256_sub(zero, p + (uint32_t)4U, p + (uint32_t)4U);
+    }
+    point_add_mixed_vartime(out, p, out, tempBuffer);
+  }
+}
+
+/*
+  out = out + [d]T for an odd wNAF digit d, where table holds the odd multiples
+  of T as Jacobian points.
+*/
+static void
+point_add_naf_digit(uint64_t *out, uint64_t *table, int8_t d, uint64_t *tempBuffer)
+{
+  if (d != (int8_t)0)
+  {
+    uint64_t p[12U] = { 0U };
+    uint32_t j;
+    if (d > (int8_t)0)
+    {
+      j = (uint32_t)(d >> 1);
+    }
+    else
+    {
+      j = (uint32_t)(-(int32_t)d >> 1);
+    }
+    memcpy(p, table + j * (uint32_t)12U, (uint32_t)12U * sizeof (uint64_t));
+    if (d < (int8_t)0)
+    {
+      uint64_t zero[4U] = { 0U };
+      p256_sub(zero, p + (uint32_t)4U, p + (uint32_t)4U);
+    }
+    point_add_vartime(out, p, out, tempBuffer);
+  }
+}
+
+/*
+  Variable-time double-scalar multiplication result = [u1]G + [u2]q
+  (Straus-Shamir), for scalars given as four little-endian limbs and q a
+  Jacobian point in the Montgomery domain. u1 is recoded in width-7 NAF over
+  the static table of odd multiples of G, u2 in width-5 NAF over the 8 odd
+  multiples of q computed here; the two share a single chain of doublings.
+  Needs 88 limbs of tempBuffer.
+
+   The input of the function is considered to be public,
+thus this code is not secret independent with respect to the operations done over the input.
+*/
+static void
+point_mul_double_g_vartime(
+  uint64_t *result,
+  uint64_t *u1,
+  uint64_t *u2,
+  uint64_t *q,
+  uint64_t *tempBuffer
+)
+{
+  uint64_t table[96U] = { 0U };
+  uint64_t q2[12U] = { 0U };
+  memcpy(table, q, (uint32_t)12U * sizeof (uint64_t));
+  point_double(q, q2, tempBuffer);
+  for (uint32_t i = (uint32_t)1U; i < (uint32_t)8U; i++)
+  {
+    point_add_vartime(table + (i - (uint32_t)1U) * (uint32_t)12U,
+      q2,
+      table + i * (uint32_t)12U,
+      tempBuffer);
+  }
+  int8_t naf1[257U] = { 0U };
+  int8_t naf2[257U] = { 0U };
+  uint32_t len1 = wnaf(naf1, u1, (uint32_t)7U);
+  uint32_t len2 = wnaf(naf2, u2, (uint32_t)5U);
+  uint32_t len;
+  if (len1 < len2)
+  {
+    len = len2;
+  }
+  else
+  {
+    len = len1;
+  }
+  zero_buffer(result);
+  for (uint32_t i0 = (uint32_t)0U; i0 < len; i0++)
+  {
+    uint32_t i = len - i0 - (uint32_t)1U;
+    if (i0 > (uint32_t)0U)
+    {
+      point_double(result, result, tempBuffer);
+    }
+    point_add_naf_digit_affine(result,
+      Hacl_P256_PrecompTable_precomp_basepoint_odd_table_w7,
+      naf1[i],
+      tempBuffer);
+    point_add_naf_digit(result, table, naf2[i], tempBuffer);
+  }
+}
+
 /*
    The input of the function is considered to be public,
 thus this code is not secret independent with respect to the operations done over the input.
@@ -2089,9 +2415,6 @@ ecdsa_verification_(
   {
     return false;
   }
-  uint8_t tempBufferU8[64U] = { 0U };
-  uint8_t *bufferU1 = tempBufferU8;
-  uint8_t *bufferU2 = tempBufferU8 + (uint32_t)32U;
   uint32_t sz;
   if (alg.tag == Spec_ECDSA_NoHash)
   {
@@ -2206,46 +2529,11 @@ ecdsa_verification_(
   montgomery_ladder_exponent(inverseS);
   multPowerPartial(inverseS, hashAsFelem, u1);
   multPowerPartial(inverseS, r, u2);
-  Hacl_Impl_P256_LowLevel_changeEndian(u1);
-  Hacl_Impl_P256_LowLevel_changeEndian(u2);
-  Hacl_Impl_P256_LowLevel_toUint8(u1, bufferU1);
-  Hacl_Impl_P256_LowLevel_toUint8(u2, bufferU2);
+  uint64_t publicKeyDomain[12U] = { 0U };
   uint64_t pointSum[12U] = { 0U };
-  uint64_t points[24U] = { 0U };
   uint64_t *buff = tempBuffer + (uint32_t)12U;
-  uint64_t *pointU1G = points;
-  uint64_t *pointU2Q0 = points + (uint32_t)12U;
-  secretToPublicWithoutNorm(pointU1G, bufferU1, tempBuffer);
-  scalarMultiplicationWithoutNorm(publicKeyBuffer, pointU2Q0, bufferU2, tempBuffer);
-  uint64_t *pointU1G0 = points;
-  uint64_t *pointU2Q = points + (uint32_t)12U;
-  uint64_t tmp[112U] = { 0U };
-  uint64_t *tmpForNorm = tmp;
-  uint64_t *result0Norm = tmp + (uint32_t)88U;
-  uint64_t *result1Norm = tmp + (uint32_t)100U;
-  uint64_t *pointU1G1 = points;
-  uint64_t *pointU2Q1 = points + (uint32_t)12U;
-  norm(pointU1G1, result0Norm, tmpForNorm);
-  norm(pointU2Q1, result1Norm, tmpForNorm);
-  uint64_t *x0 = result0Norm;
-  uint64_t *y0 = result0Norm + (uint32_t)4U;
-  uint64_t *z0 = result0Norm + (uint32_t)8U;
-  uint64_t *x1 = result1Norm;
-  uint64_t *y1 = result1Norm + (uint32_t)4U;
-  uint64_t *z1 = result1Norm + (uint32_t)8U;
-  bool xEqual = compare_felem_bool(x0, x1);
-  bool yEqual = compare_felem_bool(y0, y1);
-  bool zEqual = compare_felem_bool(z0, z1);
-  bool equalX = xEqual && yEqual && zEqual;
-  bool equalX0 = equalX;
-  if (equalX0)
-  {
-    point_double(pointU1G0, pointSum, buff);
-  }
-  else
-  {
-    point_add(pointU1G0, pointU2Q, pointSum, buff);
-  }
+  pointToDomain(publicKeyBuffer, publicKeyDomain);
+  point_mul_double_g_vartime(pointSum, u1, u2, publicKeyDomain, buff);
   norm(pointSum, pointSum, buff);
   bool resultIsPAI = isPointAtInfinityPublic(pointSum);
   uint64_t *xCoordinateSum = pointSum;
@@ -0,0 +1,269 @@
+/* MIT License
+ *
+ * Copyright (c) 2016-2020 INRIA, CMU and Microsoft Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef __Hacl_P256_PrecompTable_H
+#define __Hacl_P256_PrecompTable_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include "evercrypt_targetconfig.h"
+#include "libintvector.h"
+#include "kremlin/internal/types.h"
+#include "kremlin/lowstar_endianness.h"
+#include <string.h>
+#include "kremlin/internal/target.h"
+
+
+
+
+static const
+uint64_t
+Hacl_P256_PrecompTable_precomp_basepoint_table_w4[128U] =
+  {
+    (uint64_t)0U, (uint64_t)0U, (uint64_t)0U, (uint64_t)0U,
+    (uint64_t)0U, (uint64_t)0U, (uint64_t)0U, (uint64_t)0U,
+    (uint64_t)8784043285714375740U, (uint64_t)8483257759279461889U, (uint64_t)8789745728267363600U, (uint64_t)1770019616739251654U,
+    (uint64_t)15992936863339206154U, (uint64_t)10037038012062884956U, (uint64_t)15197544864945402661U, (uint64_t)9615747158586711429U,
+    (uint64_t)9583737883674400333U, (uint64_t)12279877754802111101U, (uint64_t)8296198976379850969U, (uint64_t)17778859909846088251U,
+    (uint64_t)3401986641240187301U, (uint64_t)1525831644595056632U, (uint64_t)1849003687033449918U, (uint64_t)8702493044913179195U,
+    (uint64_t)18423170064697770279U, (uint64_t)12693387071620743675U, (uint64_t)7398701556189346968U, (uint64_t)2779682216903406718U,
+    (uint64_t)12703629940499916779U, (uint64_t)6358598532389273114U, (uint64_t)8683512038509439374U, (uint64_t)15415938252666293255U,
+    (uint64_t)8408419572923862476U, (uint64_t)5066733120953500019U, (uint64_t)926242532005776114U, (uint64_t)6301489109130024811U,
+    (uint64_t)3285079390283344806U, (uint64_t)1685054835664548935U, (uint64_t)7740622190510199342U, (uint64_t)9561507292862134371U,
+    (uint64_t)13698695174800826869U, (uint64_t)10442832251048252285U, (uint64_t)10672604962207744524U, (uint64_t)14485711676978308040U,
+    (uint64_t)16947216143812808464U, (uint64_t)8342189264337602603U, (uint64_t)3837253281927274344U, (uint64_t)8331789856935110934U,
+    (uint64_t)4627808394696681034U, (uint64_t)6174000022702321214U, (uint64_t)15351247319787348909U, (uint64_t)1371147458593240691U,
+    (uint64_t)10651965436787680331U, (uint64_t)2998319090323362997U, (uint64_t)17592419471314886417U, (uint64_t)11874181791118522207U,
+    (uint64_t)524165018444839759U, (uint64_t)3157588572894920951U, (uint64_t)17599692088379947784U, (uint64_t)1421537803477597699U,
+    (uint64_t)2902517390503550285U, (uint64_t)7440776657136679901U, (uint64_t)17263207614729765269U, (uint64_t)16928425260420958311U,
+    (uint64_t)2878166099891431311U, (uint64_t)5056053391262430293U, (uint64_t)10345032411278802027U, (uint64_t)13214556496570163981U,
+    (uint64_t)17698482058276194679U, (uint64_t)2441850938900527637U, (uint64_t)1314061001345252336U, (uint64_t)6263402014353842038U,
+    (uint64_t)8487436533858443496U, (uint64_t)12386798851261442113U, (uint64_t)3224748875345095424U, (uint64_t)16166568617729909099U,
+    (uint64_t)2213369110503306004U, (uint64_t)6246347469485852131U, (uint64_t)3129440554298978074U, (uint64_t)605269941184323483U,
+    (uint64_t)3177531230451277512U, (uint64_t)11022989490494865721U, (uint64_t)8321856985295555401U, (uint64_t)14727273563873821327U,
+    (uint64_t)876865438755954294U, (uint64_t)14139765236890058248U, (uint64_t)6880705719513638354U, (uint64_t)8678887646434118325U,
+    (uint64_t)16896703203004244996U, (uint64_t)11377226897030111200U, (uint64_t)2302364246994590389U, (uint64_t)4499255394192625779U,
+    (uint64_t)1906858144627445384U, (uint64_t)2670515414718439880U, (uint64_t)868537809054295101U, (uint64_t)7535366755622172814U,
+    (uint64_t)339769604981749608U, (uint64_t)12384581172556225075U, (uint64_t)2596838235904096350U, (uint64_t)5684069910326796630U,
+    (uint64_t)913125548148611907U, (uint64_t)1661497269948077623U, (uint64_t)2892028918424825190U, (uint64_t)9220412792897768138U,
+    (uint64_t)14754959387565938441U, (uint64_t)1023838193204581133U, (uint64_t)13599978343236540433U, (uint64_t)8323909593307920217U,
+    (uint64_t)3852032956982813055U, (uint64_t)7526785533690696419U, (uint64_t)8993798556223495105U, (uint64_t)18140648187477079959U,
+    (uint64_t)11692087196810962506U, (uint64_t)1328079167955601379U, (uint64_t)1664008958165329504U, (uint64_t)18063501818261063470U,
+    (uint64_t)2861243404839114859U, (uint64_t)13702578580056324034U, (uint64_t)16781565866279299035U, (uint64_t)1524194541633674171U,
+    (uint64_t)8267721299596412251U, (uint64_t)273633183929630283U, (uint64_t)17164190306640434032U, (uint64_t)16332882679719778825U,
+    (uint64_t)4663567915067622493U, (uint64_t)15521151801790569253U, (uint64_t)7273215397645141911U, (uint64_t)2324445691280731636U
+  };
+
+static const
+uint64_t
+Hacl_P256_PrecompTable_precomp_g_pow2_64_table_w4[128U] =
+  {
+    (uint64_t)0U, (uint64_t)0U, (uint64_t)0U, (uint64_t)0U,
+    (uint64_t)0U, (uint64_t)0U, (uint64_t)0U, (uint64_t)0U,
+    (uint64_t)5733697799130763963U, (uint64_t)962857090393715865U, (uint64_t)10538932452511329419U, (uint64_t)3413281437172590207U,
+    (uint64_t)6635428480179771287U, (uint64_t)4404718679994229138U, (uint64_t)329074170931436370U, (uint64_t)17746708206910902139U,
+    (uint64_t)179238781994802586U, (uint64_t)9017860544212172426U, (uint64_t)16179187983079961859U, (uint64_t)1380105261896053495U,
+    (uint64_t)6187003332254463653U, (uint64_t)9896593306091975718U, (uint64_t)17181949235068293496U, (uint64_t)6820143159816507763U,
+    (uint64_t)4652378169433586070U, (uint64_t)2069013165869224423U, (uint64_t)13972912433480425078U, (uint64_t)2248203233787863058U,
+    (uint64_t)12819880125496785064U, (uint64_t)12462800229583867169U, (uint64_t)7969192387226362512U, (uint64_t)15450728326339004590U,
+    (uint64_t)11156900805411912784U, (uint64_t)1737275748212365168U, (uint64_t)16993486692205800040U, (uint64_t)12538938066475152524U,
+    (uint64_t)13167476167764338790U, (uint64_t)17373319366642541595U, (uint64_t)6054831428930905282U, (uint64_t)7118452124011953000U,
+    (uint64_t)15319323094268250368U, (uint64_t)15751569639563379275U, (uint64_t)9174762389399453601U, (uint64_t)5359273060607997116U,
+    (uint64_t)7548480167962649047U, (uint64_t)4093535200286790152U, (uint64_t)18255003581953064302U, (uint64_t)17037929372197430710U,
+    (uint64_t)3640693116491518731U, (uint64_t)9689920283410066894U, (uint64_t)16070225083132083168U, (uint64_t)13505008973802466003U,
+    (uint64_t)750230942699692016U, (uint64_t)15522838682331888368U, (uint64_t)112268476925002814U, (uint64_t)17491605970126192984U,
+    (uint64_t)16769567946241955549U, (uint64_t)17099752525969374817U, (uint64_t)14041401861628609700U, (uint64_t)13883170585376164878U,
+    (uint64_t)1568639950869924595U, (uint64_t)7305902646691031157U, (uint64_t)12536573783075304502U, (uint64_t)12490145094151973568U,
+    (uint64_t)743288751022377974U, (uint64_t)9226164090128370715U, (uint64_t)17669221687181604232U, (uint64_t)1117842260351396541U,
+    (uint64_t)17697784451833850722U, (uint64_t)14382209306891991103U, (uint64_t)16951372733687268016U, (uint64_t)188390802712613066U,
+    (uint64_t)7332583781810119624U, (uint64_t)11974900502289827649U, (uint64_t)9825039434151224666U, (uint64_t)13612433455140779130U,
+    (uint64_t)11167094757836568968U, (uint64_t)148858902984029622U, (uint64_t)4325547061862811500U, (uint64_t)8439987427904092212U,
+    (uint64_t)9775040802880336170U, (uint64_t)2183956155792599391U, (uint64_t)10102475962557589963U, (uint64_t)14902149990037881859U,
+    (uint64_t)7528893974593517583U, (uint64_t)18271333130592009124U, (uint64_t)11812759747597590978U, (uint64_t)3931581515688264350U,
+    (uint64_t)7368734173241076742U, (uint64_t)12419301291748626639U, (uint64_t)10534790951032501149U, (uint64_t)16676926058266807225U,
+    (uint64_t)13614593066288445663U, (uint64_t)5547469267128540754U, (uint64_t)5071513241190976074U, (uint64_t)6206141439571986364U,
+    (uint64_t)13268209255833199938U, (uint64_t)16633146482265079265U, (uint64_t)6044233937395578074U, (uint64_t)1733872861371247406U,
+    (uint64_t)14239198956565602758U, (uint64_t)4036306057099495106U, (uint64_t)1778912298053970082U, (uint64_t)6174082695927204648U,
+    (uint64_t)9563897475320169888U, (uint64_t)3828463449263891363U, (uint64_t)4522408683909966848U, (uint64_t)10085044841903958270U,
+    (uint64_t)15115863363467748291U, (uint64_t)3921763467143122522U, (uint64_t)3241611744432406503U, (uint64_t)16149166019569794702U,
+    (uint64_t)13355027832202142668U, (uint64_t)13259310595418810737U, (uint64_t)16638224598838046396U, (uint64_t)388655643128437049U,
+    (uint64_t)6131988039969669992U, (uint64_t)16758867465997134050U, (uint64_t)793705445085763779U, (uint64_t)16225736542798627427U,
+    (uint64_t)12060616483613851492U, (uint64_t)11185023117529741833U, (uint64_t)15286366164051065546U, (uint64_t)5407795227432242447U,
+    (uint64_t)3261413161331398298U, (uint64_t)7182873809282605970U, (uint64_t)2155509494582452911U, (uint64_t)16998725707829879258U
+  };
+
+static const
+uint64_t
+Hacl_P256_PrecompTable_precomp_g_pow2_128_table_w4[128U] =
+  {
+    (uint64_t)0U, (uint64_t)0U, (uint64_t)0U, (uint64_t)0U,
+    (uint64_t)0U, (uint64_t)0U, (uint64_t)0U, (uint64_t)0U,
+    (uint64_t)7109145612337154341U, (uint64_t)10502845970727626855U, (uint64_t)6527587047878193251U, (uint64_t)7049690136888681718U,
+    (uint64_t)16750703006415156202U, (uint64_t)2559311261501721445U, (uint64_t)1222802194566919230U, (uint64_t)18019462938525560766U,
+    (uint64_t)2592184418896595488U, (uint64_t)1723751460114310463U, (uint64_t)11198512454461769811U, (uint64_t)6203707848404803677U,
+    (uint64_t)2601731234271436477U, (uint64_t)18186700975610533226U, (uint64_t)4757569424831899615U, (uint64_t)13359873383138312209U,
+    (uint64_t)13904640252203718708U, (uint64_t)10747313134117021792U, (uint64_t)14667070697514384141U, (uint64_t)2600977347774743546U,
+    (uint64_t)15498986940124021079U, (uint64_t)14740645313274577011U, (uint64_t)17403811028932224808U, (uint64_t)8060102076475954685U,
+    (uint64_t)12990649636107730851U, (uint64_t)13002224935892458030U, (uint64_t)4380799638612122791U, (uint64_t)7935443787987894924U,
+    (uint64_t)10438069978940053126U, (uint64_t)302419699431148366U, (uint64_t)551508078777729872U, (uint64_t)366155636877501719U,
+    (uint64_t)14734735764746786753U, (uint64_t)1378251478826083755U, (uint64_t)13509550209468602124U, (uint64_t)14458158239096821346U,
+    (uint64_t)5681313138148713219U, (uint64_t)9054039627425609375U, (uint64_t)4235536482830620712U, (uint64_t)1502753755874778370U,
+    (uint64_t)8914021876030553161U, (uint64_t)9071747156187788379U, (uint64_t)14974736924255494885U, (uint64_t)17070198435868341999U,
+    (uint64_t)3643991391224035758U, (uint64_t)260637732328275649U, (uint64_t)17609644917816078225U, (uint64_t)2302996326941944665U,
+    (uint64_t)5888744936142942064U, (uint64_t)17277140802638358763U, (uint64_t)10290028650289820825U, (uint64_t)1940657436863195045U,
+    (uint64_t)10796401239257150661U, (uint64_t)7788083050548605852U, (uint64_t)13474393003015663489U, (uint64_t)8961936186303685357U,
+    (uint64_t)16407225233842256953U, (uint64_t)13423683834633513951U, (uint64_t)17454464203550700633U, (uint64_t)6033758555290610449U,
+    (uint64_t)5063673994339442907U, (uint64_t)12250392784929419939U, (uint64_t)5954485814444410119U, (uint64_t)10099095370725442279U,
+    (uint64_t)4687621216548073298U, (uint64_t)12683256962895584277U, (uint64_t)1406415612737291460U, (uint64_t)3991320149877222007U,
+    (uint64_t)403384179417053146U, (uint64_t)7072351635192146705U, (uint64_t)14388831570324308780U, (uint64_t)2518546598792352745U,
+    (uint64_t)2866701220158780648U, (uint64_t)14345701180700655413U, (uint64_t)10383205903323525163U, (uint64_t)14561034237887346332U,
+    (uint64_t)4525630512028460468U, (uint64_t)7470042867870921036U, (uint64_t)12498636959757093905U, (uint64_t)14959680069767374094U,
+    (uint64_t)939355076355747784U, (uint64_t)236998652239230884U, (uint64_t)7862332576114728232U, (uint64_t)3008745396212765985U,
+    (uint64_t)16892515157128448879U, (uint64_t)1688671543548974140U, (uint64_t)582235491724828261U, (uint64_t)2879861045707356356U,
+    (uint64_t)5793581539270397654U, (uint64_t)12067972155882240315U, (uint64_t)1914416028486337582U, (uint64_t)2044052608129533771U,
+    (uint64_t)1045680055817519578U, (uint64_t)6183307954634642810U, (uint64_t)1115903654002488241U, (uint64_t)9729229622559998051U,
+    (uint64_t)11505233554542243613U, (uint64_t)13650372171621554098U, (uint64_t)11886401428750724176U, (uint64_t)2616122636264787282U,
+    (uint64_t)9807875738265530891U, (uint64_t)2065326856613209663U, (uint64_t)3841177149705795822U, (uint64_t)12478836916087572836U,
+    (uint64_t)8725096612265348131U, (uint64_t)16959754534248500306U, (uint64_t)3934616751368449170U, (uint64_t)887912345061829880U,
+    (uint64_t)11410178859948957868U, (uint64_t)12867384504930748729U, (uint64_t)4367798270196663137U, (uint64_t)4359910421693489126U,
+    (uint64_t)18221589825782480868U, (uint64_t)15875305463032670629U, (uint64_t)1054133002549446970U, (uint64_t)2220911650204683784U,
+    (uint64_t)10874691797030180071U, (uint64_t)13903803155513130100U, (uint64_t)14873882741737344436U, (uint64_t)9374498718172057556U
+  };
+
+static const
+uint64_t
+Hacl_P256_PrecompTable_precomp_g_pow2_192_table_w4[128U] =
+  {
+    (uint64_t)0U, (uint64_t)0U, (uint64_t)0U, (uint64_t)0U,
+    (uint64_t)0U, (uint64_t)0U, (uint64_t)0U, (uint64_t)0U,
+    (uint64_t)6266830413981331818U, (uint64_t)10890859480409122410U, (uint64_t)738708598357264321U, (uint64_t)9241173142142102299U,
+    (uint64_t)9152169484987657321U, (uint64_t)12122430118903337055U, (uint64_t)14270062735458703743U, (uint64_t)13877635605034675649U,
+    (uint64_t)4572419849863661964U, (uint64_t)16330741525817240677U, (uint64_t)5456771007607263420U, (uint64_t)8798510164381810403U,
+    (uint64_t)16547183593064549865U, (uint64_t)11355135595370359779U, (uint64_t)17581910791451710925U, (uint64_t)11684604415749005488U,
+    (uint64_t)2766130068233451740U, (uint64_t)15909689412657372214U, (uint64_t)3272828023364980896U, (uint64_t)12907534005596438003U,
+    (uint64_t)7065629942275705493U, (uint64_t)10609982651084321649U, (uint64_t)17330343421617897811U, (uint64_t)1746246157222856918U,
+    (uint64_t)13168953859078137190U, (uint64_t)9072500190247791267U, (uint64_t)11090199374278127099U, (uint64_t)3503847851309060744U,
+    (uint64_t)14395788825673846582U, (uint64_t)15073993563711333791U, (uint64_t)12879874391706003251U, (uint64_t)15417028700542288171U,
+    (uint64_t)2686132933630431595U, (uint64_t)334448852204016400U, (uint64_t)5636563341880055087U, (uint64_t)3897420469445246068U,
+    (uint64_t)10569177829735084588U, (uint64_t)8244586887721364305U, (uint64_t)17973493209847502315U, (uint64_t)18083956436923498083U,
+    (uint64_t)15514509130323617046U, (uint64_t)9833490355170899102U, (uint64_t)12028021566105512521U, (uint64_t)6349458533674010018U,
+    (uint64_t)13470024118569549588U, (uint64_t)7867188201997717819U, (uint64_t)6110792121234766402U, (uint64_t)9917858515766574695U,
+    (uint64_t)8273062939911446888U, (uint64_t)1936638151089648185U, (uint64_t)44602505720759914U, (uint64_t)7839132833110815763U,
+    (uint64_t)13045756168264521992U, (uint64_t)5375972549477973022U, (uint64_t)16964151563535745964U, (uint64_t)2871770426902555432U,
+    (uint64_t)14164643693563803212U, (uint64_t)6386904235704679249U, (uint64_t)931435629437735510U, (uint64_t)4496152555914735639U,
+    (uint64_t)820099532545743339U, (uint64_t)13419988718062417698U, (uint64_t)8948965620484833159U, (uint64_t)7238410427920554862U,
+    (uint64_t)4387941928212462673U, (uint64_t)8023190031094282215U, (uint64_t)12322462122895470016U, (uint64_t)17311901330042910195U,
+    (uint64_t)16445894183838823370U, (uint64_t)690424095855074674U, (uint64_t)12820742226551488738U, (uint64_t)227935274674223825U,
+    (uint64_t)17437729542205914525U, (uint64_t)8439533239207225162U, (uint64_t)2862942422640746698U, (uint64_t)7340866642549630610U,
+    (uint64_t)6770451500989398335U, (uint64_t)17262212260581413381U, (uint64_t)2156505157624055602U, (uint64_t)12195119268846383898U,
+    (uint64_t)13685370053507732180U, (uint64_t)8304030489296890211U, (uint64_t)7042719123662732989U, (uint64_t)12115154796394040286U,
+    (uint64_t)10496877583013829980U, (uint64_t)8909625177349683785U, (uint64_t)5268451666475070682U, (uint64_t)8910488385056259560U,
+    (uint64_t)8874918984373509240U, (uint64_t)6652428549855789281U, (uint64_t)14866714872885601270U, (uint64_t)12093494664302554643U,
+    (uint64_t)10149999253136441007U, (uint64_t)1611873554177023520U, (uint64_t)10271627298853910516U, (uint64_t)15171882630355491729U,
+    (uint64_t)17085353800722834618U, (uint64_t)3271271583189511718U, (uint64_t)9338466116389304614U, (uint64_t)4685545953421459012U,
+    (uint64_t)5059702655119414343U, (uint64_t)201476627889215522U, (uint64_t)6388612869673101372U, (uint64_t)8357217932305360896U,
+    (uint64_t)1836621694151238424U, (uint64_t)11438765101326043062U, (uint64_t)5537182303007083642U, (uint64_t)2657011195641217678U,
+    (uint64_t)15370176245454161308U, (uint64_t)1478361893117141052U, (uint64_t)8729368992402422055U, (uint64_t)4807782542738120272U,
+    (uint64_t)5084555197036037383U, (uint64_t)500829604818691390U, (uint64_t)8128181767026348964U, (uint64_t)17895639808733462562U,
+    (uint64_t)4138748420878083709U, (uint64_t)267892430674902987U, (uint64_t)8954358455330696651U, (uint64_t)1946224964877667668U
+  };
+
+static const
+uint64_t
+Hacl_P256_PrecompTable_precomp_basepoint_odd_table_w7[256U] =
+  {
+    (uint64_t)8784043285714375740U, (uint64_t)8483257759279461889U, (uint64_t)8789745728267363600U, (uint64_t)1770019616739251654U,
+    (uint64_t)15992936863339206154U, (uint64_t)10037038012062884956U, (uint64_t)15197544864945402661U, (uint64_t)9615747158586711429U,
+    (uint64_t)18423170064697770279U, (uint64_t)12693387071620743675U, (uint64_t)7398701556189346968U, (uint64_t)2779682216903406718U,
+    (uint64_t)12703629940499916779U, (uint64_t)6358598532389273114U, (uint64_t)8683512038509439374U, (uint64_t)15415938252666293255U,
+    (uint64_t)13698695174800826869U, (uint64_t)10442832251048252285U, (uint64_t)10672604962207744524U, (uint64_t)14485711676978308040U,
+    (uint64_t)16947216143812808464U, (uint64_t)8342189264337602603U, (uint64_t)3837253281927274344U, (uint64_t)8331789856935110934U,
+    (uint64_t)524165018444839759U, (uint64_t)3157588572894920951U, (uint64_t)17599692088379947784U, (uint64_t)1421537803477597699U,
+    (uint64_t)2902517390503550285U, (uint64_t)7440776657136679901U, (uint64_t)17263207614729765269U, (uint64_t)16928425260420958311U,
+    (uint64_t)8487436533858443496U, (uint64_t)12386798851261442113U, (uint64_t)3224748875345095424U, (uint64_t)16166568617729909099U,
+    (uint64_t)2213369110503306004U, (uint64_t)6246347469485852131U, (uint64_t)3129440554298978074U, (uint64_t)605269941184323483U,
+    (uint64_t)16896703203004244996U, (uint64_t)11377226897030111200U, (uint64_t)2302364246994590389U, (uint64_t)4499255394192625779U,
+    (uint64_t)1906858144627445384U, (uint64_t)2670515414718439880U, (uint64_t)868537809054295101U, (uint64_t)7535366755622172814U,
+    (uint64_t)14754959387565938441U, (uint64_t)1023838193204581133U, (uint64_t)13599978343236540433U, (uint64_t)8323909593307920217U,
+    (uint64_t)3852032956982813055U, (uint64_t)7526785533690696419U, (uint64_t)8993798556223495105U, (uint64_t)18140648187477079959U,
+    (uint64_t)8267721299596412251U, (uint64_t)273633183929630283U, (uint64_t)17164190306640434032U, (uint64_t)16332882679719778825U,
+    (uint64_t)4663567915067622493U, (uint64_t)15521151801790569253U, (uint64_t)7273215397645141911U, (uint64_t)2324445691280731636U,
+    (uint64_t)10883262735810583709U, (uint64_t)17399134577381480315U, (uint64_t)12750035195491397119U, (uint64_t)13953097270363313998U,
+    (uint64_t)2485196748577282439U, (uint64_t)393430759246706702U, (uint64_t)3408702096065201083U, (uint64_t)16993508724217005008U,
+    (uint64_t)18350218749545913064U, (uint64_t)7509253999860752750U, (uint64_t)13295789896366834092U, (uint64_t)18326374111226872828U,
+    (uint64_t)3258048562491844971U, (uint64_t)6342797029666289605U, (uint64_t)9612474478300039361U, (uint64_t)17807494771134060923U,
+    (uint64_t)6209985515928007176U, (uint64_t)8422208926220809341U, (uint64_t)7866188125456775984U, (uint64_t)17071696982741312252U,
+    (uint64_t)17482363193291892153U, (uint64_t)1949968206030126177U, (uint64_t)8823961512355572132U, (uint64_t)13873010936602132387U,
+    (uint64_t)17651988839102959720U, (uint64_t)4019365809979531118U, (uint64_t)15024676458991206505U, (uint64_t)12622721674297982786U,
+    (uint64_t)243375780477240745U, (uint64_t)16572583194372185930U, (uint64_t)5189991834753707889U, (uint64_t)9498206494038386287U,
+    (uint64_t)11863354073576605599U, (uint64_t)8052916203396229040U, (uint64_t)16399182063316628399U, (uint64_t)10837704607074036270U,
+    (uint64_t)5444229620349428264U, (uint64_t)10866168931038804304U, (uint64_t)1298875461760659950U, (uint64_t)8904898233335519592U,
+    (uint64_t)300662505135603380U, (uint64_t)15234062183651308307U, (uint64_t)5319536121171934679U, (uint64_t)11496182741145732970U,
+    (uint64_t)10520610739189276272U, (uint64_t)4310163027157056344U, (uint64_t)3285324287508696251U, (uint64_t)3261468597637865009U,
+    (uint64_t)6799789383171367218U, (uint64_t)17419525584795621504U, (uint64_t)10685476378747845090U, (uint64_t)16314000862057872712U,
+    (uint64_t)11014509959317588121U, (uint64_t)10396318154903722147U, (uint64_t)9986284919279346079U, (uint64_t)4005974039875805723U,
+    (uint64_t)16354606995222167433U, (uint64_t)15941889353688553446U, (uint64_t)10301254747221876749U, (uint64_t)10704428461746587572U,
+    (uint64_t)15702361407127630489U, (uint64_t)3283718562982354984U, (uint64_t)18081088275079496700U, (uint64_t)17549094608770385733U,
+    (uint64_t)9733708529489298740U, (uint64_t)9641835701111156995U, (uint64_t)12396655702617590457U, (uint64_t)3741480190354960652U,
+    (uint64_t)7693418285144916465U, (uint64_t)6127658739224270319U, (uint64_t)17944980084636980596U, (uint64_t)12784667125636621252U,
+    (uint64_t)18236909425816665845U, (uint64_t)8371879876067489463U, (uint64_t)832674676726740168U, (uint64_t)14583794164604069153U,
+    (uint64_t)7294144266831096489U, (uint64_t)3547763435976020693U, (uint64_t)2658437775650683639U, (uint64_t)3146047337457285880U,
+    (uint64_t)19839336770832565U, (uint64_t)13129758233375247701U, (uint64_t)14228150705003681798U, (uint64_t)2838291994141496555U,
+    (uint64_t)11613451425702276022U, (uint64_t)16694239355419547728U, (uint64_t)17743827273977972268U, (uint64_t)6391559238203771048U,
+    (uint64_t)12238695301906022722U, (uint64_t)8023979763478270790U, (uint64_t)472635506060637796U, (uint64_t)6364682229778581164U,
+    (uint64_t)16345952438492409752U, (uint64_t)3370002479881291894U, (uint64_t)5167991601092262684U, (uint64_t)867999444742251528U,
+    (uint64_t)7083423656358063761U, (uint64_t)8061408927872919586U, (uint64_t)17206584109184197233U, (uint64_t)10957269231485411663U,
+    (uint64_t)13164262102864257679U, (uint64_t)13184654247431412295U, (uint64_t)14300954500064074190U, (uint64_t)17801602241737017979U,
+    (uint64_t)5760737229832617222U, (uint64_t)9279033389355660282U, (uint64_t)13247810612965431681U, (uint64_t)1701381935918487956U,
+    (uint64_t)13421202301132379756U, (uint64_t)5585255542439077288U, (uint64_t)11426139385685779224U, (uint64_t)5150252444293455264U,
+    (uint64_t)2225946777030064575U, (uint64_t)14236526291217944U, (uint64_t)1954151984466984792U, (uint64_t)16811793598126371448U,
+    (uint64_t)14359669784015774234U, (uint64_t)14205835821519156133U, (uint64_t)8588072976140209281U, (uint64_t)15508932559338333877U,
+    (uint64_t)2899320987984552087U, (uint64_t)748248076284082438U, (uint64_t)7719363191361958599U, (uint64_t)5446709526800075773U,
+    (uint64_t)2452022860431087118U, (uint64_t)11210671205133502995U, (uint64_t)324713620941149140U, (uint64_t)11222961949603921191U,
+    (uint64_t)2419852753413516499U, (uint64_t)18439712165680933129U, (uint64_t)18396308041503236391U, (uint64_t)12383744523756886827U,
+    (uint64_t)9474608418155203048U, (uint64_t)2743955683532888922U, (uint64_t)5582481749692223192U, (uint64_t)15245818880368048694U,
+    (uint64_t)5804273625770976457U, (uint64_t)16288324382921514815U, (uint64_t)15716977231849003220U, (uint64_t)15136244362230342723U,
+    (uint64_t)3966350377928105635U, (uint64_t)7057511273345998693U, (uint64_t)11071504012768975970U, (uint64_t)15506425146527534125U,
+    (uint64_t)10895780042171501965U, (uint64_t)6889451643481507449U, (uint64_t)10461452837283474649U, (uint64_t)17021972224072365232U,
+    (uint64_t)9229704406765449828U, (uint64_t)4447356787194139634U, (uint64_t)12778327131565318551U, (uint64_t)18132013651685954179U,
+    (uint64_t)2705462683166070403U, (uint64_t)3597995392206068710U, (uint64_t)1002911054197953729U, (uint64_t)6696435147827785949U,
+    (uint64_t)16912307176710089694U, (uint64_t)17182815358124795572U, (uint64_t)14037555560608766154U, (uint64_t)2731434548143125492U,
+    (uint64_t)4523921795472607784U, (uint64_t)2017307345833974569U, (uint64_t)468958081613475640U, (uint64_t)13921356731873463500U,
+    (uint64_t)13333455194934779481U, (uint64_t)6289283535587080234U, (uint64_t)14243520246028401153U, (uint64_t)15727914352390534694U,
+    (uint64_t)7625806751623195278U, (uint64_t)2378135708298666961U, (uint64_t)14670238199890148406U, (uint64_t)5488668705663308727U,
+    (uint64_t)11566625981099828996U, (uint64_t)8613975223290031082U, (uint64_t)7372945650744588280U, (uint64_t)11556880512160856715U,
+    (uint64_t)3920360499686671564U, (uint64_t)6437163537155510148U, (uint64_t)8200481334981735690U, (uint64_t)11045716518443890170U,
+    (uint64_t)15563024252279692137U, (uint64_t)5133072787058210061U, (uint64_t)13143056664834128802U, (uint64_t)944567901701790707U,
+    (uint64_t)13318227330225217509U, (uint64_t)260162047349722861U, (uint64_t)10791599091671550758U, (uint64_t)532449726402680461U,
+    (uint64_t)8105358743178213050U, (uint64_t)12436893988979376535U, (uint64_t)10574307406146375136U, (uint64_t)10414409216928619376U
+  };
+
+#if defined(__cplusplus)
+}
+#endif
+
+#define __Hacl_P256_PrecompTable_H_DEFINED
+#endif
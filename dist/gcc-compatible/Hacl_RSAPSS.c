@@ -24,6 +24,10 @@
 
 #include "Hacl_RSAPSS.h"
 
+#include "Hacl_Bignum256.h"
+#include "Hacl_Bignum_Vec256.h"
+#include "EverCrypt_AutoConfig2.h"
+
 static inline uint32_t hash_len(Spec_Hash_Definitions_hash_alg a)
 {
   switch (a)
@@ -379,6 +383,84 @@ load_skey(
   return b && m1 == (uint64_t)0xFFFFFFFFFFFFFFFFU;
 }
 
+static inline bool
+load_skey_crt(
+  uint32_t modBits,
+  uint32_t eBits,
+  uint32_t pBits,
+  uint8_t *nb,
+  uint8_t *eb,
+  uint8_t *pb,
+  uint8_t *qb,
+  uint8_t *dpb,
+  uint8_t *dqb,
+  uint8_t *qinvb,
+  uint64_t *skey
+)
+{
+  uint32_t pbLen = (pBits - (uint32_t)1U) / (uint32_t)8U + (uint32_t)1U;
+  uint32_t nLen = (modBits - (uint32_t)1U) / (uint32_t)64U + (uint32_t)1U;
+  uint32_t eLen = (eBits - (uint32_t)1U) / (uint32_t)64U + (uint32_t)1U;
+  uint32_t pLen = (pBits - (uint32_t)1U) / (uint32_t)64U + (uint32_t)1U;
+  uint32_t pkeyLen = nLen + nLen + eLen;
+  uint64_t *pkey = skey;
+  uint64_t *n = skey;
+  uint64_t *p = skey + pkeyLen;
+  uint64_t *r2_p = p + pLen;
+  uint64_t *q = p + (uint32_t)2U * pLen;
+  uint64_t *r2_q = p + (uint32_t)3U * pLen;
+  uint64_t *dp = p + (uint32_t)4U * pLen;
+  uint64_t *dq = p + (uint32_t)5U * pLen;
+  uint64_t *qinv = p + (uint32_t)6U * pLen;
+  bool b = load_pkey(modBits, eBits, nb, eb, pkey);
+  Hacl_Bignum_Convert_bn_from_bytes_be_uint64(pbLen, pb, p);
+  Hacl_Bignum_Convert_bn_from_bytes_be_uint64(pbLen, qb, q);
+  Hacl_Bignum_Convert_bn_from_bytes_be_uint64(pbLen, dpb, dp);
+  Hacl_Bignum_Convert_bn_from_bytes_be_uint64(pbLen, dqb, dq);
+  Hacl_Bignum_Convert_bn_from_bytes_be_uint64(pbLen, qinvb, qinv);
+  uint64_t m0 = check_modulus_u64(pBits, p);
+  uint64_t m1 = check_modulus_u64(pBits, q);
+  uint64_t m2 = check_exponent_u64(pBits, dp);
+  uint64_t m3 = check_exponent_u64(pBits, dq);
+  uint64_t acc = (uint64_t)0U;
+  for (uint32_t i = (uint32_t)0U; i < pLen; i++)
+  {
+    uint64_t beq = FStar_UInt64_eq_mask(qinv[i], p[i]);
+    uint64_t blt = ~FStar_UInt64_gte_mask(qinv[i], p[i]);
+    acc = (beq & acc) | (~beq & ((blt & (uint64_t)0xFFFFFFFFFFFFFFFFU) | (~blt & (uint64_t)0U)));
+  }
+  uint64_t m4 = acc;
+  KRML_CHECK_SIZE(sizeof (uint64_t), (uint32_t)4U * pLen);
+  uint64_t tmp[(uint32_t)4U * pLen];
+  memset(tmp, 0U, (uint32_t)4U * pLen * sizeof (uint64_t));
+  KRML_CHECK_SIZE(sizeof (uint64_t), pLen + pLen);
+  uint64_t pq[pLen + pLen];
+  memset(pq, 0U, (pLen + pLen) * sizeof (uint64_t));
+  Hacl_Bignum_Karatsuba_bn_karatsuba_mul_uint64(pLen, p, q, tmp, pq);
+  uint64_t mask = (uint64_t)0xFFFFFFFFFFFFFFFFU;
+  for (uint32_t i = (uint32_t)0U; i < pLen + pLen; i++)
+  {
+    uint64_t ni;
+    if (i < nLen)
+    {
+      ni = n[i];
+    }
+    else
+    {
+      ni = (uint64_t)0U;
+    }
+    uint64_t uu____0 = FStar_UInt64_eq_mask(pq[i], ni);
+    mask = uu____0 & mask;
+  }
+  uint64_t m5 = mask;
+  Hacl_Bignum_Montgomery_bn_precomp_r2_mod_n_u64(pLen, pBits - (uint32_t)1U, p, r2_p);
+  Hacl_Bignum_Montgomery_bn_precomp_r2_mod_n_u64(pLen, pBits - (uint32_t)1U, q, r2_q);
+  uint64_t mu_p = Hacl_Bignum_ModInvLimb_mod_inv_uint64(p[0U]);
+  Hacl_Bignum_Montgomery_bn_to_mont_u64(pLen, p, mu_p, r2_p, qinv, qinv);
+  uint64_t m = m0 & (m1 & (m2 & (m3 & (m4 & m5))));
+  return b && m == (uint64_t)0xFFFFFFFFFFFFFFFFU;
+}
+
 bool
 Hacl_RSAPSS_rsapss_sign(
   Spec_Hash_Definitions_hash_alg a,
@@ -809,3 +891,759 @@ Hacl_RSAPSS_rsapss_pkey_verify(
   return false;
 }
 
+bool
+Hacl_RSAPSS_rsapss_sign_crt(
+  Spec_Hash_Definitions_hash_alg a,
+  uint32_t modBits,
+  uint32_t eBits,
+  uint32_t pBits,
+  uint64_t *skey,
+  uint32_t saltLen,
+  uint8_t *salt,
+  uint32_t msgLen,
+  uint8_t *msg,
+  uint8_t *sgnt
+)
+{
+  uint32_t hLen = hash_len(a);
+  bool
+  b =
+    saltLen
+    <= (uint32_t)0xffffffffU - hLen - (uint32_t)8U
+    &&
+      saltLen
+      + hLen
+      + (uint32_t)2U
+      <= (modBits - (uint32_t)1U - (uint32_t)1U) / (uint32_t)8U + (uint32_t)1U;
+  if (b)
+  {
+    uint32_t nLen = (modBits - (uint32_t)1U) / (uint32_t)64U + (uint32_t)1U;
+    KRML_CHECK_SIZE(sizeof (uint64_t), nLen);
+    uint64_t m[nLen];
+    memset(m, 0U, nLen * sizeof (uint64_t));
+    uint32_t emBits = modBits - (uint32_t)1U;
+    uint32_t emLen = (emBits - (uint32_t)1U) / (uint32_t)8U + (uint32_t)1U;
+    KRML_CHECK_SIZE(sizeof (uint8_t), emLen);
+    uint8_t em[emLen];
+    memset(em, 0U, emLen * sizeof (uint8_t));
+    pss_encode(a, saltLen, salt, msgLen, msg, emBits, em);
+    Hacl_Bignum_Convert_bn_from_bytes_be_uint64(emLen, em, m);
+    uint32_t k = (modBits - (uint32_t)1U) / (uint32_t)8U + (uint32_t)1U;
+    KRML_CHECK_SIZE(sizeof (uint64_t), nLen);
+    uint64_t s[nLen];
+    memset(s, 0U, nLen * sizeof (uint64_t));
+    KRML_CHECK_SIZE(sizeof (uint64_t), nLen);
+    uint64_t m_[nLen];
+    memset(m_, 0U, nLen * sizeof (uint64_t));
+    uint32_t eLen = (eBits - (uint32_t)1U) / (uint32_t)64U + (uint32_t)1U;
+    uint32_t pLen = (pBits - (uint32_t)1U) / (uint32_t)64U + (uint32_t)1U;
+    uint64_t *n = skey;
+    uint64_t *r2 = skey + nLen;
+    uint64_t *e = skey + nLen + nLen;
+    uint64_t *p = skey + nLen + nLen + eLen;
+    uint64_t *r2_p = p + pLen;
+    uint64_t *q = p + (uint32_t)2U * pLen;
+    uint64_t *r2_q = p + (uint32_t)3U * pLen;
+    uint64_t *dp = p + (uint32_t)4U * pLen;
+    uint64_t *dq = p + (uint32_t)5U * pLen;
+    uint64_t *qinv = p + (uint32_t)6U * pLen;
+    uint64_t mu_p = Hacl_Bignum_ModInvLimb_mod_inv_uint64(p[0U]);
+    uint64_t mu_q = Hacl_Bignum_ModInvLimb_mod_inv_uint64(q[0U]);
+    KRML_CHECK_SIZE(sizeof (uint64_t), pLen + pLen);
+    uint64_t c[pLen + pLen];
+    memset(c, 0U, (pLen + pLen) * sizeof (uint64_t));
+    KRML_CHECK_SIZE(sizeof (uint64_t), (uint32_t)4U * pLen);
+    uint64_t tmp[(uint32_t)4U * pLen];
+    memset(tmp, 0U, (uint32_t)4U * pLen * sizeof (uint64_t));
+    KRML_CHECK_SIZE(sizeof (uint64_t), pLen);
+    uint64_t mp[pLen];
+    memset(mp, 0U, pLen * sizeof (uint64_t));
+    KRML_CHECK_SIZE(sizeof (uint64_t), pLen);
+    uint64_t mq[pLen];
+    memset(mq, 0U, pLen * sizeof (uint64_t));
+    KRML_CHECK_SIZE(sizeof (uint64_t), pLen);
+    uint64_t sp[pLen];
+    memset(sp, 0U, pLen * sizeof (uint64_t));
+    KRML_CHECK_SIZE(sizeof (uint64_t), pLen);
+    uint64_t sq[pLen];
+    memset(sq, 0U, pLen * sizeof (uint64_t));
+    KRML_CHECK_SIZE(sizeof (uint64_t), pLen);
+    uint64_t h[pLen];
+    memset(h, 0U, pLen * sizeof (uint64_t));
+    /* m mod p and m mod q: a Montgomery reduction followed by a conversion
+       back with R^2 mod p, valid since m < R^2 */
+    memcpy(c, m, nLen * sizeof (uint64_t));
+    Hacl_Bignum_Montgomery_bn_mont_reduction_u64(pLen, p, mu_p, c, mp);
+    Hacl_Bignum_Montgomery_bn_to_mont_u64(pLen, p, mu_p, r2_p, mp, mp);
+    memset(c, 0U, (pLen + pLen) * sizeof (uint64_t));
+    memcpy(c, m, nLen * sizeof (uint64_t));
+    Hacl_Bignum_Montgomery_bn_mont_reduction_u64(pLen, q, mu_q, c, mq);
+    Hacl_Bignum_Montgomery_bn_to_mont_u64(pLen, q, mu_q, r2_q, mq, mq);
+    Hacl_Bignum_Exponentiation_bn_mod_exp_consttime_precomp_u64(pLen,
+      p,
+      mu_p,
+      r2_p,
+      mp,
+      pBits,
+      dp,
+      sp);
+    Hacl_Bignum_Exponentiation_bn_mod_exp_consttime_precomp_u64(pLen,
+      q,
+      mu_q,
+      r2_q,
+      mq,
+      pBits,
+      dq,
+      sq);
+    /* Garner: s = sq + q * (qInv * (sp - sq) mod p), with qInv kept in Montgomery form */
+    memset(c, 0U, (pLen + pLen) * sizeof (uint64_t));
+    memcpy(c, sq, pLen * sizeof (uint64_t));
+    Hacl_Bignum_Montgomery_bn_mont_reduction_u64(pLen, p, mu_p, c, h);
+    Hacl_Bignum_Montgomery_bn_to_mont_u64(pLen, p, mu_p, r2_p, h, h);
+    Hacl_Bignum_bn_sub_mod_n_u64(pLen, p, sp, h, h);
+    Hacl_Bignum_Montgomery_bn_mont_mul_u64(pLen, p, mu_p, h, qinv, h);
+    memset(c, 0U, (pLen + pLen) * sizeof (uint64_t));
+    Hacl_Bignum_Karatsuba_bn_karatsuba_mul_uint64(pLen, q, h, tmp, c);
+    memset(tmp, 0U, (uint32_t)4U * pLen * sizeof (uint64_t));
+    memcpy(tmp, sq, pLen * sizeof (uint64_t));
+    uint64_t uu____0 = Hacl_Bignum_Addition_bn_add_eq_len_u64(pLen + pLen, c, tmp, c);
+    memcpy(s, c, nLen * sizeof (uint64_t));
+    /* Fault check: only release s if s^e = m mod n */
+    uint64_t mu = Hacl_Bignum_ModInvLimb_mod_inv_uint64(n[0U]);
+    Hacl_Bignum_Exponentiation_bn_mod_exp_vartime_precomp_u64(nLen, n, mu, r2, s, eBits, e, m_);
+    uint64_t mask = (uint64_t)0xFFFFFFFFFFFFFFFFU;
+    for (uint32_t i = (uint32_t)0U; i < nLen; i++)
+    {
+      uint64_t uu____1 = FStar_UInt64_eq_mask(m[i], m_[i]);
+      mask = uu____1 & mask;
+    }
+    uint64_t mask1 = mask;
+    uint64_t eq_m = mask1;
+    for (uint32_t i = (uint32_t)0U; i < nLen; i++)
+    {
+      uint64_t *os = s;
+      uint64_t x = s[i];
+      uint64_t x0 = eq_m & x;
+      os[i] = x0;
+    }
+    bool eq_b = eq_m == (uint64_t)0xFFFFFFFFFFFFFFFFU;
+    Hacl_Bignum_Convert_bn_to_bytes_be_uint64(k, s, sgnt);
+    return eq_b;
+  }
+  return false;
+}
+
+/*
+  Load a CRT private key. The returned buffer holds the public key (n, r2, e)
+  followed by p, r2_p, q, r2_q, dP, dQ and qInv, each of pLen limbs.
+
+  pb, qb, dPb, dQb and qInvb are big-endian and (pBits - 1) / 8 + 1 bytes long;
+  p and q must both have exactly pBits bits, and n must be p * q.
+*/
+uint64_t
+*Hacl_RSAPSS_new_rsapss_load_skey_crt(
+  uint32_t modBits,
+  uint32_t eBits,
+  uint32_t pBits,
+  uint8_t *nb,
+  uint8_t *eb,
+  uint8_t *pb,
+  uint8_t *qb,
+  uint8_t *dPb,
+  uint8_t *dQb,
+  uint8_t *qInvb
+)
+{
+  bool ite0;
+  if ((uint32_t)1U < modBits && (uint32_t)0U < eBits)
+  {
+    uint32_t nLen = (modBits - (uint32_t)1U) / (uint32_t)64U + (uint32_t)1U;
+    uint32_t eLen = (eBits - (uint32_t)1U) / (uint32_t)64U + (uint32_t)1U;
+    ite0 =
+      nLen
+      <= (uint32_t)33554431U
+      && eLen <= (uint32_t)67108863U
+      && nLen + nLen <= (uint32_t)0xffffffffU - eLen;
+  }
+  else
+  {
+    ite0 = false;
+  }
+  bool ite;
+  if (ite0 && (uint32_t)1U < pBits && pBits < modBits)
+  {
+    uint32_t nLen = (modBits - (uint32_t)1U) / (uint32_t)64U + (uint32_t)1U;
+    uint32_t eLen = (eBits - (uint32_t)1U) / (uint32_t)64U + (uint32_t)1U;
+    uint32_t pLen = (pBits - (uint32_t)1U) / (uint32_t)64U + (uint32_t)1U;
+    ite = nLen <= (uint32_t)2U * pLen && (uint32_t)7U * pLen <= (uint32_t)0xffffffffU - nLen - nLen - eLen;
+  }
+  else
+  {
+    ite = false;
+  }
+  if (!ite)
+  {
+    return NULL;
+  }
+  uint32_t nLen = (modBits - (uint32_t)1U) / (uint32_t)64U + (uint32_t)1U;
+  uint32_t eLen = (eBits - (uint32_t)1U) / (uint32_t)64U + (uint32_t)1U;
+  uint32_t pLen = (pBits - (uint32_t)1U) / (uint32_t)64U + (uint32_t)1U;
+  uint32_t skeyLen = nLen + nLen + eLen + (uint32_t)7U * pLen;
+  KRML_CHECK_SIZE(sizeof (uint64_t), skeyLen);
+  uint64_t *skey = KRML_HOST_CALLOC(skeyLen, sizeof (uint64_t));
+  if (skey == NULL)
+  {
+    return skey;
+  }
+  bool b = load_skey_crt(modBits, eBits, pBits, nb, eb, pb, qb, dPb, dQb, qInvb, skey);
+  if (b)
+  {
+    return skey;
+  }
+  Lib_Memzero0_memzero(skey, skeyLen * sizeof (skey[0U]));
+  KRML_HOST_FREE(skey);
+  return NULL;
+}
+
+bool
+Hacl_RSAPSS_rsapss_skey_sign_crt(
+  Spec_Hash_Definitions_hash_alg a,
+  uint32_t modBits,
+  uint32_t eBits,
+  uint32_t pBits,
+  uint8_t *nb,
+  uint8_t *eb,
+  uint8_t *pb,
+  uint8_t *qb,
+  uint8_t *dPb,
+  uint8_t *dQb,
+  uint8_t *qInvb,
+  uint32_t saltLen,
+  uint8_t *salt,
+  uint32_t msgLen,
+  uint8_t *msg,
+  uint8_t *sgnt
+)
+{
+  uint32_t nLen = (modBits - (uint32_t)1U) / (uint32_t)64U + (uint32_t)1U;
+  uint32_t pLen = (pBits - (uint32_t)1U) / (uint32_t)64U + (uint32_t)1U;
+  if (!((uint32_t)1U < pBits && pBits < modBits && nLen <= (uint32_t)2U * pLen))
+  {
+    return false;
+  }
+  uint32_t skeyLen =
+    (uint32_t)2U
+    * nLen
+    + (eBits - (uint32_t)1U) / (uint32_t)64U + (uint32_t)1U
+    + (uint32_t)7U * pLen;
+  KRML_CHECK_SIZE(sizeof (uint64_t), skeyLen);
+  uint64_t skey[skeyLen];
+  memset(skey, 0U, skeyLen * sizeof (uint64_t));
+  bool b = load_skey_crt(modBits, eBits, pBits, nb, eb, pb, qb, dPb, dQb, qInvb, skey);
+  bool res = false;
+  if (b)
+  {
+    res =
+      Hacl_RSAPSS_rsapss_sign_crt(a,
+        modBits,
+        eBits,
+        pBits,
+        skey,
+        saltLen,
+        salt,
+        msgLen,
+        msg,
+        sgnt);
+  }
+  Lib_Memzero0_memzero(skey, skeyLen * sizeof (skey[0U]));
+  return res;
+}
+
+static inline void
+ctx_amont_mul(Hacl_Bignum_MontArithmetic_bn_mont_ctx_u64 k, uint64_t *aM, uint64_t *bM, uint64_t *resM)
+{
+  #if HACL_CAN_COMPILE_INLINE_ASM
+  if (Hacl_Bignum_Montgomery_has_adx_bmi2())
+  {
+    Hacl_Bignum_Montgomery_bn_almost_mont_mul_adx_u64(k.len, k.n, k.mu, aM, bM, resM);
+    return;
+  }
+  #endif
+  Hacl_Bignum_Montgomery_bn_mont_mul_u64(k.len, k.n, k.mu, aM, bM, resM);
+}
+
+static inline void
+ctx_amont_sqr(Hacl_Bignum_MontArithmetic_bn_mont_ctx_u64 k, uint64_t *aM, uint64_t *resM)
+{
+  #if HACL_CAN_COMPILE_INLINE_ASM
+  if (Hacl_Bignum_Montgomery_has_adx_bmi2())
+  {
+    Hacl_Bignum_Montgomery_bn_almost_mont_sqr_adx_u64(k.len, k.n, k.mu, aM, resM);
+    return;
+  }
+  #endif
+  Hacl_Bignum_Montgomery_bn_mont_sqr_u64(k.len, k.n, k.mu, aM, resM);
+}
+
+/*
+  Variable-time a ^ b mod n for a public exponent. Small exponents use a
+  left-to-right square-and-multiply starting from the top set bit of b, so
+  e = 65537 costs 16 squarings and one multiplication.
+*/
+static inline void
+bn_mod_exp_ctx_u64(
+  Hacl_Bignum_MontArithmetic_bn_mont_ctx_u64 k,
+  uint64_t *a,
+  uint32_t bBits,
+  uint64_t *b,
+  uint64_t *res
+)
+{
+  if (bBits < (uint32_t)200U)
+  {
+    uint32_t top = (uint32_t)0U;
+    for (uint32_t i = (uint32_t)0U; i < bBits; i++)
+    {
+      uint64_t bit = b[i / (uint32_t)64U] >> i % (uint32_t)64U & (uint64_t)1U;
+      if (!(bit == (uint64_t)0U))
+      {
+        top = i + (uint32_t)1U;
+      }
+    }
+    if (top == (uint32_t)0U)
+    {
+      memset(res, 0U, k.len * sizeof (uint64_t));
+      res[0U] = (uint64_t)1U;
+      return;
+    }
+    KRML_CHECK_SIZE(sizeof (uint64_t), k.len);
+    uint64_t aM[k.len];
+    memset(aM, 0U, k.len * sizeof (uint64_t));
+    KRML_CHECK_SIZE(sizeof (uint64_t), k.len);
+    uint64_t resM[k.len];
+    memset(resM, 0U, k.len * sizeof (uint64_t));
+    Hacl_Bignum_Montgomery_bn_to_mont_u64(k.len, k.n, k.mu, k.r2, a, aM);
+    memcpy(resM, aM, k.len * sizeof (uint64_t));
+    for (uint32_t i0 = (uint32_t)0U; i0 < top - (uint32_t)1U; i0++)
+    {
+      uint32_t i = top - i0 - (uint32_t)2U;
+      ctx_amont_sqr(k, resM, resM);
+      uint64_t bit = b[i / (uint32_t)64U] >> i % (uint32_t)64U & (uint64_t)1U;
+      if (!(bit == (uint64_t)0U))
+      {
+        ctx_amont_mul(k, resM, aM, resM);
+      }
+    }
+    Hacl_Bignum_Montgomery_bn_from_mont_u64(k.len, k.n, k.mu, resM, res);
+    return;
+  }
+  Hacl_Bignum_Exponentiation_bn_mod_exp_vartime_precomp_u64(k.len, k.n, k.mu, k.r2, a, bBits, b, res);
+}
+
+static inline Hacl_Bignum_MontArithmetic_bn_mont_ctx_u64 ctx_mont(Hacl_RSAPSS_pkey_ctx *ctx)
+{
+  return
+    (
+      (Hacl_Bignum_MontArithmetic_bn_mont_ctx_u64){
+        .len = ctx->nLen,
+        .n = ctx->pkey,
+        .mu = ctx->mu,
+        .r2 = ctx->pkey + ctx->nLen
+      }
+    );
+}
+
+/*
+  Load a public key into a context that keeps the Montgomery constants
+  (r2 and mu) of the modulus, for keys that verify many signatures.
+  The context is freed with Hacl_RSAPSS_pkey_ctx_free, which accepts NULL.
+*/
+Hacl_RSAPSS_pkey_ctx
+*Hacl_RSAPSS_new_rsapss_load_pkey_ctx(uint32_t modBits, uint32_t eBits, uint8_t *nb, uint8_t *eb)
+{
+  uint64_t *pkey = Hacl_RSAPSS_new_rsapss_load_pkey(modBits, eBits, nb, eb);
+  if (pkey == NULL)
+  {
+    return NULL;
+  }
+  Hacl_RSAPSS_pkey_ctx *ctx = KRML_HOST_MALLOC(sizeof (Hacl_RSAPSS_pkey_ctx));
+  if (ctx == NULL)
+  {
+    KRML_HOST_FREE(pkey);
+    return NULL;
+  }
+  uint32_t nLen = (modBits - (uint32_t)1U) / (uint32_t)64U + (uint32_t)1U;
+  ctx->modBits = modBits;
+  ctx->eBits = eBits;
+  ctx->pkey = pkey;
+  ctx->nLen = nLen;
+  ctx->mu = Hacl_Bignum_ModInvLimb_mod_inv_uint64(pkey[0U]);
+  return ctx;
+}
+
+void Hacl_RSAPSS_pkey_ctx_free(Hacl_RSAPSS_pkey_ctx *ctx)
+{
+  if (ctx == NULL)
+  {
+    return;
+  }
+  KRML_HOST_FREE(ctx->pkey);
+  KRML_HOST_FREE(ctx);
+}
+
+static inline bool
+verify_em(
+  Spec_Hash_Definitions_hash_alg a,
+  uint32_t modBits,
+  uint64_t *m,
+  uint32_t saltLen,
+  uint32_t msgLen,
+  uint8_t *msg
+)
+{
+  if ((modBits - (uint32_t)1U) % (uint32_t)8U == (uint32_t)0U)
+  {
+    uint32_t i = (modBits - (uint32_t)1U) / (uint32_t)64U;
+    uint32_t j = (modBits - (uint32_t)1U) % (uint32_t)64U;
+    if (!((m[i] >> j & (uint64_t)1U) == (uint64_t)0U))
+    {
+      return false;
+    }
+  }
+  uint32_t emBits = modBits - (uint32_t)1U;
+  uint32_t emLen = (emBits - (uint32_t)1U) / (uint32_t)8U + (uint32_t)1U;
+  KRML_CHECK_SIZE(sizeof (uint8_t), emLen);
+  uint8_t em[emLen];
+  memset(em, 0U, emLen * sizeof (uint8_t));
+  Hacl_Bignum_Convert_bn_to_bytes_be_uint64(emLen, m, em);
+  return pss_verify(a, saltLen, msgLen, msg, emBits, em);
+}
+
+/*
+  Decode sgnt into s and check that it is a well-formed signature
+  representative for ctx, i.e. that it has the right length and s < n.
+*/
+static inline bool
+load_sgnt_ctx(
+  Spec_Hash_Definitions_hash_alg a,
+  Hacl_RSAPSS_pkey_ctx *ctx,
+  uint32_t saltLen,
+  uint32_t sgntLen,
+  uint8_t *sgnt,
+  uint64_t *s
+)
+{
+  uint32_t modBits = ctx->modBits;
+  uint32_t hLen = hash_len(a);
+  bool
+  b =
+    saltLen
+    <= (uint32_t)0xffffffffU - hLen - (uint32_t)8U
+    && sgntLen == (modBits - (uint32_t)1U) / (uint32_t)8U + (uint32_t)1U;
+  if (!b)
+  {
+    return false;
+  }
+  uint32_t nLen = ctx->nLen;
+  memset(s, 0U, nLen * sizeof (uint64_t));
+  Hacl_Bignum_Convert_bn_from_bytes_be_uint64(sgntLen, sgnt, s);
+  uint64_t acc = (uint64_t)0U;
+  for (uint32_t i = (uint32_t)0U; i < nLen; i++)
+  {
+    uint64_t beq = FStar_UInt64_eq_mask(s[i], ctx->pkey[i]);
+    uint64_t blt = ~FStar_UInt64_gte_mask(s[i], ctx->pkey[i]);
+    acc = (beq & acc) | (~beq & ((blt & (uint64_t)0xFFFFFFFFFFFFFFFFU) | (~blt & (uint64_t)0U)));
+  }
+  return acc == (uint64_t)0xFFFFFFFFFFFFFFFFU;
+}
+
+bool
+Hacl_RSAPSS_rsapss_verify_ctx(
+  Spec_Hash_Definitions_hash_alg a,
+  Hacl_RSAPSS_pkey_ctx *ctx,
+  uint32_t saltLen,
+  uint32_t sgntLen,
+  uint8_t *sgnt,
+  uint32_t msgLen,
+  uint8_t *msg
+)
+{
+  uint32_t nLen = ctx->nLen;
+  KRML_CHECK_SIZE(sizeof (uint64_t), nLen);
+  uint64_t m[nLen];
+  memset(m, 0U, nLen * sizeof (uint64_t));
+  KRML_CHECK_SIZE(sizeof (uint64_t), nLen);
+  uint64_t s[nLen];
+  memset(s, 0U, nLen * sizeof (uint64_t));
+  if (!load_sgnt_ctx(a, ctx, saltLen, sgntLen, sgnt, s))
+  {
+    return false;
+  }
+  bn_mod_exp_ctx_u64(ctx_mont(ctx), s, ctx->eBits, ctx->pkey + nLen + nLen, m);
+  return verify_em(a, ctx->modBits, m, saltLen, msgLen, msg);
+}
+
+/*
+  Load a private key (n, e, d) into a context. The public half is a
+  Hacl_RSAPSS_pkey_ctx sharing the key buffer, so &ctx->pkey can be passed
+  to Hacl_RSAPSS_rsapss_verify_ctx. The context is freed, and the private
+  exponent wiped, with Hacl_RSAPSS_skey_ctx_free, which accepts NULL.
+*/
+Hacl_RSAPSS_skey_ctx
+*Hacl_RSAPSS_new_rsapss_load_skey_ctx(
+  uint32_t modBits,
+  uint32_t eBits,
+  uint32_t dBits,
+  uint8_t *nb,
+  uint8_t *eb,
+  uint8_t *db
+)
+{
+  uint64_t *skey = Hacl_RSAPSS_new_rsapss_load_skey(modBits, eBits, dBits, nb, eb, db);
+  if (skey == NULL)
+  {
+    return NULL;
+  }
+  uint32_t nLen = (modBits - (uint32_t)1U) / (uint32_t)64U + (uint32_t)1U;
+  uint32_t eLen = (eBits - (uint32_t)1U) / (uint32_t)64U + (uint32_t)1U;
+  uint32_t dLen = (dBits - (uint32_t)1U) / (uint32_t)64U + (uint32_t)1U;
+  Hacl_RSAPSS_skey_ctx *ctx = KRML_HOST_MALLOC(sizeof (Hacl_RSAPSS_skey_ctx));
+  if (ctx == NULL)
+  {
+    Lib_Memzero0_memzero(skey, (nLen + nLen + eLen + dLen) * sizeof (skey[0U]));
+    KRML_HOST_FREE(skey);
+    return NULL;
+  }
+  ctx->pkey.modBits = modBits;
+  ctx->pkey.eBits = eBits;
+  ctx->pkey.pkey = skey;
+  ctx->pkey.nLen = nLen;
+  ctx->pkey.mu = Hacl_Bignum_ModInvLimb_mod_inv_uint64(skey[0U]);
+  ctx->dBits = dBits;
+  ctx->skey = skey;
+  return ctx;
+}
+
+void Hacl_RSAPSS_skey_ctx_free(Hacl_RSAPSS_skey_ctx *ctx)
+{
+  if (ctx == NULL)
+  {
+    return;
+  }
+  uint32_t nLen = ctx->pkey.nLen;
+  uint32_t eLen = (ctx->pkey.eBits - (uint32_t)1U) / (uint32_t)64U + (uint32_t)1U;
+  uint32_t dLen = (ctx->dBits - (uint32_t)1U) / (uint32_t)64U + (uint32_t)1U;
+  Lib_Memzero0_memzero(ctx->skey, (nLen + nLen + eLen + dLen) * sizeof (ctx->skey[0U]));
+  KRML_HOST_FREE(ctx->skey);
+  KRML_HOST_FREE(ctx);
+}
+
+/*
+  Same as Hacl_RSAPSS_rsapss_sign, but the private exponentiation reuses the
+  cached mu and r2 of the context, and the fault check recomputes s ^ e with
+  the short public-exponent chain of Hacl_RSAPSS_rsapss_verify_ctx.
+*/
+bool
+Hacl_RSAPSS_rsapss_sign_ctx(
+  Spec_Hash_Definitions_hash_alg a,
+  Hacl_RSAPSS_skey_ctx *ctx,
+  uint32_t saltLen,
+  uint8_t *salt,
+  uint32_t msgLen,
+  uint8_t *msg,
+  uint8_t *sgnt
+)
+{
+  uint32_t modBits = ctx->pkey.modBits;
+  uint32_t hLen = hash_len(a);
+  bool
+  b =
+    saltLen
+    <= (uint32_t)0xffffffffU - hLen - (uint32_t)8U
+    &&
+      saltLen
+      + hLen
+      + (uint32_t)2U
+      <= (modBits - (uint32_t)1U - (uint32_t)1U) / (uint32_t)8U + (uint32_t)1U;
+  if (!b)
+  {
+    return false;
+  }
+  Hacl_Bignum_MontArithmetic_bn_mont_ctx_u64 k = ctx_mont(&ctx->pkey);
+  uint32_t nLen = k.len;
+  uint32_t eLen = (ctx->pkey.eBits - (uint32_t)1U) / (uint32_t)64U + (uint32_t)1U;
+  uint64_t *e = ctx->skey + nLen + nLen;
+  uint64_t *d = ctx->skey + nLen + nLen + eLen;
+  KRML_CHECK_SIZE(sizeof (uint64_t), nLen);
+  uint64_t m[nLen];
+  memset(m, 0U, nLen * sizeof (uint64_t));
+  uint32_t emBits = modBits - (uint32_t)1U;
+  uint32_t emLen = (emBits - (uint32_t)1U) / (uint32_t)8U + (uint32_t)1U;
+  KRML_CHECK_SIZE(sizeof (uint8_t), emLen);
+  uint8_t em[emLen];
+  memset(em, 0U, emLen * sizeof (uint8_t));
+  pss_encode(a, saltLen, salt, msgLen, msg, emBits, em);
+  Hacl_Bignum_Convert_bn_from_bytes_be_uint64(emLen, em, m);
+  KRML_CHECK_SIZE(sizeof (uint64_t), nLen);
+  uint64_t s[nLen];
+  memset(s, 0U, nLen * sizeof (uint64_t));
+  KRML_CHECK_SIZE(sizeof (uint64_t), nLen);
+  uint64_t m_[nLen];
+  memset(m_, 0U, nLen * sizeof (uint64_t));
+  Hacl_Bignum_Exponentiation_bn_mod_exp_consttime_precomp_u64(nLen,
+    k.n,
+    k.mu,
+    k.r2,
+    m,
+    ctx->dBits,
+    d,
+    s);
+  bn_mod_exp_ctx_u64(k, s, ctx->pkey.eBits, e, m_);
+  uint64_t mask = (uint64_t)0xFFFFFFFFFFFFFFFFU;
+  for (uint32_t i = (uint32_t)0U; i < nLen; i++)
+  {
+    uint64_t uu____0 = FStar_UInt64_eq_mask(m[i], m_[i]);
+    mask = uu____0 & mask;
+  }
+  for (uint32_t i = (uint32_t)0U; i < nLen; i++)
+  {
+    s[i] = mask & s[i];
+  }
+  Hacl_Bignum_Convert_bn_to_bytes_be_uint64((modBits - (uint32_t)1U) / (uint32_t)8U + (uint32_t)1U,
+    s,
+    sgnt);
+  return mask == (uint64_t)0xFFFFFFFFFFFFFFFFU;
+}
+
+/*
+  Verify the cnt <= 4 signatures idx[0..cnt), whose moduli all have nLen limbs,
+  sharing one vec256 exponentiation when there is more than one.
+*/
+static inline void
+verify_batch_group(
+  Spec_Hash_Definitions_hash_alg a,
+  uint32_t nLen,
+  uint32_t cnt0,
+  uint32_t *idx0,
+  Hacl_RSAPSS_pkey_ctx **ctx,
+  uint32_t *saltLen,
+  uint32_t *sgntLen,
+  uint8_t **sgnt,
+  uint32_t *msgLen,
+  uint8_t **msg,
+  bool *res
+)
+{
+  KRML_CHECK_SIZE(sizeof (uint64_t), (uint32_t)8U * nLen);
+  uint64_t sm[(uint32_t)8U * nLen];
+  memset(sm, 0U, (uint32_t)8U * nLen * sizeof (uint64_t));
+  uint32_t idx[4U] = { 0U };
+  uint32_t cnt = (uint32_t)0U;
+  for (uint32_t j = (uint32_t)0U; j < cnt0; j++)
+  {
+    uint32_t i = idx0[j];
+    if (load_sgnt_ctx(a, ctx[i], saltLen[i], sgntLen[i], sgnt[i], sm + cnt * nLen))
+    {
+      idx[cnt] = i;
+      cnt++;
+    }
+  }
+  uint64_t *s = sm;
+  uint64_t *m = sm + (uint32_t)4U * nLen;
+  if (cnt == (uint32_t)1U)
+  {
+    Hacl_RSAPSS_pkey_ctx *c = ctx[idx[0U]];
+    bn_mod_exp_ctx_u64(ctx_mont(c), s, c->eBits, c->pkey + nLen + nLen, m);
+  }
+  #if HACL_CAN_COMPILE_VEC256
+  if (cnt > (uint32_t)1U)
+  {
+    uint64_t *nv[4U] = { 0U };
+    uint64_t *r2v[4U] = { 0U };
+    uint64_t *sv[4U] = { 0U };
+    uint32_t eBits[4U] = { 0U };
+    uint64_t *ev[4U] = { 0U };
+    uint64_t *mv[4U] = { 0U };
+    for (uint32_t j = (uint32_t)0U; j < (uint32_t)4U; j++)
+    {
+      /* unused lanes repeat the first signature */
+      uint32_t j0 = j < cnt ? j : (uint32_t)0U;
+      Hacl_RSAPSS_pkey_ctx *c = ctx[idx[j0]];
+      nv[j] = c->pkey;
+      r2v[j] = c->pkey + nLen;
+      sv[j] = s + j0 * nLen;
+      eBits[j] = c->eBits;
+      ev[j] = c->pkey + nLen + nLen;
+      mv[j] = m + j * nLen;
+    }
+    Hacl_Bignum_Vec256_bn_mod_exp_vartime_x4(nLen, nv, r2v, sv, eBits, ev, mv);
+  }
+  #endif
+  for (uint32_t j = (uint32_t)0U; j < cnt; j++)
+  {
+    uint32_t i = idx[j];
+    res[i] = verify_em(a, ctx[i]->modBits, m + j * nLen, saltLen[i], msgLen[i], msg[i]);
+  }
+}
+
+/*
+  Verify k independent signatures: res[i] is set to the result of
+  Hacl_RSAPSS_rsapss_verify_ctx(a, ctx[i], saltLen[i], sgntLen[i], sgnt[i],
+  msgLen[i], msg[i]), and the function returns true iff all of them hold.
+
+  When AVX2 is available, runs of consecutive signatures whose moduli have the
+  same number of limbs are grouped by four and their exponentiations run in
+  the four lanes of a vec256, sharing one squaring chain. Keys, exponents and
+  salt lengths may all differ within a batch; callers mixing key sizes should
+  order the batch by modulus size to get full groups.
+*/
+bool
+Hacl_RSAPSS_rsapss_verify_batch(
+  Spec_Hash_Definitions_hash_alg a,
+  uint32_t k,
+  Hacl_RSAPSS_pkey_ctx **ctx,
+  uint32_t *saltLen,
+  uint32_t *sgntLen,
+  uint8_t **sgnt,
+  uint32_t *msgLen,
+  uint8_t **msg,
+  bool *res
+)
+{
+  if (k == (uint32_t)0U)
+  {
+    return true;
+  }
+  uint32_t lanes = (uint32_t)1U;
+  #if HACL_CAN_COMPILE_VEC256
+  if (EverCrypt_AutoConfig2_has_vec256())
+  {
+    lanes = (uint32_t)4U;
+  }
+  #endif
+  for (uint32_t i = (uint32_t)0U; i < k; i++)
+  {
+    res[i] = false;
+  }
+  uint32_t idx[4U] = { 0U };
+  uint32_t cnt = (uint32_t)0U;
+  uint32_t nLen = ctx[0U]->nLen;
+  for (uint32_t i = (uint32_t)0U; i < k; i++)
+  {
+    if (cnt == lanes || (cnt > (uint32_t)0U && ctx[i]->nLen != nLen))
+    {
+      verify_batch_group(a, nLen, cnt, idx, ctx, saltLen, sgntLen, sgnt, msgLen, msg, res);
+      cnt = (uint32_t)0U;
+    }
+    nLen = ctx[i]->nLen;
+    idx[cnt] = i;
+    cnt++;
+  }
+  verify_batch_group(a, nLen, cnt, idx, ctx, saltLen, sgntLen, sgnt, msgLen, msg, res);
+  bool ok = true;
+  for (uint32_t i = (uint32_t)0U; i < k; i++)
+  {
+    ok = ok && res[i];
+  }
+  return ok;
+}
@@ -41,6 +41,7 @@ extern "C" {
 #include "Hacl_Bignum.h"
 #include "Hacl_Hash.h"
 #include "Hacl_Spec.h"
+#include "Lib_Memzero0.h"
 
 bool
 Hacl_RSAPSS_rsapss_sign(
@@ -112,6 +113,158 @@ Hacl_RSAPSS_rsapss_pkey_verify(
   uint8_t *msg
 );
 
+bool
+Hacl_RSAPSS_rsapss_sign_crt(
+  Spec_Hash_Definitions_hash_alg a,
+  uint32_t modBits,
+  uint32_t eBits,
+  uint32_t pBits,
+  uint64_t *skey,
+  uint32_t saltLen,
+  uint8_t *salt,
+  uint32_t msgLen,
+  uint8_t *msg,
+  uint8_t *sgnt
+);
+
+/*
+  Load a CRT private key. The returned buffer holds the public key (n, r2, e)
+  followed by p, r2_p, q, r2_q, dP, dQ and qInv, each of pLen limbs.
+
+  pb, qb, dPb, dQb and qInvb are big-endian and (pBits - 1) / 8 + 1 bytes long;
+  p and q must both have exactly pBits bits, and n must be p * q.
+*/
+uint64_t
+*Hacl_RSAPSS_new_rsapss_load_skey_crt(
+  uint32_t modBits,
+  uint32_t eBits,
+  uint32_t pBits,
+  uint8_t *nb,
+  uint8_t *eb,
+  uint8_t *pb,
+  uint8_t *qb,
+  uint8_t *dPb,
+  uint8_t *dQb,
+  uint8_t *qInvb
+);
+
+bool
+Hacl_RSAPSS_rsapss_skey_sign_crt(
+  Spec_Hash_Definitions_hash_alg a,
+  uint32_t modBits,
+  uint32_t eBits,
+  uint32_t pBits,
+  uint8_t *nb,
+  uint8_t *eb,
+  uint8_t *pb,
+  uint8_t *qb,
+  uint8_t *dPb,
+  uint8_t *dQb,
+  uint8_t *qInvb,
+  uint32_t saltLen,
+  uint8_t *salt,
+  uint32_t msgLen,
+  uint8_t *msg,
+  uint8_t *sgnt
+);
+
+typedef struct Hacl_RSAPSS_pkey_ctx_s
+{
+  uint32_t modBits;
+  uint32_t eBits;
+  uint64_t *pkey;
+  uint32_t nLen;
+  uint64_t mu;
+}
+Hacl_RSAPSS_pkey_ctx;
+
+typedef struct Hacl_RSAPSS_skey_ctx_s
+{
+  Hacl_RSAPSS_pkey_ctx pkey;
+  uint32_t dBits;
+  uint64_t *skey;
+}
+Hacl_RSAPSS_skey_ctx;
+
+/*
+  Load a public key into a context that keeps the Montgomery constants
+  (r2 and mu) of the modulus, for keys that verify many signatures.
+  The context is freed with Hacl_RSAPSS_pkey_ctx_free, which accepts NULL.
+*/
+Hacl_RSAPSS_pkey_ctx
+*Hacl_RSAPSS_new_rsapss_load_pkey_ctx(uint32_t modBits, uint32_t eBits, uint8_t *nb, uint8_t *eb);
+
+void Hacl_RSAPSS_pkey_ctx_free(Hacl_RSAPSS_pkey_ctx *ctx);
+
+bool
+Hacl_RSAPSS_rsapss_verify_ctx(
+  Spec_Hash_Definitions_hash_alg a,
+  Hacl_RSAPSS_pkey_ctx *ctx,
+  uint32_t saltLen,
+  uint32_t sgntLen,
+  uint8_t *sgnt,
+  uint32_t msgLen,
+  uint8_t *msg
+);
+
+/*
+  Load a private key (n, e, d) into a context. The public half is a
+  Hacl_RSAPSS_pkey_ctx sharing the key buffer, so &ctx->pkey can be passed
+  to Hacl_RSAPSS_rsapss_verify_ctx. The context is freed, and the private
+  exponent wiped, with Hacl_RSAPSS_skey_ctx_free, which accepts NULL.
+*/
+Hacl_RSAPSS_skey_ctx
+*Hacl_RSAPSS_new_rsapss_load_skey_ctx(
+  uint32_t modBits,
+  uint32_t eBits,
+  uint32_t dBits,
+  uint8_t *nb,
+  uint8_t *eb,
+  uint8_t *db
+);
+
+void Hacl_RSAPSS_skey_ctx_free(Hacl_RSAPSS_skey_ctx *ctx);
+
+/*
+  Same as Hacl_RSAPSS_rsapss_sign, but the private exponentiation reuses the
+  cached mu and r2 of the context, and the fault check recomputes s ^ e with
+  the short public-exponent chain of Hacl_RSAPSS_rsapss_verify_ctx.
+*/
+bool
+Hacl_RSAPSS_rsapss_sign_ctx(
+  Spec_Hash_Definitions_hash_alg a,
+  Hacl_RSAPSS_skey_ctx *ctx,
+  uint32_t saltLen,
+  uint8_t *salt,
+  uint32_t msgLen,
+  uint8_t *msg,
+  uint8_t *sgnt
+);
+
+/*
+  Verify k independent signatures: res[i] is set to the result of
+  Hacl_RSAPSS_rsapss_verify_ctx(a, ctx[i], saltLen[i], sgntLen[i], sgnt[i],
+  msgLen[i], msg[i]), and the function returns true iff all of them hold.
+
+  When AVX2 is available, runs of consecutive signatures whose moduli have the
+  same number of limbs are grouped by four and their exponentiations run in
+  the four lanes of a vec256, sharing one squaring chain. Keys, exponents and
+  salt lengths may all differ within a batch; callers mixing key sizes should
+  order the batch by modulus size to get full groups.
+*/
+bool
+Hacl_RSAPSS_rsapss_verify_batch(
+  Spec_Hash_Definitions_hash_alg a,
+  uint32_t k,
+  Hacl_RSAPSS_pkey_ctx **ctx,
+  uint32_t *saltLen,
+  uint32_t *sgntLen,
+  uint8_t **sgnt,
+  uint32_t *msgLen,
+  uint8_t **msg,
+  bool *res
+);
+
 #if defined(__cplusplus)
 }
 #endif
@@ -0,0 +1,283 @@
+/* MIT License
+ *
+ * Copyright (c) 2016-2020 INRIA, CMU and Microsoft Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "Hacl_SHA2_Vec128.h"
+
+static const
+uint32_t
+k224_256[64U] =
+  {
+    (uint32_t)0x428a2f98U, (uint32_t)0x71374491U, (uint32_t)0xb5c0fbcfU, (uint32_t)0xe9b5dba5U,
+    (uint32_t)0x3956c25bU, (uint32_t)0x59f111f1U, (uint32_t)0x923f82a4U, (uint32_t)0xab1c5ed5U,
+    (uint32_t)0xd807aa98U, (uint32_t)0x12835b01U, (uint32_t)0x243185beU, (uint32_t)0x550c7dc3U,
+    (uint32_t)0x72be5d74U, (uint32_t)0x80deb1feU, (uint32_t)0x9bdc06a7U, (uint32_t)0xc19bf174U,
+    (uint32_t)0xe49b69c1U, (uint32_t)0xefbe4786U, (uint32_t)0x0fc19dc6U, (uint32_t)0x240ca1ccU,
+    (uint32_t)0x2de92c6fU, (uint32_t)0x4a7484aaU, (uint32_t)0x5cb0a9dcU, (uint32_t)0x76f988daU,
+    (uint32_t)0x983e5152U, (uint32_t)0xa831c66dU, (uint32_t)0xb00327c8U, (uint32_t)0xbf597fc7U,
+    (uint32_t)0xc6e00bf3U, (uint32_t)0xd5a79147U, (uint32_t)0x06ca6351U, (uint32_t)0x14292967U,
+    (uint32_t)0x27b70a85U, (uint32_t)0x2e1b2138U, (uint32_t)0x4d2c6dfcU, (uint32_t)0x53380d13U,
+    (uint32_t)0x650a7354U, (uint32_t)0x766a0abbU, (uint32_t)0x81c2c92eU, (uint32_t)0x92722c85U,
+    (uint32_t)0xa2bfe8a1U, (uint32_t)0xa81a664bU, (uint32_t)0xc24b8b70U, (uint32_t)0xc76c51a3U,
+    (uint32_t)0xd192e819U, (uint32_t)0xd6990624U, (uint32_t)0xf40e3585U, (uint32_t)0x106aa070U,
+    (uint32_t)0x19a4c116U, (uint32_t)0x1e376c08U, (uint32_t)0x2748774cU, (uint32_t)0x34b0bcb5U,
+    (uint32_t)0x391c0cb3U, (uint32_t)0x4ed8aa4aU, (uint32_t)0x5b9cca4fU, (uint32_t)0x682e6ff3U,
+    (uint32_t)0x748f82eeU, (uint32_t)0x78a5636fU, (uint32_t)0x84c87814U, (uint32_t)0x8cc70208U,
+    (uint32_t)0x90befffaU, (uint32_t)0xa4506cebU, (uint32_t)0xbef9a3f7U, (uint32_t)0xc67178f2U
+  };
+
+static const
+uint32_t
+h256[8U] =
+  {
+    (uint32_t)0x6a09e667U, (uint32_t)0xbb67ae85U, (uint32_t)0x3c6ef372U, (uint32_t)0xa54ff53aU,
+    (uint32_t)0x510e527fU, (uint32_t)0x9b05688cU, (uint32_t)0x1f83d9abU, (uint32_t)0x5be0cd19U
+  };
+
+static inline void transpose4x4(Lib_IntVector_Intrinsics_vec128 *v)
+{
+  Lib_IntVector_Intrinsics_vec128 v0 = v[0U];
+  Lib_IntVector_Intrinsics_vec128 v1 = v[1U];
+  Lib_IntVector_Intrinsics_vec128 v2 = v[2U];
+  Lib_IntVector_Intrinsics_vec128 v3 = v[3U];
+  Lib_IntVector_Intrinsics_vec128 v0_ = Lib_IntVector_Intrinsics_vec128_interleave_low32(v0, v1);
+  Lib_IntVector_Intrinsics_vec128 v1_ = Lib_IntVector_Intrinsics_vec128_interleave_high32(v0, v1);
+  Lib_IntVector_Intrinsics_vec128 v2_ = Lib_IntVector_Intrinsics_vec128_interleave_low32(v2, v3);
+  Lib_IntVector_Intrinsics_vec128 v3_ = Lib_IntVector_Intrinsics_vec128_interleave_high32(v2, v3);
+  v[0U] = Lib_IntVector_Intrinsics_vec128_interleave_low64(v0_, v2_);
+  v[1U] = Lib_IntVector_Intrinsics_vec128_interleave_high64(v0_, v2_);
+  v[2U] = Lib_IntVector_Intrinsics_vec128_interleave_low64(v1_, v3_);
+  v[3U] = Lib_IntVector_Intrinsics_vec128_interleave_high64(v1_, v3_);
+}
+
+static inline void
+load_ws4(Lib_IntVector_Intrinsics_vec128 *ws, uint8_t *b0, uint8_t *b1, uint8_t *b2, uint8_t *b3)
+{
+  ws[0U] = Lib_IntVector_Intrinsics_vec128_load32_be(b0 + (uint32_t)0U);
+  ws[1U] = Lib_IntVector_Intrinsics_vec128_load32_be(b1 + (uint32_t)0U);
+  ws[2U] = Lib_IntVector_Intrinsics_vec128_load32_be(b2 + (uint32_t)0U);
+  ws[3U] = Lib_IntVector_Intrinsics_vec128_load32_be(b3 + (uint32_t)0U);
+  ws[4U] = Lib_IntVector_Intrinsics_vec128_load32_be(b0 + (uint32_t)16U);
+  ws[5U] = Lib_IntVector_Intrinsics_vec128_load32_be(b1 + (uint32_t)16U);
+  ws[6U] = Lib_IntVector_Intrinsics_vec128_load32_be(b2 + (uint32_t)16U);
+  ws[7U] = Lib_IntVector_Intrinsics_vec128_load32_be(b3 + (uint32_t)16U);
+  ws[8U] = Lib_IntVector_Intrinsics_vec128_load32_be(b0 + (uint32_t)32U);
+  ws[9U] = Lib_IntVector_Intrinsics_vec128_load32_be(b1 + (uint32_t)32U);
+  ws[10U] = Lib_IntVector_Intrinsics_vec128_load32_be(b2 + (uint32_t)32U);
+  ws[11U] = Lib_IntVector_Intrinsics_vec128_load32_be(b3 + (uint32_t)32U);
+  ws[12U] = Lib_IntVector_Intrinsics_vec128_load32_be(b0 + (uint32_t)48U);
+  ws[13U] = Lib_IntVector_Intrinsics_vec128_load32_be(b1 + (uint32_t)48U);
+  ws[14U] = Lib_IntVector_Intrinsics_vec128_load32_be(b2 + (uint32_t)48U);
+  ws[15U] = Lib_IntVector_Intrinsics_vec128_load32_be(b3 + (uint32_t)48U);
+  transpose4x4(ws + (uint32_t)0U);
+  transpose4x4(ws + (uint32_t)4U);
+  transpose4x4(ws + (uint32_t)8U);
+  transpose4x4(ws + (uint32_t)12U);
+}
+
+static inline void
+load_ws4_halves(Lib_IntVector_Intrinsics_vec128 *ws, uint8_t **lo, uint8_t **hi)
+{
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)4U; i++)
+  {
+    ws[i] = Lib_IntVector_Intrinsics_vec128_load32_be(lo[i]);
+    ws[(uint32_t)4U + i] = Lib_IntVector_Intrinsics_vec128_load32_be(lo[i] + (uint32_t)16U);
+    ws[(uint32_t)8U + i] = Lib_IntVector_Intrinsics_vec128_load32_be(hi[i]);
+    ws[(uint32_t)12U + i] = Lib_IntVector_Intrinsics_vec128_load32_be(hi[i] + (uint32_t)16U);
+  }
+  transpose4x4(ws + (uint32_t)0U);
+  transpose4x4(ws + (uint32_t)4U);
+  transpose4x4(ws + (uint32_t)8U);
+  transpose4x4(ws + (uint32_t)12U);
+}
+
+static inline void
+update4_ws(Lib_IntVector_Intrinsics_vec128 *hash, Lib_IntVector_Intrinsics_vec128 *ws)
+{
+  Lib_IntVector_Intrinsics_vec128 hash_old[8U];
+  memcpy(hash_old, hash, (uint32_t)8U * sizeof (Lib_IntVector_Intrinsics_vec128));
+  for (uint32_t i0 = (uint32_t)0U; i0 < (uint32_t)4U; i0++)
+  {
+    for (uint32_t i = (uint32_t)0U; i < (uint32_t)16U; i++)
+    {
+      Lib_IntVector_Intrinsics_vec128 k_t = Lib_IntVector_Intrinsics_vec128_load32(k224_256[(uint32_t)16U * i0 + i]);
+      Lib_IntVector_Intrinsics_vec128 ws_t = ws[i];
+      Lib_IntVector_Intrinsics_vec128 a0 = hash[0U];
+      Lib_IntVector_Intrinsics_vec128 b0 = hash[1U];
+      Lib_IntVector_Intrinsics_vec128 c0 = hash[2U];
+      Lib_IntVector_Intrinsics_vec128 d0 = hash[3U];
+      Lib_IntVector_Intrinsics_vec128 e0 = hash[4U];
+      Lib_IntVector_Intrinsics_vec128 f0 = hash[5U];
+      Lib_IntVector_Intrinsics_vec128 g0 = hash[6U];
+      Lib_IntVector_Intrinsics_vec128 h02 = hash[7U];
+      Lib_IntVector_Intrinsics_vec128
+      t1 =
+        Lib_IntVector_Intrinsics_vec128_add32(Lib_IntVector_Intrinsics_vec128_add32(Lib_IntVector_Intrinsics_vec128_add32(Lib_IntVector_Intrinsics_vec128_add32(h02,
+                Lib_IntVector_Intrinsics_vec128_xor(Lib_IntVector_Intrinsics_vec128_rotate_right32(e0, (uint32_t)6U),
+                  Lib_IntVector_Intrinsics_vec128_xor(Lib_IntVector_Intrinsics_vec128_rotate_right32(e0, (uint32_t)11U),
+                    Lib_IntVector_Intrinsics_vec128_rotate_right32(e0, (uint32_t)25U)))),
+              Lib_IntVector_Intrinsics_vec128_xor(Lib_IntVector_Intrinsics_vec128_and(e0, f0), Lib_IntVector_Intrinsics_vec128_and(Lib_IntVector_Intrinsics_vec128_lognot(e0), g0))),
+            k_t),
+          ws_t);
+      Lib_IntVector_Intrinsics_vec128
+      t2 =
+        Lib_IntVector_Intrinsics_vec128_add32(Lib_IntVector_Intrinsics_vec128_xor(Lib_IntVector_Intrinsics_vec128_rotate_right32(a0, (uint32_t)2U),
+            Lib_IntVector_Intrinsics_vec128_xor(Lib_IntVector_Intrinsics_vec128_rotate_right32(a0, (uint32_t)13U),
+              Lib_IntVector_Intrinsics_vec128_rotate_right32(a0, (uint32_t)22U))),
+          Lib_IntVector_Intrinsics_vec128_xor(Lib_IntVector_Intrinsics_vec128_and(a0, b0),
+            Lib_IntVector_Intrinsics_vec128_xor(Lib_IntVector_Intrinsics_vec128_and(a0, c0), Lib_IntVector_Intrinsics_vec128_and(b0, c0))));
+      hash[0U] = Lib_IntVector_Intrinsics_vec128_add32(t1, t2);
+      hash[1U] = a0;
+      hash[2U] = b0;
+      hash[3U] = c0;
+      hash[4U] = Lib_IntVector_Intrinsics_vec128_add32(d0, t1);
+      hash[5U] = e0;
+      hash[6U] = f0;
+      hash[7U] = g0;
+    }
+    if (i0 < (uint32_t)3U)
+    {
+      for (uint32_t i = (uint32_t)0U; i < (uint32_t)16U; i++)
+      {
+        Lib_IntVector_Intrinsics_vec128 t16 = ws[i];
+        Lib_IntVector_Intrinsics_vec128 t15 = ws[(i + (uint32_t)1U) % (uint32_t)16U];
+        Lib_IntVector_Intrinsics_vec128 t7 = ws[(i + (uint32_t)9U) % (uint32_t)16U];
+        Lib_IntVector_Intrinsics_vec128 t2 = ws[(i + (uint32_t)14U) % (uint32_t)16U];
+        Lib_IntVector_Intrinsics_vec128
+        s1 =
+          Lib_IntVector_Intrinsics_vec128_xor(Lib_IntVector_Intrinsics_vec128_rotate_right32(t2, (uint32_t)17U),
+            Lib_IntVector_Intrinsics_vec128_xor(Lib_IntVector_Intrinsics_vec128_rotate_right32(t2, (uint32_t)19U),
+              Lib_IntVector_Intrinsics_vec128_shift_right32(t2, (uint32_t)10U)));
+        Lib_IntVector_Intrinsics_vec128
+        s0 =
+          Lib_IntVector_Intrinsics_vec128_xor(Lib_IntVector_Intrinsics_vec128_rotate_right32(t15, (uint32_t)7U),
+            Lib_IntVector_Intrinsics_vec128_xor(Lib_IntVector_Intrinsics_vec128_rotate_right32(t15, (uint32_t)18U),
+              Lib_IntVector_Intrinsics_vec128_shift_right32(t15, (uint32_t)3U)));
+        ws[i] = Lib_IntVector_Intrinsics_vec128_add32(Lib_IntVector_Intrinsics_vec128_add32(Lib_IntVector_Intrinsics_vec128_add32(s1, t7), s0), t16);
+      }
+    }
+  }
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)8U; i++)
+  {
+    hash[i] = Lib_IntVector_Intrinsics_vec128_add32(hash[i], hash_old[i]);
+  }
+}
+
+static inline void
+update4(Lib_IntVector_Intrinsics_vec128 *hash, uint8_t *b0, uint8_t *b1, uint8_t *b2, uint8_t *b3)
+{
+  Lib_IntVector_Intrinsics_vec128 ws[16U];
+  load_ws4(ws, b0, b1, b2, b3);
+  update4_ws(hash, ws);
+}
+
+/*
+  Hash 4 independent messages of the same length `input_len` with SHA2-256,
+  one message per 32-bit vector lane. The digests are written to `dst0` .. `dst3`.
+*/
+void
+Hacl_SHA2_Vec128_sha256_4(
+  uint8_t *dst0,
+  uint8_t *dst1,
+  uint8_t *dst2,
+  uint8_t *dst3,
+  uint32_t input_len,
+  uint8_t *input0,
+  uint8_t *input1,
+  uint8_t *input2,
+  uint8_t *input3
+)
+{
+  Lib_IntVector_Intrinsics_vec128 hash[8U];
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)8U; i++)
+  {
+    hash[i] = Lib_IntVector_Intrinsics_vec128_load32(h256[i]);
+  }
+  uint32_t blocks_n = input_len / (uint32_t)64U;
+  for (uint32_t i = (uint32_t)0U; i < blocks_n; i++)
+  {
+    uint32_t off = i * (uint32_t)64U;
+    update4(hash, input0 + off, input1 + off, input2 + off, input3 + off);
+  }
+  uint32_t rem = input_len - blocks_n * (uint32_t)64U;
+  uint32_t pad_blocks;
+  if (rem + (uint32_t)9U <= (uint32_t)64U)
+  {
+    pad_blocks = (uint32_t)1U;
+  }
+  else
+  {
+    pad_blocks = (uint32_t)2U;
+  }
+  uint32_t pad_len = pad_blocks * (uint32_t)64U;
+  uint64_t total_len_bits = (uint64_t)input_len << (uint32_t)3U;
+  uint8_t last[512U] = { 0U };
+  uint8_t *inputs[4U] = { input0, input1, input2, input3 };
+  for (uint32_t j = (uint32_t)0U; j < (uint32_t)4U; j++)
+  {
+    uint8_t *last_j = last + j * (uint32_t)128U;
+    memcpy(last_j, inputs[j] + blocks_n * (uint32_t)64U, rem * sizeof (uint8_t));
+    last_j[rem] = (uint8_t)0x80U;
+    store64_be(last_j + pad_len - (uint32_t)8U, total_len_bits);
+  }
+  update4(hash, last + (uint32_t)0U, last + (uint32_t)128U, last + (uint32_t)256U, last + (uint32_t)384U);
+  if (pad_blocks == (uint32_t)2U)
+  {
+    update4(hash, last + (uint32_t)64U, last + (uint32_t)192U, last + (uint32_t)320U, last + (uint32_t)448U);
+  }
+  transpose4x4(hash);
+  transpose4x4(hash + (uint32_t)4U);
+  Lib_IntVector_Intrinsics_vec128_store32_be(dst0, hash[0U]);
+  Lib_IntVector_Intrinsics_vec128_store32_be(dst0 + (uint32_t)16U, hash[4U]);
+  Lib_IntVector_Intrinsics_vec128_store32_be(dst1, hash[1U]);
+  Lib_IntVector_Intrinsics_vec128_store32_be(dst1 + (uint32_t)16U, hash[5U]);
+  Lib_IntVector_Intrinsics_vec128_store32_be(dst2, hash[2U]);
+  Lib_IntVector_Intrinsics_vec128_store32_be(dst2 + (uint32_t)16U, hash[6U]);
+  Lib_IntVector_Intrinsics_vec128_store32_be(dst3, hash[3U]);
+  Lib_IntVector_Intrinsics_vec128_store32_be(dst3 + (uint32_t)16U, hash[7U]);
+}
+
+/*
+  Apply the SHA2-256 compression function to 4 independent 64-byte blocks, one
+  block per 32-bit vector lane, starting from the SHA2-256 initial hash value and
+  without padding. Block j is the 32 bytes at `src1[j]` followed by the 32 bytes
+  at `src2[j]`; its resulting state is written big-endian to `dst[j]`.
+*/
+void Hacl_SHA2_Vec128_sha256_compress4(uint8_t **dst, uint8_t **src1, uint8_t **src2)
+{
+  Lib_IntVector_Intrinsics_vec128 hash[8U];
+  Lib_IntVector_Intrinsics_vec128 ws[16U];
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)8U; i++)
+  {
+    hash[i] = Lib_IntVector_Intrinsics_vec128_load32(h256[i]);
+  }
+  load_ws4_halves(ws, src1, src2);
+  update4_ws(hash, ws);
+  transpose4x4(hash);
+  transpose4x4(hash + (uint32_t)4U);
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)4U; i++)
+  {
+    Lib_IntVector_Intrinsics_vec128_store32_be(dst[i], hash[i]);
+    Lib_IntVector_Intrinsics_vec128_store32_be(dst[i] + (uint32_t)16U, hash[(uint32_t)4U + i]);
+  }
+}
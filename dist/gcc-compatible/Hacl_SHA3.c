@@ -67,7 +67,7 @@ void Hacl_Impl_SHA3_state_permute(uint64_t *s)
 {
   for (uint32_t i0 = (uint32_t)0U; i0 < (uint32_t)24U; i0++)
   {
-    uint64_t b[5U] = { 0U };
+    uint64_t b[5U];
     for (uint32_t i = (uint32_t)0U; i < (uint32_t)5U; i++)
     {
       b[i] =
@@ -88,7 +88,6 @@ void Hacl_Impl_SHA3_state_permute(uint64_t *s)
         s[i1 + (uint32_t)5U * i] = s[i1 + (uint32_t)5U * i] ^ _D;
       }
     }
-    Lib_Memzero0_memzero(b, (uint32_t)5U * sizeof (b[0U]));
     uint64_t x = s[1U];
     uint64_t b0 = x;
     for (uint32_t i = (uint32_t)0U; i < (uint32_t)24U; i++)
@@ -99,8 +98,7 @@ void Hacl_Impl_SHA3_state_permute(uint64_t *s)
       s[_Y] = Hacl_Impl_SHA3_rotl(b0, r);
       b0 = temp;
     }
-    Lib_Memzero0_memzero(&b0, (uint32_t)1U * sizeof ((&b0)[0U]));
-    uint64_t b1[25U] = { 0U };
+    uint64_t b1[25U];
     memcpy(b1, s, (uint32_t)25U * sizeof (uint64_t));
     for (uint32_t i1 = (uint32_t)0U; i1 < (uint32_t)5U; i1++)
     {
@@ -116,7 +114,6 @@ void Hacl_Impl_SHA3_state_permute(uint64_t *s)
             & b1[(i + (uint32_t)2U) % (uint32_t)5U + (uint32_t)5U * i1]);
       }
     }
-    Lib_Memzero0_memzero(b1, (uint32_t)25U * sizeof (b1[0U]));
     uint64_t c = Hacl_Impl_SHA3_keccak_rndc[i0];
     s[0U] = s[0U] ^ c;
   }
@@ -0,0 +1,268 @@
+/* MIT License
+ *
+ * Copyright (c) 2016-2020 INRIA, CMU and Microsoft Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "Hacl_SHA3_Vec256.h"
+
+static inline void transpose4x4(Lib_IntVector_Intrinsics_vec256 *v)
+{
+  Lib_IntVector_Intrinsics_vec256 v0 = v[0U];
+  Lib_IntVector_Intrinsics_vec256 v1 = v[1U];
+  Lib_IntVector_Intrinsics_vec256 v2 = v[2U];
+  Lib_IntVector_Intrinsics_vec256 v3 = v[3U];
+  Lib_IntVector_Intrinsics_vec256 v0_ = Lib_IntVector_Intrinsics_vec256_interleave_low64(v0, v1);
+  Lib_IntVector_Intrinsics_vec256 v1_ = Lib_IntVector_Intrinsics_vec256_interleave_high64(v0, v1);
+  Lib_IntVector_Intrinsics_vec256 v2_ = Lib_IntVector_Intrinsics_vec256_interleave_low64(v2, v3);
+  Lib_IntVector_Intrinsics_vec256 v3_ = Lib_IntVector_Intrinsics_vec256_interleave_high64(v2, v3);
+  v[0U] = Lib_IntVector_Intrinsics_vec256_interleave_low128(v0_, v2_);
+  v[1U] = Lib_IntVector_Intrinsics_vec256_interleave_low128(v1_, v3_);
+  v[2U] = Lib_IntVector_Intrinsics_vec256_interleave_high128(v0_, v2_);
+  v[3U] = Lib_IntVector_Intrinsics_vec256_interleave_high128(v1_, v3_);
+}
+
+static inline void state_permute4(Lib_IntVector_Intrinsics_vec256 *s)
+{
+  for (uint32_t i0 = (uint32_t)0U; i0 < (uint32_t)24U; i0++)
+  {
+    Lib_IntVector_Intrinsics_vec256 b[5U];
+    for (uint32_t i = (uint32_t)0U; i < (uint32_t)5U; i++)
+    {
+      b[i] =
+        Lib_IntVector_Intrinsics_vec256_xor(s[i],
+          Lib_IntVector_Intrinsics_vec256_xor(s[i + (uint32_t)5U],
+            Lib_IntVector_Intrinsics_vec256_xor(s[i + (uint32_t)10U],
+              Lib_IntVector_Intrinsics_vec256_xor(s[i + (uint32_t)15U], s[i + (uint32_t)20U]))));
+    }
+    for (uint32_t i1 = (uint32_t)0U; i1 < (uint32_t)5U; i1++)
+    {
+      Lib_IntVector_Intrinsics_vec256
+      _D =
+        Lib_IntVector_Intrinsics_vec256_xor(b[(i1 + (uint32_t)4U) % (uint32_t)5U],
+          Lib_IntVector_Intrinsics_vec256_rotate_left64(b[(i1 + (uint32_t)1U) % (uint32_t)5U], (uint32_t)1U));
+      for (uint32_t i = (uint32_t)0U; i < (uint32_t)5U; i++)
+      {
+        s[i1 + (uint32_t)5U * i] = Lib_IntVector_Intrinsics_vec256_xor(s[i1 + (uint32_t)5U * i], _D);
+      }
+    }
+    Lib_IntVector_Intrinsics_vec256 b0 = s[1U];
+    Lib_IntVector_Intrinsics_vec256 t0 = s[10U];
+    s[10U] = Lib_IntVector_Intrinsics_vec256_rotate_left64(b0, (uint32_t)1U);
+    Lib_IntVector_Intrinsics_vec256 t1 = s[7U];
+    s[7U] = Lib_IntVector_Intrinsics_vec256_rotate_left64(t0, (uint32_t)3U);
+    Lib_IntVector_Intrinsics_vec256 t2 = s[11U];
+    s[11U] = Lib_IntVector_Intrinsics_vec256_rotate_left64(t1, (uint32_t)6U);
+    Lib_IntVector_Intrinsics_vec256 t3 = s[17U];
+    s[17U] = Lib_IntVector_Intrinsics_vec256_rotate_left64(t2, (uint32_t)10U);
+    Lib_IntVector_Intrinsics_vec256 t4 = s[18U];
+    s[18U] = Lib_IntVector_Intrinsics_vec256_rotate_left64(t3, (uint32_t)15U);
+    Lib_IntVector_Intrinsics_vec256 t5 = s[3U];
+    s[3U] = Lib_IntVector_Intrinsics_vec256_rotate_left64(t4, (uint32_t)21U);
+    Lib_IntVector_Intrinsics_vec256 t6 = s[5U];
+    s[5U] = Lib_IntVector_Intrinsics_vec256_rotate_left64(t5, (uint32_t)28U);
+    Lib_IntVector_Intrinsics_vec256 t7 = s[16U];
+    s[16U] = Lib_IntVector_Intrinsics_vec256_rotate_left64(t6, (uint32_t)36U);
+    Lib_IntVector_Intrinsics_vec256 t8 = s[8U];
+    s[8U] = Lib_IntVector_Intrinsics_vec256_rotate_left64(t7, (uint32_t)45U);
+    Lib_IntVector_Intrinsics_vec256 t9 = s[21U];
+    s[21U] = Lib_IntVector_Intrinsics_vec256_rotate_left64(t8, (uint32_t)55U);
+    Lib_IntVector_Intrinsics_vec256 t10 = s[24U];
+    s[24U] = Lib_IntVector_Intrinsics_vec256_rotate_left64(t9, (uint32_t)2U);
+    Lib_IntVector_Intrinsics_vec256 t11 = s[4U];
+    s[4U] = Lib_IntVector_Intrinsics_vec256_rotate_left64(t10, (uint32_t)14U);
+    Lib_IntVector_Intrinsics_vec256 t12 = s[15U];
+    s[15U] = Lib_IntVector_Intrinsics_vec256_rotate_left64(t11, (uint32_t)27U);
+    Lib_IntVector_Intrinsics_vec256 t13 = s[23U];
+    s[23U] = Lib_IntVector_Intrinsics_vec256_rotate_left64(t12, (uint32_t)41U);
+    Lib_IntVector_Intrinsics_vec256 t14 = s[19U];
+    s[19U] = Lib_IntVector_Intrinsics_vec256_rotate_left64(t13, (uint32_t)56U);
+    Lib_IntVector_Intrinsics_vec256 t15 = s[13U];
+    s[13U] = Lib_IntVector_Intrinsics_vec256_rotate_left64(t14, (uint32_t)8U);
+    Lib_IntVector_Intrinsics_vec256 t16 = s[12U];
+    s[12U] = Lib_IntVector_Intrinsics_vec256_rotate_left64(t15, (uint32_t)25U);
+    Lib_IntVector_Intrinsics_vec256 t17 = s[2U];
+    s[2U] = Lib_IntVector_Intrinsics_vec256_rotate_left64(t16, (uint32_t)43U);
+    Lib_IntVector_Intrinsics_vec256 t18 = s[20U];
+    s[20U] = Lib_IntVector_Intrinsics_vec256_rotate_left64(t17, (uint32_t)62U);
+    Lib_IntVector_Intrinsics_vec256 t19 = s[14U];
+    s[14U] = Lib_IntVector_Intrinsics_vec256_rotate_left64(t18, (uint32_t)18U);
+    Lib_IntVector_Intrinsics_vec256 t20 = s[22U];
+    s[22U] = Lib_IntVector_Intrinsics_vec256_rotate_left64(t19, (uint32_t)39U);
+    Lib_IntVector_Intrinsics_vec256 t21 = s[9U];
+    s[9U] = Lib_IntVector_Intrinsics_vec256_rotate_left64(t20, (uint32_t)61U);
+    Lib_IntVector_Intrinsics_vec256 t22 = s[6U];
+    s[6U] = Lib_IntVector_Intrinsics_vec256_rotate_left64(t21, (uint32_t)20U);
+    Lib_IntVector_Intrinsics_vec256 t23 = s[1U];
+    s[1U] = Lib_IntVector_Intrinsics_vec256_rotate_left64(t22, (uint32_t)44U);
+    for (uint32_t i1 = (uint32_t)0U; i1 < (uint32_t)5U; i1++)
+    {
+      Lib_IntVector_Intrinsics_vec256 b1[5U];
+      memcpy(b1, s + (uint32_t)5U * i1, (uint32_t)5U * sizeof (Lib_IntVector_Intrinsics_vec256));
+      for (uint32_t i = (uint32_t)0U; i < (uint32_t)5U; i++)
+      {
+        s[i + (uint32_t)5U * i1] =
+          Lib_IntVector_Intrinsics_vec256_xor(b1[i],
+            Lib_IntVector_Intrinsics_vec256_and(Lib_IntVector_Intrinsics_vec256_lognot(b1[(i + (uint32_t)1U) % (uint32_t)5U]),
+              b1[(i + (uint32_t)2U) % (uint32_t)5U]));
+      }
+    }
+    s[0U] = Lib_IntVector_Intrinsics_vec256_xor(s[0U], Lib_IntVector_Intrinsics_vec256_load64(Hacl_Impl_SHA3_keccak_rndc[i0]));
+  }
+}
+
+/* Lanes are laid out 256 bytes apart in `b`, so that the 24 words covering any
+   rate can be loaded four at a time and transposed into the state. */
+static inline void loadState4(uint8_t *b, Lib_IntVector_Intrinsics_vec256 *s)
+{
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)6U; i++)
+  {
+    Lib_IntVector_Intrinsics_vec256 v[4U];
+    v[0U] = Lib_IntVector_Intrinsics_vec256_load64_le(b + (uint32_t)32U * i);
+    v[1U] = Lib_IntVector_Intrinsics_vec256_load64_le(b + (uint32_t)256U + (uint32_t)32U * i);
+    v[2U] = Lib_IntVector_Intrinsics_vec256_load64_le(b + (uint32_t)512U + (uint32_t)32U * i);
+    v[3U] = Lib_IntVector_Intrinsics_vec256_load64_le(b + (uint32_t)768U + (uint32_t)32U * i);
+    transpose4x4(v);
+    for (uint32_t j = (uint32_t)0U; j < (uint32_t)4U; j++)
+    {
+      s[(uint32_t)4U * i + j] = Lib_IntVector_Intrinsics_vec256_xor(s[(uint32_t)4U * i + j], v[j]);
+    }
+  }
+}
+
+static inline void storeState4(Lib_IntVector_Intrinsics_vec256 *s, uint8_t *b)
+{
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)6U; i++)
+  {
+    Lib_IntVector_Intrinsics_vec256 v[4U];
+    memcpy(v, s + (uint32_t)4U * i, (uint32_t)4U * sizeof (Lib_IntVector_Intrinsics_vec256));
+    transpose4x4(v);
+    Lib_IntVector_Intrinsics_vec256_store64_le(b + (uint32_t)32U * i, v[0U]);
+    Lib_IntVector_Intrinsics_vec256_store64_le(b + (uint32_t)256U + (uint32_t)32U * i, v[1U]);
+    Lib_IntVector_Intrinsics_vec256_store64_le(b + (uint32_t)512U + (uint32_t)32U * i, v[2U]);
+    Lib_IntVector_Intrinsics_vec256_store64_le(b + (uint32_t)768U + (uint32_t)32U * i, v[3U]);
+  }
+}
+
+static inline void
+shake4(
+  uint32_t rateInBytes,
+  uint32_t inputByteLen,
+  uint8_t *input0,
+  uint8_t *input1,
+  uint8_t *input2,
+  uint8_t *input3,
+  uint32_t outputByteLen,
+  uint8_t *output0,
+  uint8_t *output1,
+  uint8_t *output2,
+  uint8_t *output3
+)
+{
+  Lib_IntVector_Intrinsics_vec256 s[25U];
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)25U; i++)
+  {
+    s[i] = Lib_IntVector_Intrinsics_vec256_zero;
+  }
+  uint8_t *input[4U] = { input0, input1, input2, input3 };
+  uint8_t *output[4U] = { output0, output1, output2, output3 };
+  uint8_t b[1024U] = { 0U };
+  uint32_t nb = inputByteLen / rateInBytes;
+  uint32_t rem = inputByteLen % rateInBytes;
+  for (uint32_t i = (uint32_t)0U; i < nb; i++)
+  {
+    for (uint32_t j = (uint32_t)0U; j < (uint32_t)4U; j++)
+    {
+      memcpy(b + (uint32_t)256U * j, input[j] + i * rateInBytes, rateInBytes * sizeof (uint8_t));
+    }
+    loadState4(b, s);
+    state_permute4(s);
+  }
+  memset(b, 0U, (uint32_t)1024U * sizeof (uint8_t));
+  for (uint32_t j = (uint32_t)0U; j < (uint32_t)4U; j++)
+  {
+    uint8_t *bj = b + (uint32_t)256U * j;
+    memcpy(bj, input[j] + nb * rateInBytes, rem * sizeof (uint8_t));
+    bj[rem] = (uint8_t)0x1FU;
+    bj[rateInBytes - (uint32_t)1U] = bj[rateInBytes - (uint32_t)1U] ^ (uint8_t)0x80U;
+  }
+  loadState4(b, s);
+  state_permute4(s);
+  uint32_t outBlocks = outputByteLen / rateInBytes;
+  uint32_t remOut = outputByteLen % rateInBytes;
+  for (uint32_t i = (uint32_t)0U; i < outBlocks; i++)
+  {
+    storeState4(s, b);
+    for (uint32_t j = (uint32_t)0U; j < (uint32_t)4U; j++)
+    {
+      memcpy(output[j] + i * rateInBytes, b + (uint32_t)256U * j, rateInBytes * sizeof (uint8_t));
+    }
+    state_permute4(s);
+  }
+  storeState4(s, b);
+  for (uint32_t j = (uint32_t)0U; j < (uint32_t)4U; j++)
+  {
+    memcpy(output[j] + outBlocks * rateInBytes, b + (uint32_t)256U * j, remOut * sizeof (uint8_t));
+  }
+}
+
+/*
+  SHAKE128 of 4 independent inputs of the same length, one input per 64-bit lane
+  of a 256-bit vector.
+*/
+void
+Hacl_SHA3_Vec256_shake128_vec256(
+  uint32_t inputByteLen,
+  uint8_t *input0,
+  uint8_t *input1,
+  uint8_t *input2,
+  uint8_t *input3,
+  uint32_t outputByteLen,
+  uint8_t *output0,
+  uint8_t *output1,
+  uint8_t *output2,
+  uint8_t *output3
+)
+{
+  shake4((uint32_t)168U, inputByteLen, input0, input1, input2, input3, outputByteLen, output0, output1, output2, output3);
+}
+
+/*
+  SHAKE256 of 4 independent inputs of the same length, one input per 64-bit lane
+  of a 256-bit vector.
+*/
+void
+Hacl_SHA3_Vec256_shake256_vec256(
+  uint32_t inputByteLen,
+  uint8_t *input0,
+  uint8_t *input1,
+  uint8_t *input2,
+  uint8_t *input3,
+  uint32_t outputByteLen,
+  uint8_t *output0,
+  uint8_t *output1,
+  uint8_t *output2,
+  uint8_t *output3
+)
+{
+  shake4((uint32_t)136U, inputByteLen, input0, input1, input2, input3, outputByteLen, output0, output1, output2, output3);
+}
+
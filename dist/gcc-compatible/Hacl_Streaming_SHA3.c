@@ -0,0 +1,251 @@
+/* MIT License
+ *
+ * Copyright (c) 2016-2020 INRIA, CMU and Microsoft Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "Hacl_Streaming_SHA3.h"
+
+static uint32_t block_len(Spec_Hash_Definitions_hash_alg a)
+{
+  switch (a)
+  {
+    case Spec_Hash_Definitions_SHA3_224:
+      {
+        return (uint32_t)144U;
+      }
+    case Spec_Hash_Definitions_SHA3_256:
+      {
+        return (uint32_t)136U;
+      }
+    case Spec_Hash_Definitions_SHA3_384:
+      {
+        return (uint32_t)104U;
+      }
+    case Spec_Hash_Definitions_SHA3_512:
+      {
+        return (uint32_t)72U;
+      }
+    case Spec_Hash_Definitions_Shake128:
+      {
+        return (uint32_t)168U;
+      }
+    case Spec_Hash_Definitions_Shake256:
+      {
+        return (uint32_t)136U;
+      }
+    default:
+      {
+        return (uint32_t)0U;
+      }
+  }
+}
+
+static uint32_t hash_len(Spec_Hash_Definitions_hash_alg a)
+{
+  switch (a)
+  {
+    case Spec_Hash_Definitions_SHA3_224:
+      {
+        return (uint32_t)28U;
+      }
+    case Spec_Hash_Definitions_SHA3_256:
+      {
+        return (uint32_t)32U;
+      }
+    case Spec_Hash_Definitions_SHA3_384:
+      {
+        return (uint32_t)48U;
+      }
+    case Spec_Hash_Definitions_SHA3_512:
+      {
+        return (uint32_t)64U;
+      }
+    default:
+      {
+        return (uint32_t)0U;
+      }
+  }
+}
+
+static bool is_shake(Spec_Hash_Definitions_hash_alg a)
+{
+  return a == Spec_Hash_Definitions_Shake128 || a == Spec_Hash_Definitions_Shake256;
+}
+
+/* Bytes currently held in the buffer: between 1 and a full block once anything
+   has been absorbed, so that the last block is always available to `finish`. */
+static uint32_t buffered_len(uint32_t rate, uint64_t total_len)
+{
+  if (total_len % (uint64_t)rate == (uint64_t)0U && total_len > (uint64_t)0U)
+  {
+    return rate;
+  }
+  return (uint32_t)(total_len % (uint64_t)rate);
+}
+
+static void absorb_blocks(uint32_t rate, uint64_t *s, uint8_t *blocks, uint32_t n_blocks)
+{
+  for (uint32_t i = (uint32_t)0U; i < n_blocks; i++)
+  {
+    Hacl_Impl_SHA3_loadState(rate, blocks + i * rate, s);
+    Hacl_Impl_SHA3_state_permute(s);
+  }
+}
+
+Hacl_Streaming_SHA3_state_sha3 *Hacl_Streaming_SHA3_create_in(Spec_Hash_Definitions_hash_alg a)
+{
+  uint32_t rate = block_len(a);
+  if (rate == (uint32_t)0U)
+  {
+    return NULL;
+  }
+  uint8_t *buf = KRML_HOST_CALLOC(rate, sizeof (uint8_t));
+  uint64_t *block_state = KRML_HOST_CALLOC((uint32_t)25U, sizeof (uint64_t));
+  Hacl_Streaming_SHA3_state_sha3
+  s =
+    {
+      .alg = a,
+      .block_state = block_state,
+      .buf = buf,
+      .total_len = (uint64_t)0U,
+      .squeezing = false,
+      .squeeze_off = (uint32_t)0U
+    };
+  KRML_CHECK_SIZE(sizeof (Hacl_Streaming_SHA3_state_sha3), (uint32_t)1U);
+  Hacl_Streaming_SHA3_state_sha3 *p = KRML_HOST_MALLOC(sizeof (Hacl_Streaming_SHA3_state_sha3));
+  p[0U] = s;
+  return p;
+}
+
+void Hacl_Streaming_SHA3_init(Hacl_Streaming_SHA3_state_sha3 *s)
+{
+  memset(s->block_state, 0U, (uint32_t)25U * sizeof (uint64_t));
+  s->total_len = (uint64_t)0U;
+  s->squeezing = false;
+  s->squeeze_off = (uint32_t)0U;
+}
+
+bool Hacl_Streaming_SHA3_update(Hacl_Streaming_SHA3_state_sha3 *s, uint8_t *data, uint32_t len)
+{
+  if (s->squeezing)
+  {
+    return false;
+  }
+  if (len == (uint32_t)0U)
+  {
+    return true;
+  }
+  uint32_t rate = block_len(s->alg);
+  uint64_t *block_state = s->block_state;
+  uint8_t *buf = s->buf;
+  uint32_t sz = buffered_len(rate, s->total_len);
+  s->total_len = s->total_len + (uint64_t)len;
+  if (len <= rate - sz)
+  {
+    memcpy(buf + sz, data, len * sizeof (uint8_t));
+    return true;
+  }
+  /* The buffered bytes and the data are more than a block: top up the buffer and
+     absorb it, absorb all full blocks of the data directly, and keep the last
+     1 .. rate bytes for later. */
+  uint32_t diff = (uint32_t)0U;
+  if (!(sz == (uint32_t)0U))
+  {
+    diff = rate - sz;
+    memcpy(buf + sz, data, diff * sizeof (uint8_t));
+    absorb_blocks(rate, block_state, buf, (uint32_t)1U);
+  }
+  uint8_t *data1 = data + diff;
+  uint32_t len1 = len - diff;
+  uint32_t ite = buffered_len(rate, (uint64_t)len1);
+  uint32_t n_blocks = (len1 - ite) / rate;
+  absorb_blocks(rate, block_state, data1, n_blocks);
+  memcpy(buf, data1 + n_blocks * rate, ite * sizeof (uint8_t));
+  return true;
+}
+
+bool Hacl_Streaming_SHA3_finish(Hacl_Streaming_SHA3_state_sha3 *s, uint8_t *dst)
+{
+  if (is_shake(s->alg))
+  {
+    return false;
+  }
+  uint32_t rate = block_len(s->alg);
+  uint32_t r = buffered_len(rate, s->total_len);
+  uint64_t tmp_block_state[25U] = { 0U };
+  memcpy(tmp_block_state, s->block_state, (uint32_t)25U * sizeof (uint64_t));
+  Hacl_Impl_SHA3_absorb(tmp_block_state, rate, r, s->buf, (uint8_t)0x06U);
+  Hacl_Impl_SHA3_storeState(hash_len(s->alg), tmp_block_state, dst);
+  return true;
+}
+
+bool Hacl_Streaming_SHA3_squeeze(Hacl_Streaming_SHA3_state_sha3 *s, uint8_t *dst, uint32_t len)
+{
+  if (!is_shake(s->alg))
+  {
+    return false;
+  }
+  uint32_t rate = block_len(s->alg);
+  uint64_t *block_state = s->block_state;
+  if (!s->squeezing)
+  {
+    uint32_t r = buffered_len(rate, s->total_len);
+    Hacl_Impl_SHA3_absorb(block_state, rate, r, s->buf, (uint8_t)0x1FU);
+    s->squeezing = true;
+    s->squeeze_off = (uint32_t)0U;
+  }
+  uint8_t b[200U] = { 0U };
+  uint32_t off = s->squeeze_off;
+  while (len > (uint32_t)0U)
+  {
+    if (off == rate)
+    {
+      Hacl_Impl_SHA3_state_permute(block_state);
+      off = (uint32_t)0U;
+    }
+    uint32_t n = rate - off;
+    if (len < n)
+    {
+      n = len;
+    }
+    Hacl_Impl_SHA3_storeState(rate, block_state, b);
+    memcpy(dst, b + off, n * sizeof (uint8_t));
+    off = off + n;
+    dst = dst + n;
+    len = len - n;
+  }
+  s->squeeze_off = off;
+  return true;
+}
+
+Spec_Hash_Definitions_hash_alg Hacl_Streaming_SHA3_alg_of_state(Hacl_Streaming_SHA3_state_sha3 *s)
+{
+  return s->alg;
+}
+
+void Hacl_Streaming_SHA3_free(Hacl_Streaming_SHA3_state_sha3 *s)
+{
+  KRML_HOST_FREE(s->block_state);
+  KRML_HOST_FREE(s->buf);
+  KRML_HOST_FREE(s);
+}
+
@@ -0,0 +1,97 @@
+/* MIT License
+ *
+ * Copyright (c) 2016-2020 INRIA, CMU and Microsoft Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef __Hacl_Streaming_SHA3_H
+#define __Hacl_Streaming_SHA3_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include "evercrypt_targetconfig.h"
+#include "libintvector.h"
+#include "kremlin/internal/types.h"
+#include "kremlin/lowstar_endianness.h"
+#include <string.h>
+#include "kremlin/internal/target.h"
+
+
+#include "Hacl_Kremlib.h"
+#include "Hacl_Spec.h"
+#include "Hacl_SHA3.h"
+
+typedef struct Hacl_Streaming_SHA3_state_sha3_s
+{
+  Spec_Hash_Definitions_hash_alg alg;
+  uint64_t *block_state;
+  uint8_t *buf;
+  uint64_t total_len;
+  bool squeezing;
+  uint32_t squeeze_off;
+}
+Hacl_Streaming_SHA3_state_sha3;
+
+/*
+  Allocate a streaming state for `a`, one of SHA3_224, SHA3_256, SHA3_384, SHA3_512,
+  Shake128 or Shake256. Returns NULL for any other algorithm.
+*/
+Hacl_Streaming_SHA3_state_sha3 *Hacl_Streaming_SHA3_create_in(Spec_Hash_Definitions_hash_alg a);
+
+void Hacl_Streaming_SHA3_init(Hacl_Streaming_SHA3_state_sha3 *s);
+
+/*
+  Absorb `len` bytes of `data`. Only a block of input is ever buffered, so the
+  memory used does not depend on the total length hashed.
+
+  Returns false, and leaves the state unchanged, once squeezing has started.
+*/
+bool Hacl_Streaming_SHA3_update(Hacl_Streaming_SHA3_state_sha3 *s, uint8_t *data, uint32_t len);
+
+/*
+  Write the digest of everything absorbed so far to `dst`. The state is left
+  untouched, so more data can be absorbed afterwards.
+
+  Returns false for SHAKE states, which must use `squeeze` instead.
+*/
+bool Hacl_Streaming_SHA3_finish(Hacl_Streaming_SHA3_state_sha3 *s, uint8_t *dst);
+
+/*
+  Write the next `len` bytes of SHAKE output to `dst`. The first call finalizes the
+  input; later calls continue the same output stream, so squeezing n bytes then m
+  bytes yields the same n + m bytes as squeezing them at once.
+
+  Returns false for fixed-length SHA-3 states.
+*/
+bool Hacl_Streaming_SHA3_squeeze(Hacl_Streaming_SHA3_state_sha3 *s, uint8_t *dst, uint32_t len);
+
+Spec_Hash_Definitions_hash_alg Hacl_Streaming_SHA3_alg_of_state(Hacl_Streaming_SHA3_state_sha3 *s);
+
+void Hacl_Streaming_SHA3_free(Hacl_Streaming_SHA3_state_sha3 *s);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#define __Hacl_Streaming_SHA3_H_DEFINED
+#endif
@@ -24,6 +24,48 @@
 
 #include "MerkleTree.h"
 
+#if !(defined(_WIN32) || defined(_WIN64))
+
+/* assume POSIX here */
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#ifndef MAP_NORESERVE
+#define MAP_NORESERVE 0
+#endif
+
+#endif
+
+/*
+  Contiguous storage for the hashes of one tree level.
+
+  Hashes are carved out of chunks of chunk_len hashes each. Levels only grow at
+  the back (mt_insert) and shrink at the front (mt_flush_to) or the back
+  (mt_retract_to), so the live hashes of a level are the chunk_len * chunks.sz
+  slots of chunks minus the first head and the last chunk_len - tail ones.
+
+  When base is not NULL, the level is instead the file fd mapped in memory, and
+  the hash of index k lives at base + k * hash_size. head and tail are then the
+  indices of the first live hash and one past the last one, and len is the
+  length in bytes of the hash area of the file, which grows ahead of tail.
+*/
+typedef struct MerkleTree_Low_hash_arena_s
+{
+  uint32_t chunk_len;
+  uint32_t head;
+  uint32_t tail;
+  LowStar_Vector_vector_str___uint8_t_ chunks;
+  uint8_t *base;
+  int32_t fd;
+  uint64_t len;
+}
+MerkleTree_Low_hash_arena;
+
 static uint8_t *hash_r_alloc(uint32_t s)
 {
   KRML_CHECK_SIZE(sizeof (uint8_t), s);
@@ -239,6 +281,80 @@ inline MerkleTree_Low_merkle_tree
   return MerkleTree_Low_mt_create_custom(hash_size, i, hash_fun);
 }
 
+/*
+  Construction with custom hash functions and arena storage
+
+  @param[in]  hash_size Hash size (in bytes)
+  @param[in]  i         The initial hash
+
+  return The new Merkle tree
+
+  Note: the hashes of each level are stored contiguously in chunks of about
+  4KB instead of being allocated one by one. Paths returned by mt_get_path
+  point into these chunks and remain valid until the hashes they point to are
+  flushed or retracted, as with trees built by mt_create_custom.
+*/
+inline MerkleTree_Low_merkle_tree
+*mt_create_custom_arena(
+  uint32_t hash_size,
+  uint8_t *i,
+  void (*hash_fun)(uint8_t *x0, uint8_t *x1, uint8_t *x2)
+)
+{
+  return MerkleTree_Low_mt_create_custom_arena(hash_size, i, hash_fun);
+}
+
+/*
+  Construction with custom hash functions and memory-mapped file storage
+
+  @param[in]  dir       Directory holding the level files, created if missing
+  @param[in]  hash_size Hash size (in bytes)
+  @param[in]  i         The initial hash
+
+  return The new Merkle tree, or NULL if the files cannot be created (in
+  particular if dir already holds a tree)
+
+  Note: each level lives in its own append-only file under dir, mapped in
+  memory. The tree state is written to disk by mt_sync and mt_free, and the
+  tree can be reopened with mt_open_custom_mmap. Hashes dropped by
+  mt_flush_to are released from the files at the next mt_sync or mt_free.
+  The first insertion after mt_retract_to syncs the retracted tree, so that
+  it does not overwrite hashes of the tree last written to disk.
+  Only available on POSIX systems with 64-bit pointers.
+*/
+inline MerkleTree_Low_merkle_tree
+*mt_create_custom_mmap(
+  const char *dir,
+  uint32_t hash_size,
+  uint8_t *i,
+  void (*hash_fun)(uint8_t *x0, uint8_t *x1, uint8_t *x2)
+)
+{
+  return MerkleTree_Low_mt_create_custom_mmap(dir, hash_size, i, hash_fun);
+}
+
+/*
+  Reopen a tree written by mt_create_custom_mmap
+
+  @param[in]  dir       Directory holding the level files
+  @param[in]  hash_size Hash size (in bytes), as given at creation
+
+  return The Merkle tree as of its last mt_sync or mt_free, or NULL if dir does
+  not hold a tree with this hash size
+
+  Note: the hashes are not read or copied; the tree only indexes the mapped
+  files.
+*/
+inline MerkleTree_Low_merkle_tree
+*mt_open_custom_mmap(
+  const char *dir,
+  uint32_t hash_size,
+  void (*hash_fun)(uint8_t *x0, uint8_t *x1, uint8_t *x2)
+)
+{
+  return MerkleTree_Low_mt_open_custom_mmap(dir, hash_size, hash_fun);
+}
+
 /*
   Destruction
 
@@ -249,17 +365,36 @@ inline void mt_free(MerkleTree_Low_merkle_tree *mt)
   MerkleTree_Low_mt_free(mt);
 }
 
+/*
+  Write a memory-mapped tree to disk
+
+  @param[in]  mt  The Merkle tree
+
+  return true if the hashes and then the tree state reached the disk
+
+  Note: the hashes are synced before the tree state, so a crash leaves the
+  files describing the tree as of the previous mt_sync. Does nothing for trees
+  that are not memory-mapped.
+*/
+inline bool mt_sync(MerkleTree_Low_merkle_tree *mt)
+{
+  return MerkleTree_Low_mt_sync(mt);
+}
+
 /*
   Insertion
 
   @param[in]  mt  The Merkle tree
   @param[in]  v   The tree does not take ownership of the hash, it makes a copy of its content.
 
+ return false, leaving the tree unchanged, if the files of a memory-mapped tree
+ cannot grow to hold the new hashes; true otherwise.
+
  Note: The content of the hash will be overwritten with an arbitrary value.
 */
-inline void mt_insert(MerkleTree_Low_merkle_tree *mt, uint8_t *v)
+inline bool mt_insert(MerkleTree_Low_merkle_tree *mt, uint8_t *v)
 {
-  MerkleTree_Low_mt_insert(mt, v);
+  return MerkleTree_Low_mt_insert(mt, v);
 }
 
 /*
@@ -270,6 +405,35 @@ inline bool mt_insert_pre(const MerkleTree_Low_merkle_tree *mt, uint8_t *v)
   return MerkleTree_Low_mt_insert_pre(mt, v);
 }
 
+/*
+  Batch insertion
+
+  @param[in]  mt      The Merkle tree
+  @param[in]  leaves  n hashes stored back to back (n * hash_size bytes). The tree
+                      does not take ownership of them, it makes copies.
+  @param[in]  n       The number of hashes to insert
+
+  The resulting tree is the same as after n calls to mt_insert, but the new nodes
+  of each level are computed together, level by level. With the default
+  mt_sha256_compress hash function, they are compressed several at a time over
+  vector lanes when SHA-NI is not available.
+
+  return false, leaving the tree unchanged, if the files of a memory-mapped tree
+  cannot grow to hold the new hashes; true otherwise.
+*/
+inline bool mt_insert_batch(MerkleTree_Low_merkle_tree *mt, uint8_t *leaves, uint32_t n)
+{
+  return MerkleTree_Low_mt_insert_batch(mt, leaves, n);
+}
+
+/*
+  Precondition predicate for mt_insert_batch
+*/
+inline bool mt_insert_batch_pre(const MerkleTree_Low_merkle_tree *mt, uint8_t *leaves, uint32_t n)
+{
+  return MerkleTree_Low_mt_insert_batch_pre(mt, leaves, n);
+}
+
 /*
   Getting the Merkle root
 
@@ -330,6 +494,57 @@ mt_get_path_pre(
   return MerkleTree_Low_mt_get_path_pre(mt, idx, path1, root);
 }
 
+/*
+  Getting a Merkle multiproof
+
+  @param[in]  mt   The Merkle tree
+  @param[in]  idx  The indices of the target hashes, in increasing order
+  @param[in]  n    The number of target hashes
+  @param[out] path A resulting multiproof that contains the leaf hashes.
+  @param[out] root The Merkle root
+
+  return The number of elements in the tree, or 0, leaving path and root
+  unchanged, if n is 0 or idx is not valid as checked by mt_get_paths_pre
+
+  Notes:
+  - The resulting path starts with the n leaf hashes, followed by the
+    sibling hashes needed to recompute the root, level by level from left to
+    right. A sibling that is itself on the way to the root from another target
+    is not included, so the multiproof is never longer than the n paths given
+    by mt_get_path, and is much shorter for neighbouring indices.
+  - For n = 1 the result is the path given by mt_get_path.
+  - The resulting path contains pointers to hashes in the tree, not copies of
+    the hash values.
+  - idx must be within the currently held indices in the tree (past the
+    last flush index).
+*/
+inline uint32_t
+mt_get_paths(
+  const MerkleTree_Low_merkle_tree *mt,
+  const uint64_t *idx,
+  uint32_t n,
+  MerkleTree_Low_path *path1,
+  uint8_t *root
+)
+{
+  return MerkleTree_Low_mt_get_paths(mt, idx, n, path1, root);
+}
+
+/*
+  Precondition predicate for mt_get_paths
+*/
+inline bool
+mt_get_paths_pre(
+  const MerkleTree_Low_merkle_tree *mt,
+  const uint64_t *idx,
+  uint32_t n,
+  const MerkleTree_Low_path *path1,
+  uint8_t *root
+)
+{
+  return MerkleTree_Low_mt_get_paths_pre(mt, idx, n, path1, root);
+}
+
 /*
   Flush the Merkle tree
 
@@ -428,6 +643,51 @@ mt_verify_pre(
   return MerkleTree_Low_mt_verify_pre(mt, tgt, max, path1, root);
 }
 
+/*
+  Client-side verification of a multiproof
+
+  @param[in]  mt   The Merkle tree
+  @param[in]  tgt  The indices of the target hashes, in increasing order
+  @param[in]  n    The number of target hashes
+  @param[in]  max  The maximum index + 1 of the tree when the multiproof was generated
+  @param[in]  path The multiproof to verify, as given by mt_get_paths
+  @param[in]  root
+
+  return true if the verification succeeded, false otherwise, including when
+  n is 0 or tgt is not valid as checked by mt_verify_multi_pre
+
+  Note: each ancestor shared by several targets is computed once. max - tgt[0]
+  must be less than 2^32.
+*/
+inline bool
+mt_verify_multi(
+  const MerkleTree_Low_merkle_tree *mt,
+  const uint64_t *tgt,
+  uint32_t n,
+  uint64_t max,
+  const MerkleTree_Low_path *path1,
+  uint8_t *root
+)
+{
+  return MerkleTree_Low_mt_verify_multi(mt, tgt, n, max, path1, root);
+}
+
+/*
+  Precondition predicate for mt_verify_multi
+*/
+inline bool
+mt_verify_multi_pre(
+  const MerkleTree_Low_merkle_tree *mt,
+  const uint64_t *tgt,
+  uint32_t n,
+  uint64_t max,
+  const MerkleTree_Low_path *path1,
+  uint8_t *root
+)
+{
+  return MerkleTree_Low_mt_verify_multi_pre(mt, tgt, n, max, path1, root);
+}
+
 /*
   Serialization size
 
@@ -509,141 +769,12 @@ inline MerkleTree_Low_path *mt_deserialize_path(const uint8_t *buf, uint64_t len
 }
 
 /*
-  Default hash function
+  Default hash function: one SHA2-256 compression of src1 || src2 from the
+  SHA2-256 initial hash value, without padding
 */
 void mt_sha256_compress(uint8_t *src1, uint8_t *src2, uint8_t *dst)
 {
-  uint32_t hash_size = (uint32_t)32U;
-  Spec_Hash_Definitions_hash_alg hash_alg = Spec_Hash_Definitions_SHA2_256;
-  uint8_t cb[64U] = { 0U };
-  memcpy(cb, src1, hash_size * sizeof (uint8_t));
-  memcpy(cb + (uint32_t)32U, src2, hash_size * sizeof (uint8_t));
-  uint32_t buf0[4U];
-  uint32_t buf1[5U];
-  uint32_t buf2[8U];
-  uint32_t buf3[8U];
-  uint64_t buf4[8U];
-  uint64_t buf5[8U];
-  uint32_t buf6[16U];
-  uint64_t buf[16U];
-  EverCrypt_Hash_state_s s;
-  switch (hash_alg)
-  {
-    case Spec_Hash_Definitions_MD5:
-      {
-        uint32_t init = (uint32_t)0U;
-        for (uint32_t i = (uint32_t)0U; i < (uint32_t)4U; i++)
-        {
-          buf0[i] = init;
-        }
-        s = ((EverCrypt_Hash_state_s){ .tag = EverCrypt_Hash_MD5_s, { .case_MD5_s = buf0 } });
-        break;
-      }
-    case Spec_Hash_Definitions_SHA1:
-      {
-        uint32_t init = (uint32_t)0U;
-        for (uint32_t i = (uint32_t)0U; i < (uint32_t)5U; i++)
-        {
-          buf1[i] = init;
-        }
-        s = ((EverCrypt_Hash_state_s){ .tag = EverCrypt_Hash_SHA1_s, { .case_SHA1_s = buf1 } });
-        break;
-      }
-    case Spec_Hash_Definitions_SHA2_224:
-      {
-        uint32_t init = (uint32_t)0U;
-        for (uint32_t i = (uint32_t)0U; i < (uint32_t)8U; i++)
-        {
-          buf2[i] = init;
-        }
-        s =
-          (
-            (EverCrypt_Hash_state_s){
-              .tag = EverCrypt_Hash_SHA2_224_s,
-              { .case_SHA2_224_s = buf2 }
-            }
-          );
-        break;
-      }
-    case Spec_Hash_Definitions_SHA2_256:
-      {
-        uint32_t init = (uint32_t)0U;
-        for (uint32_t i = (uint32_t)0U; i < (uint32_t)8U; i++)
-        {
-          buf3[i] = init;
-        }
-        s =
-          (
-            (EverCrypt_Hash_state_s){
-              .tag = EverCrypt_Hash_SHA2_256_s,
-              { .case_SHA2_256_s = buf3 }
-            }
-          );
-        break;
-      }
-    case Spec_Hash_Definitions_SHA2_384:
-      {
-        uint64_t init = (uint64_t)0U;
-        for (uint32_t i = (uint32_t)0U; i < (uint32_t)8U; i++)
-        {
-          buf4[i] = init;
-        }
-        s =
-          (
-            (EverCrypt_Hash_state_s){
-              .tag = EverCrypt_Hash_SHA2_384_s,
-              { .case_SHA2_384_s = buf4 }
-            }
-          );
-        break;
-      }
-    case Spec_Hash_Definitions_SHA2_512:
-      {
-        uint64_t init = (uint64_t)0U;
-        for (uint32_t i = (uint32_t)0U; i < (uint32_t)8U; i++)
-        {
-          buf5[i] = init;
-        }
-        s =
-          (
-            (EverCrypt_Hash_state_s){
-              .tag = EverCrypt_Hash_SHA2_512_s,
-              { .case_SHA2_512_s = buf5 }
-            }
-          );
-        break;
-      }
-    case Spec_Hash_Definitions_Blake2S:
-      {
-        uint32_t init = (uint32_t)0U;
-        for (uint32_t i = (uint32_t)0U; i < (uint32_t)16U; i++)
-        {
-          buf6[i] = init;
-        }
-        s =
-          ((EverCrypt_Hash_state_s){ .tag = EverCrypt_Hash_Blake2S_s, { .case_Blake2S_s = buf6 } });
-        break;
-      }
-    case Spec_Hash_Definitions_Blake2B:
-      {
-        uint64_t init = (uint64_t)0U;
-        for (uint32_t i = (uint32_t)0U; i < (uint32_t)16U; i++)
-        {
-          buf[i] = init;
-        }
-        s = ((EverCrypt_Hash_state_s){ .tag = EverCrypt_Hash_Blake2B_s, { .case_Blake2B_s = buf } });
-        break;
-      }
-    default:
-      {
-        KRML_HOST_EPRINTF("KreMLin incomplete match at %s:%d\n", __FILE__, __LINE__);
-        KRML_HOST_EXIT(253U);
-      }
-  }
-  EverCrypt_Hash_state_s st = s;
-  EverCrypt_Hash_init(&st);
-  EverCrypt_Hash_update2(&st, (uint64_t)0U, cb);
-  EverCrypt_Hash_finish(&st, dst);
+  EverCrypt_Hash_compress_256(src1, src2, dst);
 }
 
 /*
@@ -656,6 +787,37 @@ inline MerkleTree_Low_merkle_tree *mt_create(uint8_t *init)
   return MerkleTree_Low_mt_create_custom((uint32_t)32U, init, mt_sha256_compress);
 }
 
+/*
+  Construction wired to sha256 from EverCrypt, with arena storage
+
+  @param[in]  init   The initial hash
+*/
+inline MerkleTree_Low_merkle_tree *mt_create_arena(uint8_t *init)
+{
+  return MerkleTree_Low_mt_create_custom_arena((uint32_t)32U, init, mt_sha256_compress);
+}
+
+/*
+  Construction wired to sha256 from EverCrypt, with memory-mapped file storage
+
+  @param[in]  dir    Directory holding the level files, created if missing
+  @param[in]  init   The initial hash
+*/
+inline MerkleTree_Low_merkle_tree *mt_create_mmap(const char *dir, uint8_t *init)
+{
+  return MerkleTree_Low_mt_create_custom_mmap(dir, (uint32_t)32U, init, mt_sha256_compress);
+}
+
+/*
+  Reopen a tree written by mt_create_mmap
+
+  @param[in]  dir    Directory holding the level files
+*/
+inline MerkleTree_Low_merkle_tree *mt_open_mmap(const char *dir)
+{
+  return MerkleTree_Low_mt_open_custom_mmap(dir, (uint32_t)32U, mt_sha256_compress);
+}
+
 uint32_t MerkleTree_Low_uint32_32_max = (uint32_t)4294967295U;
 
 uint64_t MerkleTree_Low_uint32_max = (uint64_t)4294967295U;
@@ -857,61 +1019,580 @@ alloc_rid___uint8_t__uint32_t(regional__uint32_t__uint8_t_ rg, uint32_t len)
   return vec;
 }
 
-static MerkleTree_Low_merkle_tree
-*create_empty_mt(uint32_t hsz, void (*hash_fun)(uint8_t *x0, uint8_t *x1, uint8_t *x2))
+/*
+  Level files start with a header of mt_file_header_len bytes: magic, hash size
+  and level, followed for level 0 by the tree state i, j and offset, all little
+  endian. The hash of index k of the level follows at mt_file_header_len +
+  k * hash_size.
+*/
+static const uint32_t mt_file_header_len = (uint32_t)4096U;
+
+static const uint32_t mt_file_magic = (uint32_t)0x4d544631U;
+
+static uint64_t hash_file_reserve(uint32_t hsz, uint32_t lv)
 {
-  LowStar_Vector_vector_str__LowStar_Vector_vector_str___uint8_t_
-  hs =
-    alloc_rid__LowStar_Vector_vector_str__uint8_t__uint32_t((
-        (regional__uint32_t_LowStar_Vector_vector_str___uint8_t_){
-          .state = hsz,
-          .dummy = { .sz = (uint32_t)0U, .cap = (uint32_t)0U, .vs = NULL },
-          .r_alloc = hash_vec_r_alloc,
-          .r_free = hash_vec_r_free
-        }
-      ),
-      (uint32_t)32U);
-  LowStar_Vector_vector_str___uint8_t_
-  rhs =
-    alloc_rid___uint8_t__uint32_t((
-        (regional__uint32_t__uint8_t_){
-          .state = hsz,
-          .dummy = NULL,
-          .r_alloc = hash_r_alloc,
-          .r_free = hash_r_free
-        }
-      ),
-      (uint32_t)32U);
-  regional__uint32_t__uint8_t_
-  x00 = { .state = hsz, .dummy = NULL, .r_alloc = hash_r_alloc, .r_free = hash_r_free };
-  regional__uint32_t__uint8_t_
-  x0 = { .state = hsz, .dummy = NULL, .r_alloc = hash_r_alloc, .r_free = hash_r_free };
-  uint8_t *mroot = x00.r_alloc(x0.state);
-  KRML_CHECK_SIZE(sizeof (MerkleTree_Low_merkle_tree), (uint32_t)1U);
-  MerkleTree_Low_merkle_tree *mt = KRML_HOST_MALLOC(sizeof (MerkleTree_Low_merkle_tree));
-  mt[0U]
-  =
-    (
-      (MerkleTree_Low_merkle_tree){
-        .hash_size = hsz,
-        .offset = (uint64_t)0U,
-        .i = (uint32_t)0U,
-        .j = (uint32_t)0U,
-        .hs = hs,
-        .rhs_ok = false,
-        .rhs = rhs,
-        .mroot = mroot,
-        .hash_fun = hash_fun
-      }
-    );
-  return mt;
+  return (uint64_t)hsz << ((uint32_t)32U - lv);
 }
 
-static LowStar_Vector_vector_str___uint8_t_
-index__LowStar_Vector_vector_str__uint8_t_(
-  LowStar_Vector_vector_str__LowStar_Vector_vector_str___uint8_t_ vec,
-  uint32_t i
-)
+static void hash_file_store_header(MerkleTree_Low_merkle_tree mtv)
+{
+  uint8_t *h = mtv.arena[0U].base - mt_file_header_len;
+  store32_le(h + (uint32_t)12U, mtv.i);
+  store32_le(h + (uint32_t)16U, mtv.j);
+  store64_le(h + (uint32_t)20U, mtv.offset);
+}
+
+#if defined(_WIN32) || defined(_WIN64)
+
+static bool
+hash_file_map_all(
+  const char *dir,
+  uint32_t hsz,
+  bool create,
+  MerkleTree_Low_hash_arena *arena
+)
+{
+  return false;
+}
+
+static bool hash_file_grow(MerkleTree_Low_hash_arena *a, uint64_t end)
+{
+  return false;
+}
+
+static void hash_file_remove(const char *dir, uint32_t n)
+{
+}
+
+static bool hash_file_sync(MerkleTree_Low_hash_arena *a, uint64_t len)
+{
+  return false;
+}
+
+static bool hash_file_settle(uint32_t hsz, MerkleTree_Low_hash_arena *a)
+{
+  return false;
+}
+
+static void hash_file_unmap(uint32_t hsz, uint32_t lv, MerkleTree_Low_hash_arena *a)
+{
+}
+
+#else
+
+static char *hash_file_path(const char *dir, uint32_t lv)
+{
+  size_t len = strlen(dir) + (size_t)16U;
+  char *path = KRML_HOST_MALLOC(len);
+  if (path == NULL)
+  {
+    return NULL;
+  }
+  snprintf(path, len, "%s/level%02u", dir, (unsigned)lv);
+  return path;
+}
+
+static void hash_file_unmap(uint32_t hsz, uint32_t lv, MerkleTree_Low_hash_arena *a)
+{
+  MerkleTree_Low_hash_arena av = *a;
+  munmap(av.base - mt_file_header_len,
+    (size_t)((uint64_t)mt_file_header_len + hash_file_reserve(hsz, lv)));
+  close((int)av.fd);
+}
+
+/*
+  Opens, or creates, the file of level lv and maps it with room for every hash
+  the level can hold, so that hashes never move as the file grows.
+*/
+static bool
+hash_file_map(
+  const char *dir,
+  uint32_t hsz,
+  uint32_t lv,
+  bool create,
+  MerkleTree_Low_hash_arena *a
+)
+{
+  char *path = hash_file_path(dir, lv);
+  if (path == NULL)
+  {
+    return false;
+  }
+  int fd;
+  if (create)
+  {
+    fd = open(path, O_RDWR | O_CREAT | O_EXCL, 0644);
+  }
+  else
+  {
+    fd = open(path, O_RDWR);
+  }
+  KRML_HOST_FREE(path);
+  if (fd < 0)
+  {
+    return false;
+  }
+  struct stat st;
+  bool ok = fstat(fd, &st) == 0;
+  if (ok && create)
+  {
+    ok = ftruncate(fd, (off_t)mt_file_header_len) == 0;
+    st.st_size = (off_t)mt_file_header_len;
+  }
+  ok = ok && (uint64_t)st.st_size >= (uint64_t)mt_file_header_len;
+  size_t mlen = (size_t)((uint64_t)mt_file_header_len + hash_file_reserve(hsz, lv));
+  void *m = MAP_FAILED;
+  if (ok)
+  {
+    m = mmap(NULL, mlen, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_NORESERVE, fd, 0);
+    ok = m != MAP_FAILED;
+  }
+  if (ok && create)
+  {
+    store32_le((uint8_t *)m, mt_file_magic);
+    store32_le((uint8_t *)m + (uint32_t)4U, hsz);
+    store32_le((uint8_t *)m + (uint32_t)8U, lv);
+  }
+  ok =
+    ok
+    && load32_le((uint8_t *)m) == mt_file_magic
+    && load32_le((uint8_t *)m + (uint32_t)4U) == hsz
+    && load32_le((uint8_t *)m + (uint32_t)8U) == lv;
+  if (!ok)
+  {
+    if (m != MAP_FAILED)
+    {
+      munmap(m, mlen);
+    }
+    close(fd);
+    return false;
+  }
+  *a
+  =
+    (
+      (MerkleTree_Low_hash_arena){
+        .chunk_len = (uint32_t)0U,
+        .head = (uint32_t)0U,
+        .tail = (uint32_t)0U,
+        .chunks = { .sz = (uint32_t)0U, .cap = (uint32_t)0U, .vs = NULL },
+        .base = (uint8_t *)m + mt_file_header_len,
+        .fd = (int32_t)fd,
+        .len = (uint64_t)st.st_size - (uint64_t)mt_file_header_len
+      }
+    );
+  return true;
+}
+
+/*
+  Deletes the files of the first n levels.
+*/
+static void hash_file_remove(const char *dir, uint32_t n)
+{
+  for (uint32_t k = (uint32_t)0U; k < n; k++)
+  {
+    char *path = hash_file_path(dir, k);
+    if (path != NULL)
+    {
+      unlink(path);
+      KRML_HOST_FREE(path);
+    }
+  }
+}
+
+/*
+  Maps the files of all 32 levels, or none of them. Creating a tree fails if
+  dir already holds one.
+*/
+static bool
+hash_file_map_all(
+  const char *dir,
+  uint32_t hsz,
+  bool create,
+  MerkleTree_Low_hash_arena *arena
+)
+{
+  if (sizeof (size_t) < (size_t)8U)
+  {
+    return false;
+  }
+  if (create && mkdir(dir, 0755) != 0 && errno != EEXIST)
+  {
+    return false;
+  }
+  uint32_t lv = (uint32_t)0U;
+  while (lv < (uint32_t)32U && hash_file_map(dir, hsz, lv, create, arena + lv))
+  {
+    lv++;
+  }
+  if (lv == (uint32_t)32U)
+  {
+    return true;
+  }
+  for (uint32_t k = (uint32_t)0U; k < lv; k++)
+  {
+    hash_file_unmap(hsz, k, arena + k);
+  }
+  if (create)
+  {
+    hash_file_remove(dir, lv);
+  }
+  return false;
+}
+
+static bool hash_file_grow(MerkleTree_Low_hash_arena *a, uint64_t end)
+{
+  MerkleTree_Low_hash_arena av = *a;
+  uint64_t len = av.len;
+  if (len < (uint64_t)65536U)
+  {
+    len = (uint64_t)65536U;
+  }
+  while (len < end)
+  {
+    len = len * (uint64_t)2U;
+  }
+  if (ftruncate((int)av.fd, (off_t)((uint64_t)mt_file_header_len + len)) != 0)
+  {
+    return false;
+  }
+  *a
+  =
+    (
+      (MerkleTree_Low_hash_arena){
+        .chunk_len = av.chunk_len,
+        .head = av.head,
+        .tail = av.tail,
+        .chunks = av.chunks,
+        .base = av.base,
+        .fd = av.fd,
+        .len = len
+      }
+    );
+  return true;
+}
+
+/*
+  Writes the header and the first len bytes of hashes of a level to disk.
+*/
+static bool hash_file_sync(MerkleTree_Low_hash_arena *a, uint64_t len)
+{
+  MerkleTree_Low_hash_arena av = *a;
+  return
+    msync(av.base - mt_file_header_len,
+      (size_t)((uint64_t)mt_file_header_len + len),
+      MS_SYNC)
+    == 0;
+}
+
+/*
+  Releases the disk space of the hashes before head, on file systems that
+  support it, and truncates the file after tail.
+*/
+static bool hash_file_settle(uint32_t hsz, MerkleTree_Low_hash_arena *a)
+{
+  MerkleTree_Low_hash_arena av = *a;
+  #ifdef MADV_REMOVE
+  uint64_t ps = (uint64_t)sysconf(_SC_PAGESIZE);
+  uint64_t from = ((uint64_t)mt_file_header_len + ps - (uint64_t)1U) / ps * ps;
+  uint64_t to = ((uint64_t)mt_file_header_len + (uint64_t)av.head * (uint64_t)hsz) / ps * ps;
+  if (to > from)
+  {
+    madvise(av.base - mt_file_header_len + from, (size_t)(to - from), MADV_REMOVE);
+  }
+  #endif
+  uint64_t len = (uint64_t)av.tail * (uint64_t)hsz;
+  if (ftruncate((int)av.fd, (off_t)((uint64_t)mt_file_header_len + len)) != 0)
+  {
+    return false;
+  }
+  *a
+  =
+    (
+      (MerkleTree_Low_hash_arena){
+        .chunk_len = av.chunk_len,
+        .head = av.head,
+        .tail = av.tail,
+        .chunks = av.chunks,
+        .base = av.base,
+        .fd = av.fd,
+        .len = len
+      }
+    );
+  return true;
+}
+
+#endif
+
+static uint8_t *hash_arena_alloc(uint32_t hsz, MerkleTree_Low_hash_arena *a)
+{
+  MerkleTree_Low_hash_arena av = *a;
+  if (!(av.base == NULL))
+  {
+    /* the insert paths grow the file first, in hash_file_reserve_insert */
+    uint64_t pos = (uint64_t)av.tail * (uint64_t)hsz;
+    MerkleTree_Low_hash_arena gv = *a;
+    *a
+    =
+      (
+        (MerkleTree_Low_hash_arena){
+          .chunk_len = gv.chunk_len,
+          .head = gv.head,
+          .tail = gv.tail + (uint32_t)1U,
+          .chunks = gv.chunks,
+          .base = gv.base,
+          .fd = gv.fd,
+          .len = gv.len
+        }
+      );
+    return gv.base + pos;
+  }
+  if (av.chunks.sz == (uint32_t)0U || av.tail == av.chunk_len)
+  {
+    KRML_CHECK_SIZE(sizeof (uint8_t), av.chunk_len * hsz);
+    uint8_t *c = KRML_HOST_CALLOC(av.chunk_len * hsz, sizeof (uint8_t));
+    LowStar_Vector_vector_str___uint8_t_ chunks = insert___uint8_t_(av.chunks, c);
+    uint32_t head;
+    if (av.chunks.sz == (uint32_t)0U)
+    {
+      head = (uint32_t)0U;
+    }
+    else
+    {
+      head = av.head;
+    }
+    *a
+    =
+      (
+        (MerkleTree_Low_hash_arena){
+          .chunk_len = av.chunk_len,
+          .head = head,
+          .tail = (uint32_t)1U,
+          .chunks = chunks,
+          .base = av.base,
+          .fd = av.fd,
+          .len = av.len
+        }
+      );
+    return c;
+  }
+  uint8_t *h = av.chunks.vs[av.chunks.sz - (uint32_t)1U] + av.tail * hsz;
+  *a
+  =
+    (
+      (MerkleTree_Low_hash_arena){
+        .chunk_len = av.chunk_len,
+        .head = av.head,
+        .tail = av.tail + (uint32_t)1U,
+        .chunks = av.chunks,
+        .base = av.base,
+        .fd = av.fd,
+        .len = av.len
+      }
+    );
+  return h;
+}
+
+/*
+  Releases the first n hashes of a level, freeing the chunks they leave empty.
+*/
+static void hash_arena_drop_front(MerkleTree_Low_hash_arena *a, uint32_t n)
+{
+  MerkleTree_Low_hash_arena av = *a;
+  if (!(av.base == NULL))
+  {
+    *a
+    =
+      (
+        (MerkleTree_Low_hash_arena){
+          .chunk_len = av.chunk_len,
+          .head = av.head + n,
+          .tail = av.tail,
+          .chunks = av.chunks,
+          .base = av.base,
+          .fd = av.fd,
+          .len = av.len
+        }
+      );
+    return;
+  }
+  uint32_t head = av.head;
+  uint32_t tail = av.tail;
+  uint32_t nf = (uint32_t)0U;
+  for (uint32_t i = (uint32_t)0U; i < n; i++)
+  {
+    head = head + (uint32_t)1U;
+    if (av.chunks.sz - nf == (uint32_t)1U && head == tail)
+    {
+      KRML_HOST_FREE(av.chunks.vs[nf]);
+      nf = nf + (uint32_t)1U;
+      head = (uint32_t)0U;
+      tail = (uint32_t)0U;
+    }
+    else if (head == av.chunk_len)
+    {
+      KRML_HOST_FREE(av.chunks.vs[nf]);
+      nf = nf + (uint32_t)1U;
+      head = (uint32_t)0U;
+    }
+  }
+  uint32_t n_shifted = av.chunks.sz - nf;
+  if (!(nf == (uint32_t)0U))
+  {
+    for (uint32_t i = (uint32_t)0U; i < n_shifted; i++)
+    {
+      uint8_t *uu____0 = av.chunks.vs[nf + i];
+      av.chunks.vs[i] = uu____0;
+    }
+  }
+  *a
+  =
+    (
+      (MerkleTree_Low_hash_arena){
+        .chunk_len = av.chunk_len,
+        .head = head,
+        .tail = tail,
+        .chunks = { .sz = n_shifted, .cap = av.chunks.cap, .vs = av.chunks.vs },
+        .base = av.base,
+        .fd = av.fd,
+        .len = av.len
+      }
+    );
+}
+
+/*
+  Releases the last n hashes of a level, freeing the chunks they leave empty.
+*/
+static void hash_arena_drop_back(MerkleTree_Low_hash_arena *a, uint32_t n)
+{
+  MerkleTree_Low_hash_arena av = *a;
+  if (!(av.base == NULL))
+  {
+    *a
+    =
+      (
+        (MerkleTree_Low_hash_arena){
+          .chunk_len = av.chunk_len,
+          .head = av.head,
+          .tail = av.tail - n,
+          .chunks = av.chunks,
+          .base = av.base,
+          .fd = av.fd,
+          .len = av.len
+        }
+      );
+    return;
+  }
+  uint32_t head = av.head;
+  uint32_t tail = av.tail;
+  uint32_t sz = av.chunks.sz;
+  for (uint32_t i = (uint32_t)0U; i < n; i++)
+  {
+    tail = tail - (uint32_t)1U;
+    if (sz == (uint32_t)1U && tail == head)
+    {
+      KRML_HOST_FREE(av.chunks.vs[0U]);
+      sz = (uint32_t)0U;
+      head = (uint32_t)0U;
+      tail = (uint32_t)0U;
+    }
+    else if (tail == (uint32_t)0U)
+    {
+      KRML_HOST_FREE(av.chunks.vs[sz - (uint32_t)1U]);
+      sz = sz - (uint32_t)1U;
+      tail = av.chunk_len;
+    }
+  }
+  *a
+  =
+    (
+      (MerkleTree_Low_hash_arena){
+        .chunk_len = av.chunk_len,
+        .head = head,
+        .tail = tail,
+        .chunks = { .sz = sz, .cap = av.chunks.cap, .vs = av.chunks.vs },
+        .base = av.base,
+        .fd = av.fd,
+        .len = av.len
+      }
+    );
+}
+
+static void hash_arena_free(uint32_t hsz, uint32_t lv, MerkleTree_Low_hash_arena *a)
+{
+  MerkleTree_Low_hash_arena av = *a;
+  if (!(av.base == NULL))
+  {
+    hash_file_settle(hsz, a);
+    hash_file_unmap(hsz, lv, a);
+    return;
+  }
+  for (uint32_t i = (uint32_t)0U; i < av.chunks.sz; i++)
+  {
+    KRML_HOST_FREE(av.chunks.vs[i]);
+  }
+  free___uint8_t_(av.chunks);
+}
+
+static MerkleTree_Low_merkle_tree
+*create_empty_mt(
+  uint32_t hsz,
+  void (*hash_fun)(uint8_t *x0, uint8_t *x1, uint8_t *x2),
+  MerkleTree_Low_hash_arena *arena
+)
+{
+  LowStar_Vector_vector_str__LowStar_Vector_vector_str___uint8_t_
+  hs =
+    alloc_rid__LowStar_Vector_vector_str__uint8_t__uint32_t((
+        (regional__uint32_t_LowStar_Vector_vector_str___uint8_t_){
+          .state = hsz,
+          .dummy = { .sz = (uint32_t)0U, .cap = (uint32_t)0U, .vs = NULL },
+          .r_alloc = hash_vec_r_alloc,
+          .r_free = hash_vec_r_free
+        }
+      ),
+      (uint32_t)32U);
+  LowStar_Vector_vector_str___uint8_t_
+  rhs =
+    alloc_rid___uint8_t__uint32_t((
+        (regional__uint32_t__uint8_t_){
+          .state = hsz,
+          .dummy = NULL,
+          .r_alloc = hash_r_alloc,
+          .r_free = hash_r_free
+        }
+      ),
+      (uint32_t)32U);
+  regional__uint32_t__uint8_t_
+  x00 = { .state = hsz, .dummy = NULL, .r_alloc = hash_r_alloc, .r_free = hash_r_free };
+  regional__uint32_t__uint8_t_
+  x0 = { .state = hsz, .dummy = NULL, .r_alloc = hash_r_alloc, .r_free = hash_r_free };
+  uint8_t *mroot = x00.r_alloc(x0.state);
+  KRML_CHECK_SIZE(sizeof (MerkleTree_Low_merkle_tree), (uint32_t)1U);
+  MerkleTree_Low_merkle_tree *mt = KRML_HOST_MALLOC(sizeof (MerkleTree_Low_merkle_tree));
+  mt[0U]
+  =
+    (
+      (MerkleTree_Low_merkle_tree){
+        .hash_size = hsz,
+        .offset = (uint64_t)0U,
+        .i = (uint32_t)0U,
+        .j = (uint32_t)0U,
+        .hs = hs,
+        .rhs_ok = false,
+        .rhs = rhs,
+        .mroot = mroot,
+        .hash_fun = hash_fun,
+        .arena = arena
+      }
+    );
+  return mt;
+}
+
+static LowStar_Vector_vector_str___uint8_t_
+index__LowStar_Vector_vector_str__uint8_t_(
+  LowStar_Vector_vector_str__LowStar_Vector_vector_str___uint8_t_ vec,
+  uint32_t i
+)
 {
   return vec.vs[i];
 }
@@ -957,15 +1638,29 @@ free__LowStar_Vector_vector_str__uint8_t__uint32_t(
 void MerkleTree_Low_mt_free(MerkleTree_Low_merkle_tree *mt)
 {
   MerkleTree_Low_merkle_tree mtv = *mt;
-  free__LowStar_Vector_vector_str__uint8_t__uint32_t((
-      (regional__uint32_t_LowStar_Vector_vector_str___uint8_t_){
-        .state = mtv.hash_size,
-        .dummy = { .sz = (uint32_t)0U, .cap = (uint32_t)0U, .vs = NULL },
-        .r_alloc = hash_vec_r_alloc,
-        .r_free = hash_vec_r_free
-      }
-    ),
-    mtv.hs);
+  if (mtv.arena == NULL)
+  {
+    free__LowStar_Vector_vector_str__uint8_t__uint32_t((
+        (regional__uint32_t_LowStar_Vector_vector_str___uint8_t_){
+          .state = mtv.hash_size,
+          .dummy = { .sz = (uint32_t)0U, .cap = (uint32_t)0U, .vs = NULL },
+          .r_alloc = hash_vec_r_alloc,
+          .r_free = hash_vec_r_free
+        }
+      ),
+      mtv.hs);
+  }
+  else
+  {
+    MerkleTree_Low_mt_sync(mt);
+    for (uint32_t i = (uint32_t)0U; i < mtv.hs.sz; i++)
+    {
+      free___uint8_t_(index__LowStar_Vector_vector_str__uint8_t_(mtv.hs, i));
+      hash_arena_free(mtv.hash_size, i, mtv.arena + i);
+    }
+    free__LowStar_Vector_vector_str__uint8_t_(mtv.hs);
+    KRML_HOST_FREE(mtv.arena);
+  }
   free___uint8_t__uint32_t((
       (regional__uint32_t__uint8_t_){
         .state = mtv.hash_size,
@@ -1021,35 +1716,80 @@ insert_(
   uint32_t lv,
   uint32_t j,
   LowStar_Vector_vector_str__LowStar_Vector_vector_str___uint8_t_ hs,
+  MerkleTree_Low_hash_arena *arena,
   uint8_t *acc,
   void (*hash_fun)(uint8_t *x0, uint8_t *x1, uint8_t *x2)
 )
 {
   LowStar_Vector_vector_str___uint8_t_
   uu____0 = index__LowStar_Vector_vector_str__uint8_t_(hs, lv);
-  LowStar_Vector_vector_str___uint8_t_
-  ihv =
-    insert_copy___uint8_t__uint32_t((
-        (regional__uint32_t__uint8_t_){
-          .state = hsz,
-          .dummy = NULL,
-          .r_alloc = hash_r_alloc,
-          .r_free = hash_r_free
-        }
-      ),
-      hash_copy,
-      uu____0,
-      acc);
+  LowStar_Vector_vector_str___uint8_t_ ihv;
+  if (arena == NULL)
+  {
+    ihv =
+      insert_copy___uint8_t__uint32_t((
+          (regional__uint32_t__uint8_t_){
+            .state = hsz,
+            .dummy = NULL,
+            .r_alloc = hash_r_alloc,
+            .r_free = hash_r_free
+          }
+        ),
+        hash_copy,
+        uu____0,
+        acc);
+  }
+  else
+  {
+    uint8_t *nv = hash_arena_alloc(hsz, arena + lv);
+    hash_copy(hsz, acc, nv);
+    ihv = insert___uint8_t__uint32_t(uu____0, nv);
+  }
   assign__LowStar_Vector_vector_str__uint8_t__uint32_t(hs, lv, ihv);
   if (j % (uint32_t)2U == (uint32_t)1U)
   {
     LowStar_Vector_vector_str___uint8_t_ lvhs = index__LowStar_Vector_vector_str__uint8_t_(hs, lv);
     hash_fun(index___uint8_t_(lvhs, lvhs.sz - (uint32_t)2U), acc, acc);
-    insert_(hsz, lv + (uint32_t)1U, j / (uint32_t)2U, hs, acc, hash_fun);
+    insert_(hsz, lv + (uint32_t)1U, j / (uint32_t)2U, hs, arena, acc, hash_fun);
     return;
   }
 }
 
+/*
+  Makes room in the level files of a memory-mapped tree for n more leaves and
+  the nodes above them, before the tree is changed, so that a full disk leaves
+  the tree as it was.
+
+  Slots below the j recorded in the file header still hold the tree as of the
+  last mt_sync. After mt_retract_to, the retracted tree is synced first, so
+  that the new hashes do not overwrite the ones a crash would reopen.
+*/
+static bool hash_file_reserve_insert(MerkleTree_Low_merkle_tree *mt, uint32_t n)
+{
+  MerkleTree_Low_merkle_tree mtv = *mt;
+  if (mtv.arena == NULL || mtv.arena[0U].base == NULL)
+  {
+    return true;
+  }
+  uint8_t *h = mtv.arena[0U].base - mt_file_header_len;
+  if (mtv.j < load32_le(h + (uint32_t)16U) && !MerkleTree_Low_mt_sync(mt))
+  {
+    return false;
+  }
+  uint32_t nj = mtv.j + n;
+  for (uint32_t lv = (uint32_t)0U; lv < (uint32_t)32U; lv++)
+  {
+    MerkleTree_Low_hash_arena av = mtv.arena[lv];
+    uint32_t cnt = (nj >> lv) - (mtv.j >> lv);
+    uint64_t end = ((uint64_t)av.tail + (uint64_t)cnt) * (uint64_t)mtv.hash_size;
+    if (end > av.len && !hash_file_grow(mtv.arena + lv, end))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
 bool MerkleTree_Low_mt_insert_pre(const MerkleTree_Low_merkle_tree *mt, uint8_t *v)
 {
   MerkleTree_Low_merkle_tree mt1 = *(MerkleTree_Low_merkle_tree *)mt;
@@ -1059,39 +1799,336 @@ bool MerkleTree_Low_mt_insert_pre(const MerkleTree_Low_merkle_tree *mt, uint8_t
     && MerkleTree_Low_uint64_max - mt1.offset >= (uint64_t)(mt1.j + (uint32_t)1U);
 }
 
-void MerkleTree_Low_mt_insert(MerkleTree_Low_merkle_tree *mt, uint8_t *v)
+bool MerkleTree_Low_mt_insert(MerkleTree_Low_merkle_tree *mt, uint8_t *v)
+{
+  if (!hash_file_reserve_insert(mt, (uint32_t)1U))
+  {
+    return false;
+  }
+  MerkleTree_Low_merkle_tree mtv = *mt;
+  LowStar_Vector_vector_str__LowStar_Vector_vector_str___uint8_t_ hs = mtv.hs;
+  uint32_t hsz1 = mtv.hash_size;
+  insert_(hsz1, (uint32_t)0U, mtv.j, hs, mtv.arena, v, mtv.hash_fun);
+  *mt
+  =
+    (
+      (MerkleTree_Low_merkle_tree){
+        .hash_size = mtv.hash_size,
+        .offset = mtv.offset,
+        .i = mtv.i,
+        .j = mtv.j + (uint32_t)1U,
+        .hs = mtv.hs,
+        .rhs_ok = false,
+        .rhs = mtv.rhs,
+        .mroot = mtv.mroot,
+        .hash_fun = mtv.hash_fun,
+        .arena = mtv.arena
+      }
+    );
+  return true;
+}
+
+bool
+MerkleTree_Low_mt_insert_batch_pre(
+  const MerkleTree_Low_merkle_tree *mt,
+  uint8_t *leaves,
+  uint32_t n
+)
+{
+  MerkleTree_Low_merkle_tree mt1 = *(MerkleTree_Low_merkle_tree *)mt;
+  return
+    MerkleTree_Low_uint32_32_max - mt1.j
+    >= n
+    && MerkleTree_Low_uint64_max - mt1.offset >= (uint64_t)mt1.j + (uint64_t)n;
+}
+
+static uint8_t *alloc_node(uint32_t hsz, MerkleTree_Low_hash_arena *arena, uint32_t lv)
+{
+  if (arena == NULL)
+  {
+    return hash_r_alloc(hsz);
+  }
+  return hash_arena_alloc(hsz, arena + lv);
+}
+
+bool MerkleTree_Low_mt_insert_batch(MerkleTree_Low_merkle_tree *mt, uint8_t *leaves, uint32_t n)
+{
+  if (!hash_file_reserve_insert(mt, n))
+  {
+    return false;
+  }
+  MerkleTree_Low_merkle_tree mtv = *mt;
+  LowStar_Vector_vector_str__LowStar_Vector_vector_str___uint8_t_ hs = mtv.hs;
+  uint32_t hsz = mtv.hash_size;
+  uint32_t j = mtv.j;
+  uint32_t nj = mtv.j + n;
+  bool sha256 = mtv.hash_fun == mt_sha256_compress && hsz == (uint32_t)32U;
+  for (uint32_t k = (uint32_t)0U; k < n; k++)
+  {
+    uint8_t *nv = alloc_node(hsz, mtv.arena, (uint32_t)0U);
+    hash_copy(hsz, leaves + k * hsz, nv);
+    hs.vs[0U] = insert___uint8_t_(hs.vs[0U], nv);
+  }
+  uint8_t *src1[64U];
+  uint8_t *src2[64U];
+  uint8_t *dst[64U];
+  for
+  (uint32_t lv = (uint32_t)0U;
+    lv + (uint32_t)1U < hs.sz && nj >> (lv + (uint32_t)1U) > j >> (lv + (uint32_t)1U);
+    lv++)
+  {
+    uint32_t lo = j >> (lv + (uint32_t)1U);
+    uint32_t hi = nj >> (lv + (uint32_t)1U);
+    uint32_t ofs = MerkleTree_Low_offset_of(mtv.i >> lv);
+    uint32_t m = lo;
+    while (m < hi)
+    {
+      uint32_t cnt = hi - m;
+      if (cnt > (uint32_t)64U)
+      {
+        cnt = (uint32_t)64U;
+      }
+      LowStar_Vector_vector_str___uint8_t_ lvhs = hs.vs[lv];
+      for (uint32_t t = (uint32_t)0U; t < cnt; t++)
+      {
+        uint32_t c = (uint32_t)2U * (m + t) - ofs;
+        src1[t] = lvhs.vs[c];
+        src2[t] = lvhs.vs[c + (uint32_t)1U];
+        dst[t] = alloc_node(hsz, mtv.arena, lv + (uint32_t)1U);
+      }
+      if (sha256)
+      {
+        EverCrypt_Hash_compress_256_mb(cnt, src1, src2, dst);
+      }
+      else
+      {
+        for (uint32_t t = (uint32_t)0U; t < cnt; t++)
+        {
+          mtv.hash_fun(src1[t], src2[t], dst[t]);
+        }
+      }
+      for (uint32_t t = (uint32_t)0U; t < cnt; t++)
+      {
+        hs.vs[lv + (uint32_t)1U] = insert___uint8_t_(hs.vs[lv + (uint32_t)1U], dst[t]);
+      }
+      m = m + cnt;
+    }
+  }
+  *mt
+  =
+    (
+      (MerkleTree_Low_merkle_tree){
+        .hash_size = mtv.hash_size,
+        .offset = mtv.offset,
+        .i = mtv.i,
+        .j = nj,
+        .hs = mtv.hs,
+        .rhs_ok = false,
+        .rhs = mtv.rhs,
+        .mroot = mtv.mroot,
+        .hash_fun = mtv.hash_fun,
+        .arena = mtv.arena
+      }
+    );
+  return true;
+}
+
+MerkleTree_Low_merkle_tree
+*MerkleTree_Low_mt_create_custom(
+  uint32_t hsz,
+  uint8_t *init,
+  void (*hash_fun)(uint8_t *x0, uint8_t *x1, uint8_t *x2)
+)
+{
+  MerkleTree_Low_merkle_tree *mt = create_empty_mt(hsz, hash_fun, NULL);
+  MerkleTree_Low_mt_insert(mt, init);
+  return mt;
+}
+
+MerkleTree_Low_merkle_tree
+*MerkleTree_Low_mt_create_custom_arena(
+  uint32_t hsz,
+  uint8_t *init,
+  void (*hash_fun)(uint8_t *x0, uint8_t *x1, uint8_t *x2)
+)
+{
+  uint32_t chunk_len;
+  if (hsz >= (uint32_t)4096U)
+  {
+    chunk_len = (uint32_t)1U;
+  }
+  else
+  {
+    chunk_len = (uint32_t)4096U / hsz;
+  }
+  KRML_CHECK_SIZE(sizeof (MerkleTree_Low_hash_arena), (uint32_t)32U);
+  MerkleTree_Low_hash_arena
+  *arena = KRML_HOST_MALLOC(sizeof (MerkleTree_Low_hash_arena) * (uint32_t)32U);
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)32U; i++)
+  {
+    arena[i]
+    =
+      (
+        (MerkleTree_Low_hash_arena){
+          .chunk_len = chunk_len,
+          .head = (uint32_t)0U,
+          .tail = (uint32_t)0U,
+          .chunks = { .sz = (uint32_t)0U, .cap = (uint32_t)0U, .vs = NULL },
+          .base = NULL,
+          .fd = (int32_t)-1,
+          .len = (uint64_t)0U
+        }
+      );
+  }
+  MerkleTree_Low_merkle_tree *mt = create_empty_mt(hsz, hash_fun, arena);
+  MerkleTree_Low_mt_insert(mt, init);
+  return mt;
+}
+
+MerkleTree_Low_merkle_tree
+*MerkleTree_Low_mt_create_custom_mmap(
+  const char *dir,
+  uint32_t hsz,
+  uint8_t *init,
+  void (*hash_fun)(uint8_t *x0, uint8_t *x1, uint8_t *x2)
+)
+{
+  KRML_CHECK_SIZE(sizeof (MerkleTree_Low_hash_arena), (uint32_t)32U);
+  MerkleTree_Low_hash_arena
+  *arena = KRML_HOST_MALLOC(sizeof (MerkleTree_Low_hash_arena) * (uint32_t)32U);
+  if (!hash_file_map_all(dir, hsz, true, arena))
+  {
+    KRML_HOST_FREE(arena);
+    return NULL;
+  }
+  MerkleTree_Low_merkle_tree *mt = create_empty_mt(hsz, hash_fun, arena);
+  if (!MerkleTree_Low_mt_insert(mt, init))
+  {
+    MerkleTree_Low_mt_free(mt);
+    hash_file_remove(dir, (uint32_t)32U);
+    return NULL;
+  }
+  hash_file_store_header(*mt);
+  return mt;
+}
+
+MerkleTree_Low_merkle_tree
+*MerkleTree_Low_mt_open_custom_mmap(
+  const char *dir,
+  uint32_t hsz,
+  void (*hash_fun)(uint8_t *x0, uint8_t *x1, uint8_t *x2)
+)
 {
+  KRML_CHECK_SIZE(sizeof (MerkleTree_Low_hash_arena), (uint32_t)32U);
+  MerkleTree_Low_hash_arena
+  *arena = KRML_HOST_MALLOC(sizeof (MerkleTree_Low_hash_arena) * (uint32_t)32U);
+  if (!hash_file_map_all(dir, hsz, false, arena))
+  {
+    KRML_HOST_FREE(arena);
+    return NULL;
+  }
+  uint8_t *h = arena[0U].base - mt_file_header_len;
+  uint32_t i = load32_le(h + (uint32_t)12U);
+  uint32_t j = load32_le(h + (uint32_t)16U);
+  uint64_t offset = load64_le(h + (uint32_t)20U);
+  bool ok = i < j && MerkleTree_Low_uint64_max - offset >= (uint64_t)j;
+  for (uint32_t lv = (uint32_t)0U; lv < (uint32_t)32U; lv++)
+  {
+    ok = ok && arena[lv].len >= (uint64_t)(j >> lv) * (uint64_t)hsz;
+  }
+  if (!ok)
+  {
+    for (uint32_t lv = (uint32_t)0U; lv < (uint32_t)32U; lv++)
+    {
+      hash_file_unmap(hsz, lv, arena + lv);
+    }
+    KRML_HOST_FREE(arena);
+    return NULL;
+  }
+  MerkleTree_Low_merkle_tree *mt = create_empty_mt(hsz, hash_fun, arena);
   MerkleTree_Low_merkle_tree mtv = *mt;
-  LowStar_Vector_vector_str__LowStar_Vector_vector_str___uint8_t_ hs = mtv.hs;
-  uint32_t hsz1 = mtv.hash_size;
-  insert_(hsz1, (uint32_t)0U, mtv.j, hs, v, mtv.hash_fun);
+  for (uint32_t lv = (uint32_t)0U; lv < (uint32_t)32U; lv++)
+  {
+    uint32_t lo = MerkleTree_Low_offset_of(i >> lv);
+    uint32_t hi = j >> lv;
+    uint32_t sz = hi - lo;
+    uint32_t cap;
+    if (sz == (uint32_t)0U)
+    {
+      cap = (uint32_t)1U;
+    }
+    else
+    {
+      cap = sz;
+    }
+    LowStar_Vector_vector_str___uint8_t_ hv = alloc_reserve___uint8_t_(cap, NULL);
+    for (uint32_t k = (uint32_t)0U; k < sz; k++)
+    {
+      hv.vs[k] = arena[lv].base + (uint64_t)(lo + k) * (uint64_t)hsz;
+    }
+    free___uint8_t_(mtv.hs.vs[lv]);
+    mtv.hs.vs[lv] = ((LowStar_Vector_vector_str___uint8_t_){ .sz = sz, .cap = cap, .vs = hv.vs });
+    MerkleTree_Low_hash_arena av = arena[lv];
+    arena[lv]
+    =
+      (
+        (MerkleTree_Low_hash_arena){
+          .chunk_len = av.chunk_len,
+          .head = lo,
+          .tail = hi,
+          .chunks = av.chunks,
+          .base = av.base,
+          .fd = av.fd,
+          .len = av.len
+        }
+      );
+  }
   *mt
   =
     (
       (MerkleTree_Low_merkle_tree){
         .hash_size = mtv.hash_size,
-        .offset = mtv.offset,
-        .i = mtv.i,
-        .j = mtv.j + (uint32_t)1U,
+        .offset = offset,
+        .i = i,
+        .j = j,
         .hs = mtv.hs,
         .rhs_ok = false,
         .rhs = mtv.rhs,
         .mroot = mtv.mroot,
-        .hash_fun = mtv.hash_fun
+        .hash_fun = mtv.hash_fun,
+        .arena = mtv.arena
       }
     );
+  return mt;
 }
 
-MerkleTree_Low_merkle_tree
-*MerkleTree_Low_mt_create_custom(
-  uint32_t hsz,
-  uint8_t *init,
-  void (*hash_fun)(uint8_t *x0, uint8_t *x1, uint8_t *x2)
-)
+bool MerkleTree_Low_mt_sync(MerkleTree_Low_merkle_tree *mt)
 {
-  MerkleTree_Low_merkle_tree *mt = create_empty_mt(hsz, hash_fun);
-  MerkleTree_Low_mt_insert(mt, init);
-  return mt;
+  MerkleTree_Low_merkle_tree mtv = *mt;
+  if (mtv.arena == NULL || mtv.arena[0U].base == NULL)
+  {
+    return true;
+  }
+  bool ok = true;
+  for (uint32_t lv = (uint32_t)0U; lv < (uint32_t)32U; lv++)
+  {
+    MerkleTree_Low_hash_arena av = mtv.arena[lv];
+    ok = ok && hash_file_sync(mtv.arena + lv, (uint64_t)av.tail * (uint64_t)mtv.hash_size);
+  }
+  if (!ok)
+  {
+    return false;
+  }
+  hash_file_store_header(mtv);
+  if (!hash_file_sync(mtv.arena, (uint64_t)0U))
+  {
+    return false;
+  }
+  for (uint32_t lv = (uint32_t)0U; lv < (uint32_t)32U; lv++)
+  {
+    ok = hash_file_settle(mtv.hash_size, mtv.arena + lv) && ok;
+  }
+  return ok;
 }
 
 bool MerkleTree_Low_uu___is_Path(MerkleTree_Low_path projectee)
@@ -1273,7 +2310,8 @@ void MerkleTree_Low_mt_get_root(const MerkleTree_Low_merkle_tree *mt, uint8_t *r
         .rhs_ok = true,
         .rhs = rhs,
         .mroot = mroot,
-        .hash_fun = hash_fun
+        .hash_fun = hash_fun,
+        .arena = mtv.arena
       }
     );
 }
@@ -1472,6 +2510,7 @@ mt_flush_to_(
   uint32_t hsz,
   uint32_t lv,
   LowStar_Vector_vector_str__LowStar_Vector_vector_str___uint8_t_ hs,
+  MerkleTree_Low_hash_arena *arena,
   uint32_t pi,
   uint32_t i
 )
@@ -1482,7 +2521,20 @@ mt_flush_to_(
   {
     uint32_t ofs = oi - opi;
     LowStar_Vector_vector_str___uint8_t_ hvec = index__LowStar_Vector_vector_str__uint8_t_(hs, lv);
-    if (!(ofs == (uint32_t)0U))
+    if (!(arena == NULL))
+    {
+      uint32_t n;
+      if (ofs >= hvec.sz)
+      {
+        n = hvec.sz;
+      }
+      else
+      {
+        n = ofs;
+      }
+      hash_arena_drop_front(arena + lv, n);
+    }
+    else if (!(ofs == (uint32_t)0U))
     {
       free_elems___uint8_t__uint32_t((
           (regional__uint32_t__uint8_t_){
@@ -1524,7 +2576,7 @@ mt_flush_to_(
     }
     LowStar_Vector_vector_str___uint8_t_ flushed = frv;
     assign__LowStar_Vector_vector_str__uint8_t__uint32_t(hs, lv, flushed);
-    mt_flush_to_(hsz, lv + (uint32_t)1U, hs, pi / (uint32_t)2U, i / (uint32_t)2U);
+    mt_flush_to_(hsz, lv + (uint32_t)1U, hs, arena, pi / (uint32_t)2U, i / (uint32_t)2U);
     return;
   }
 }
@@ -1547,7 +2599,7 @@ void MerkleTree_Low_mt_flush_to(MerkleTree_Low_merkle_tree *mt, uint64_t idx)
   uint32_t hsz = mtv.hash_size;
   uint32_t idx1 = (uint32_t)(idx - offset);
   LowStar_Vector_vector_str__LowStar_Vector_vector_str___uint8_t_ hs = mtv.hs;
-  mt_flush_to_(hsz, (uint32_t)0U, hs, mtv.i, idx1);
+  mt_flush_to_(hsz, (uint32_t)0U, hs, mtv.arena, mtv.i, idx1);
   *mt
   =
     (
@@ -1560,7 +2612,8 @@ void MerkleTree_Low_mt_flush_to(MerkleTree_Low_merkle_tree *mt, uint64_t idx)
         .rhs_ok = mtv.rhs_ok,
         .rhs = mtv.rhs,
         .mroot = mtv.mroot,
-        .hash_fun = mtv.hash_fun
+        .hash_fun = mtv.hash_fun,
+        .arena = mtv.arena
       }
     );
 }
@@ -1625,6 +2678,7 @@ static void
 mt_retract_to_(
   uint32_t hsz,
   LowStar_Vector_vector_str__LowStar_Vector_vector_str___uint8_t_ hs,
+  MerkleTree_Low_hash_arena *arena,
   uint32_t lv,
   uint32_t i,
   uint32_t s,
@@ -1636,23 +2690,36 @@ mt_retract_to_(
     LowStar_Vector_vector_str___uint8_t_ hvec = index__LowStar_Vector_vector_str__uint8_t_(hs, lv);
     uint32_t old_len = j - MerkleTree_Low_offset_of(i);
     uint32_t new_len = s - MerkleTree_Low_offset_of(i);
-    LowStar_Vector_vector_str___uint8_t_
-    retracted =
-      shrink___uint8_t__uint32_t((
-          (regional__uint32_t__uint8_t_){
-            .state = hsz,
-            .dummy = NULL,
-            .r_alloc = hash_r_alloc,
-            .r_free = hash_r_free
-          }
-        ),
-        hvec,
-        new_len);
+    LowStar_Vector_vector_str___uint8_t_ retracted;
+    if (arena == NULL)
+    {
+      retracted =
+        shrink___uint8_t__uint32_t((
+            (regional__uint32_t__uint8_t_){
+              .state = hsz,
+              .dummy = NULL,
+              .r_alloc = hash_r_alloc,
+              .r_free = hash_r_free
+            }
+          ),
+          hvec,
+          new_len);
+    }
+    else if (new_len >= hvec.sz)
+    {
+      retracted = hvec;
+    }
+    else
+    {
+      hash_arena_drop_back(arena + lv, hvec.sz - new_len);
+      retracted = shrink___uint8_t_(hvec, new_len);
+    }
     assign__LowStar_Vector_vector_str__uint8_t__uint32_t(hs, lv, retracted);
     if (lv + (uint32_t)1U < hs.sz)
     {
       mt_retract_to_(hsz,
         hs,
+        arena,
         lv + (uint32_t)1U,
         i / (uint32_t)2U,
         s / (uint32_t)2U,
@@ -1680,7 +2747,7 @@ void MerkleTree_Low_mt_retract_to(MerkleTree_Low_merkle_tree *mt, uint64_t r)
   uint64_t offset = mtv.offset;
   uint32_t r1 = (uint32_t)(r - offset);
   LowStar_Vector_vector_str__LowStar_Vector_vector_str___uint8_t_ hs = mtv.hs;
-  mt_retract_to_(mtv.hash_size, hs, (uint32_t)0U, mtv.i, r1 + (uint32_t)1U, mtv.j);
+  mt_retract_to_(mtv.hash_size, hs, mtv.arena, (uint32_t)0U, mtv.i, r1 + (uint32_t)1U, mtv.j);
   *mt
   =
     (
@@ -1693,7 +2760,8 @@ void MerkleTree_Low_mt_retract_to(MerkleTree_Low_merkle_tree *mt, uint64_t r)
         .rhs_ok = false,
         .rhs = mtv.rhs,
         .mroot = mtv.mroot,
-        .hash_fun = mtv.hash_fun
+        .hash_fun = mtv.hash_fun,
+        .arena = mtv.arena
       }
     );
 }
@@ -1813,6 +2881,381 @@ MerkleTree_Low_mt_verify(
   return r;
 }
 
+/*
+  A node of index p exists at a level holding j hashes if it is one of them,
+  or if it is the root of the right-hand side (actd).
+*/
+static bool mt_multi_node_exists(uint32_t p, uint32_t j, bool actd)
+{
+  return p < j || (p == j && actd);
+}
+
+/*
+  Number of sibling hashes in the multiproof of the n indices ks (strictly
+  increasing) of a tree of j hashes. Overwrites ks.
+*/
+static uint32_t mt_multi_path_length(uint32_t *ks, uint32_t n, uint32_t j)
+{
+  uint32_t len = (uint32_t)0U;
+  uint32_t m = n;
+  bool actd = false;
+  while (!(j == (uint32_t)0U))
+  {
+    uint32_t r = (uint32_t)0U;
+    uint32_t w = (uint32_t)0U;
+    while (r < m)
+    {
+      uint32_t k = ks[r];
+      uint32_t s = k ^ (uint32_t)1U;
+      if (k % (uint32_t)2U == (uint32_t)0U && r + (uint32_t)1U < m && ks[r + (uint32_t)1U] == s)
+      {
+        r = r + (uint32_t)2U;
+      }
+      else
+      {
+        if (mt_multi_node_exists(s, j, actd))
+        {
+          len = len + (uint32_t)1U;
+        }
+        r = r + (uint32_t)1U;
+      }
+      ks[w] = k / (uint32_t)2U;
+      w = w + (uint32_t)1U;
+    }
+    m = w;
+    actd = actd || j % (uint32_t)2U == (uint32_t)1U;
+    j = j / (uint32_t)2U;
+  }
+  return len;
+}
+
+/*
+  Indices of a multiproof, relative to the tree offset, or NULL if they are
+  not strictly increasing or not within [lo, hi), or if allocation fails.
+*/
+static uint32_t
+*mt_multi_indices(uint64_t offset, const uint64_t *idx, uint32_t n, uint32_t lo, uint32_t hi)
+{
+  KRML_CHECK_SIZE(sizeof (uint32_t), n);
+  uint32_t *ks = KRML_HOST_MALLOC(sizeof (uint32_t) * n);
+  if (ks == NULL)
+  {
+    return NULL;
+  }
+  bool ok = true;
+  for (uint32_t t = (uint32_t)0U; t < n; t++)
+  {
+    ok =
+      ok
+      && idx[t] >= offset
+      && idx[t] - offset < (uint64_t)hi
+      && (uint32_t)(idx[t] - offset) >= lo
+      && (t == (uint32_t)0U || idx[t] > idx[t - (uint32_t)1U]);
+    if (ok)
+    {
+      ks[t] = (uint32_t)(idx[t] - offset);
+    }
+  }
+  if (!ok)
+  {
+    KRML_HOST_FREE(ks);
+    return NULL;
+  }
+  return ks;
+}
+
+bool
+MerkleTree_Low_mt_get_paths_pre(
+  const MerkleTree_Low_merkle_tree *mt,
+  const uint64_t *idx,
+  uint32_t n,
+  const MerkleTree_Low_path *p,
+  uint8_t *root
+)
+{
+  MerkleTree_Low_merkle_tree *mt1 = (MerkleTree_Low_merkle_tree *)mt;
+  MerkleTree_Low_path *p1 = (MerkleTree_Low_path *)p;
+  MerkleTree_Low_merkle_tree mtv = *mt1;
+  MerkleTree_Low_path uu____0 = *p1;
+  if (n == (uint32_t)0U || !(uu____0.hash_size == mtv.hash_size) || !(uu____0.hashes.sz == (uint32_t)0U))
+  {
+    return false;
+  }
+  uint32_t *ks = mt_multi_indices(mtv.offset, idx, n, mtv.i, mtv.j);
+  if (ks == NULL)
+  {
+    return false;
+  }
+  KRML_HOST_FREE(ks);
+  return true;
+}
+
+uint32_t
+MerkleTree_Low_mt_get_paths(
+  const MerkleTree_Low_merkle_tree *mt,
+  const uint64_t *idx,
+  uint32_t n,
+  MerkleTree_Low_path *p,
+  uint8_t *root
+)
+{
+  MerkleTree_Low_merkle_tree *ncmt = (MerkleTree_Low_merkle_tree *)mt;
+  MerkleTree_Low_merkle_tree mtv0 = *ncmt;
+  MerkleTree_Low_path pth = *p;
+  if (n == (uint32_t)0U || !(pth.hash_size == mtv0.hash_size))
+  {
+    return (uint32_t)0U;
+  }
+  uint32_t *ks = mt_multi_indices(mtv0.offset, idx, n, mtv0.i, mtv0.j);
+  if (ks == NULL)
+  {
+    return (uint32_t)0U;
+  }
+  MerkleTree_Low_mt_get_root(mt, root);
+  MerkleTree_Low_merkle_tree mtv = *ncmt;
+  uint32_t hsz1 = mtv.hash_size;
+  uint32_t i = mtv.i;
+  uint32_t j = mtv.j;
+  LowStar_Vector_vector_str__LowStar_Vector_vector_str___uint8_t_ hs = mtv.hs;
+  LowStar_Vector_vector_str___uint8_t_ rhs = mtv.rhs;
+  LowStar_Vector_vector_str___uint8_t_ pv = pth.hashes;
+  uint32_t ofs0 = MerkleTree_Low_offset_of(i);
+  for (uint32_t t = (uint32_t)0U; t < n; t++)
+  {
+    pv = insert___uint8_t_(pv, index___uint8_t_(hs.vs[0U], ks[t] - ofs0));
+  }
+  uint32_t m = n;
+  uint32_t lv = (uint32_t)0U;
+  bool actd = false;
+  while (!(j == (uint32_t)0U))
+  {
+    uint32_t ofs = MerkleTree_Low_offset_of(i);
+    uint32_t r = (uint32_t)0U;
+    uint32_t w = (uint32_t)0U;
+    while (r < m)
+    {
+      uint32_t k = ks[r];
+      uint32_t s = k ^ (uint32_t)1U;
+      if (k % (uint32_t)2U == (uint32_t)0U && r + (uint32_t)1U < m && ks[r + (uint32_t)1U] == s)
+      {
+        r = r + (uint32_t)2U;
+      }
+      else
+      {
+        if (s < j)
+        {
+          pv = insert___uint8_t_(pv, index___uint8_t_(hs.vs[lv], s - ofs));
+        }
+        else if (s == j && actd)
+        {
+          pv = insert___uint8_t_(pv, index___uint8_t_(rhs, lv));
+        }
+        r = r + (uint32_t)1U;
+      }
+      ks[w] = k / (uint32_t)2U;
+      w = w + (uint32_t)1U;
+    }
+    m = w;
+    actd = actd || j % (uint32_t)2U == (uint32_t)1U;
+    i = i / (uint32_t)2U;
+    j = j / (uint32_t)2U;
+    lv = lv + (uint32_t)1U;
+  }
+  KRML_HOST_FREE(ks);
+  *p = ((MerkleTree_Low_path){ .hash_size = hsz1, .hashes = pv });
+  return mtv.j;
+}
+
+bool
+MerkleTree_Low_mt_verify_multi_pre(
+  const MerkleTree_Low_merkle_tree *mt,
+  const uint64_t *k,
+  uint32_t n,
+  uint64_t j,
+  const MerkleTree_Low_path *p,
+  uint8_t *rt
+)
+{
+  MerkleTree_Low_merkle_tree *mt1 = (MerkleTree_Low_merkle_tree *)mt;
+  MerkleTree_Low_path *p1 = (MerkleTree_Low_path *)p;
+  MerkleTree_Low_merkle_tree mtv = *mt1;
+  MerkleTree_Low_path uu____0 = *p1;
+  if
+  (
+    n
+    == (uint32_t)0U
+    || j < mtv.offset
+    || j - mtv.offset > MerkleTree_Low_offset_range_limit
+    || !(mtv.hash_size == uu____0.hash_size)
+  )
+  {
+    return false;
+  }
+  uint32_t j1 = (uint32_t)(j - mtv.offset);
+  uint32_t *ks = mt_multi_indices(mtv.offset, k, n, (uint32_t)0U, j1);
+  if (ks == NULL)
+  {
+    return false;
+  }
+  uint32_t len = mt_multi_path_length(ks, n, j1);
+  KRML_HOST_FREE(ks);
+  return (uint64_t)uu____0.hashes.sz == (uint64_t)n + (uint64_t)len;
+}
+
+static void
+mt_multi_hash(
+  bool sha256,
+  void (*hash_fun)(uint8_t *x0, uint8_t *x1, uint8_t *x2),
+  uint32_t cnt,
+  uint8_t **src1,
+  uint8_t **src2,
+  uint8_t **dst
+)
+{
+  if (sha256)
+  {
+    EverCrypt_Hash_compress_256_mb(cnt, src1, src2, dst);
+    return;
+  }
+  for (uint32_t t = (uint32_t)0U; t < cnt; t++)
+  {
+    hash_fun(src1[t], src2[t], dst[t]);
+  }
+}
+
+bool
+MerkleTree_Low_mt_verify_multi(
+  const MerkleTree_Low_merkle_tree *mt,
+  const uint64_t *k,
+  uint32_t n,
+  uint64_t j,
+  const MerkleTree_Low_path *p,
+  uint8_t *rt
+)
+{
+  MerkleTree_Low_merkle_tree *ncmt = (MerkleTree_Low_merkle_tree *)mt;
+  MerkleTree_Low_path *ncp = (MerkleTree_Low_path *)p;
+  MerkleTree_Low_merkle_tree mtv = *ncmt;
+  uint32_t hash_size = mtv.hash_size;
+  MerkleTree_Low_path pth = *ncp;
+  if
+  (
+    n
+    == (uint32_t)0U
+    || pth.hashes.sz < n
+    || j < mtv.offset
+    || j - mtv.offset > MerkleTree_Low_offset_range_limit
+    || !(hash_size == pth.hash_size)
+    || n > (uint32_t)0xffffffffU / hash_size
+  )
+  {
+    return false;
+  }
+  uint32_t j1 = (uint32_t)(j - mtv.offset);
+  uint32_t *ks = mt_multi_indices(mtv.offset, k, n, (uint32_t)0U, j1);
+  if (ks == NULL)
+  {
+    return false;
+  }
+  bool sha256 = mtv.hash_fun == mt_sha256_compress && hash_size == (uint32_t)32U;
+  KRML_CHECK_SIZE(sizeof (uint8_t), n * hash_size);
+  uint8_t *cur = KRML_HOST_CALLOC(n * hash_size, sizeof (uint8_t));
+  KRML_CHECK_SIZE(sizeof (uint8_t), n * hash_size);
+  uint8_t *nxt = KRML_HOST_CALLOC(n * hash_size, sizeof (uint8_t));
+  if (cur == NULL || nxt == NULL)
+  {
+    KRML_HOST_FREE(ks);
+    KRML_HOST_FREE(cur);
+    KRML_HOST_FREE(nxt);
+    return false;
+  }
+  for (uint32_t t = (uint32_t)0U; t < n; t++)
+  {
+    hash_copy(hash_size, index___uint8_t_(pth.hashes, t), cur + t * hash_size);
+  }
+  uint8_t *src1[64U];
+  uint8_t *src2[64U];
+  uint8_t *dst[64U];
+  uint32_t ppos = n;
+  uint32_t m = n;
+  bool actd = false;
+  bool ok = true;
+  while (ok && !(j1 == (uint32_t)0U))
+  {
+    uint32_t r = (uint32_t)0U;
+    uint32_t w = (uint32_t)0U;
+    uint32_t cnt = (uint32_t)0U;
+    while (ok && r < m)
+    {
+      uint32_t k1 = ks[r];
+      uint32_t s = k1 ^ (uint32_t)1U;
+      uint8_t *acc = cur + r * hash_size;
+      uint8_t *out = nxt + w * hash_size;
+      if (k1 % (uint32_t)2U == (uint32_t)0U && r + (uint32_t)1U < m && ks[r + (uint32_t)1U] == s)
+      {
+        src1[cnt] = acc;
+        src2[cnt] = acc + hash_size;
+        dst[cnt] = out;
+        cnt = cnt + (uint32_t)1U;
+        r = r + (uint32_t)2U;
+      }
+      else if (!mt_multi_node_exists(s, j1, actd))
+      {
+        hash_copy(hash_size, acc, out);
+        r = r + (uint32_t)1U;
+      }
+      else if (ppos >= pth.hashes.sz)
+      {
+        ok = false;
+      }
+      else
+      {
+        uint8_t *phash = index___uint8_t_(pth.hashes, ppos);
+        if (k1 % (uint32_t)2U == (uint32_t)0U)
+        {
+          src1[cnt] = acc;
+          src2[cnt] = phash;
+        }
+        else
+        {
+          src1[cnt] = phash;
+          src2[cnt] = acc;
+        }
+        dst[cnt] = out;
+        cnt = cnt + (uint32_t)1U;
+        ppos = ppos + (uint32_t)1U;
+        r = r + (uint32_t)1U;
+      }
+      ks[w] = k1 / (uint32_t)2U;
+      w = w + (uint32_t)1U;
+      if (cnt == (uint32_t)64U)
+      {
+        mt_multi_hash(sha256, mtv.hash_fun, cnt, src1, src2, dst);
+        cnt = (uint32_t)0U;
+      }
+    }
+    mt_multi_hash(sha256, mtv.hash_fun, cnt, src1, src2, dst);
+    uint8_t *tmp = cur;
+    cur = nxt;
+    nxt = tmp;
+    m = w;
+    actd = actd || j1 % (uint32_t)2U == (uint32_t)1U;
+    j1 = j1 / (uint32_t)2U;
+  }
+  uint8_t res = (uint8_t)255U;
+  for (uint32_t i = (uint32_t)0U; i < hash_size; i++)
+  {
+    uint8_t uu____0 = FStar_UInt8_eq_mask(cur[i], rt[i]);
+    res = uu____0 & res;
+  }
+  uint8_t z = res;
+  bool r = ok && ppos == pth.hashes.sz && z == (uint8_t)255U;
+  KRML_HOST_FREE(ks);
+  KRML_HOST_FREE(cur);
+  KRML_HOST_FREE(nxt);
+  return r;
+}
+
 typedef struct __bool_uint32_t_s
 {
   bool fst;
@@ -2608,7 +4051,8 @@ MerkleTree_Low_merkle_tree
         .rhs_ok = rhs_ok,
         .rhs = rhs,
         .mroot = mroot,
-        .hash_fun = hash_fun
+        .hash_fun = hash_fun,
+        .arena = NULL
       }
     );
   return buf;
@@ -76,6 +76,19 @@ typedef struct LowStar_Vector_vector_str__LowStar_Vector_vector_str___uint8_t__s
 }
 LowStar_Vector_vector_str__LowStar_Vector_vector_str___uint8_t_;
 
+/*
+  Storage for the hashes of one tree level, either in memory or in a mapped
+  file. The layout is private to MerkleTree.c.
+*/
+typedef struct MerkleTree_Low_hash_arena_s MerkleTree_Low_hash_arena;
+
+/*
+  arena comes last, after hash_fun: it is NULL for trees stored in vectors and
+  otherwise points to one opaque MerkleTree_Low_hash_arena per level. Adding it
+  grew sizeof (MerkleTree_Low_merkle_tree) by one pointer, an ABI change for
+  code that allocates or embeds the struct itself; code that only goes through
+  mt_p, with trees from the mt_create functions, is unaffected.
+*/
 typedef struct MerkleTree_Low_merkle_tree_s
 {
   uint32_t hash_size;
@@ -87,6 +100,7 @@ typedef struct MerkleTree_Low_merkle_tree_s
   LowStar_Vector_vector_str___uint8_t_ rhs;
   uint8_t *mroot;
   void (*hash_fun)(uint8_t *x0, uint8_t *x1, uint8_t *x2);
+  MerkleTree_Low_hash_arena *arena;
 }
 MerkleTree_Low_merkle_tree;
 
@@ -163,6 +177,71 @@ MerkleTree_Low_merkle_tree
   void (*hash_fun)(uint8_t *x0, uint8_t *x1, uint8_t *x2)
 );
 
+/*
+  Construction with custom hash functions and arena storage
+
+  @param[in]  hash_size Hash size (in bytes)
+  @param[in]  i         The initial hash
+
+  return The new Merkle tree
+
+  Note: the hashes of each level are stored contiguously in chunks of about
+  4KB instead of being allocated one by one. Paths returned by mt_get_path
+  point into these chunks and remain valid until the hashes they point to are
+  flushed or retracted, as with trees built by mt_create_custom.
+*/
+MerkleTree_Low_merkle_tree
+*mt_create_custom_arena(
+  uint32_t hash_size,
+  uint8_t *i,
+  void (*hash_fun)(uint8_t *x0, uint8_t *x1, uint8_t *x2)
+);
+
+/*
+  Construction with custom hash functions and memory-mapped file storage
+
+  @param[in]  dir       Directory holding the level files, created if missing
+  @param[in]  hash_size Hash size (in bytes)
+  @param[in]  i         The initial hash
+
+  return The new Merkle tree, or NULL if the files cannot be created (in
+  particular if dir already holds a tree)
+
+  Note: each level lives in its own append-only file under dir, mapped in
+  memory. The tree state is written to disk by mt_sync and mt_free, and the
+  tree can be reopened with mt_open_custom_mmap. Hashes dropped by
+  mt_flush_to are released from the files at the next mt_sync or mt_free.
+  The first insertion after mt_retract_to syncs the retracted tree, so that
+  it does not overwrite hashes of the tree last written to disk.
+  Only available on POSIX systems with 64-bit pointers.
+*/
+MerkleTree_Low_merkle_tree
+*mt_create_custom_mmap(
+  const char *dir,
+  uint32_t hash_size,
+  uint8_t *i,
+  void (*hash_fun)(uint8_t *x0, uint8_t *x1, uint8_t *x2)
+);
+
+/*
+  Reopen a tree written by mt_create_custom_mmap
+
+  @param[in]  dir       Directory holding the level files
+  @param[in]  hash_size Hash size (in bytes), as given at creation
+
+  return The Merkle tree as of its last mt_sync or mt_free, or NULL if dir does
+  not hold a tree with this hash size
+
+  Note: the hashes are not read or copied; the tree only indexes the mapped
+  files.
+*/
+MerkleTree_Low_merkle_tree
+*mt_open_custom_mmap(
+  const char *dir,
+  uint32_t hash_size,
+  void (*hash_fun)(uint8_t *x0, uint8_t *x1, uint8_t *x2)
+);
+
 /*
   Destruction
 
@@ -170,21 +249,60 @@ MerkleTree_Low_merkle_tree
 */
 void mt_free(MerkleTree_Low_merkle_tree *mt);
 
+/*
+  Write a memory-mapped tree to disk
+
+  @param[in]  mt  The Merkle tree
+
+  return true if the hashes and then the tree state reached the disk
+
+  Note: the hashes are synced before the tree state, so a crash leaves the
+  files describing the tree as of the previous mt_sync. Does nothing for trees
+  that are not memory-mapped.
+*/
+bool mt_sync(MerkleTree_Low_merkle_tree *mt);
+
 /*
   Insertion
 
   @param[in]  mt  The Merkle tree
   @param[in]  v   The tree does not take ownership of the hash, it makes a copy of its content.
 
+ return false, leaving the tree unchanged, if the files of a memory-mapped tree
+ cannot grow to hold the new hashes; true otherwise.
+
  Note: The content of the hash will be overwritten with an arbitrary value.
 */
-void mt_insert(MerkleTree_Low_merkle_tree *mt, uint8_t *v);
+bool mt_insert(MerkleTree_Low_merkle_tree *mt, uint8_t *v);
 
 /*
   Precondition predicate for mt_insert
 */
 bool mt_insert_pre(const MerkleTree_Low_merkle_tree *mt, uint8_t *v);
 
+/*
+  Batch insertion
+
+  @param[in]  mt      The Merkle tree
+  @param[in]  leaves  n hashes stored back to back (n * hash_size bytes). The tree
+                      does not take ownership of them, it makes copies.
+  @param[in]  n       The number of hashes to insert
+
+  The resulting tree is the same as after n calls to mt_insert, but the new nodes
+  of each level are computed together, level by level. With the default
+  mt_sha256_compress hash function, they are compressed several at a time over
+  vector lanes when SHA-NI is not available.
+
+  return false, leaving the tree unchanged, if the files of a memory-mapped tree
+  cannot grow to hold the new hashes; true otherwise.
+*/
+bool mt_insert_batch(MerkleTree_Low_merkle_tree *mt, uint8_t *leaves, uint32_t n);
+
+/*
+  Precondition predicate for mt_insert_batch
+*/
+bool mt_insert_batch_pre(const MerkleTree_Low_merkle_tree *mt, uint8_t *leaves, uint32_t n);
+
 /*
   Getting the Merkle root
 
@@ -233,6 +351,51 @@ mt_get_path_pre(
   uint8_t *root
 );
 
+/*
+  Getting a Merkle multiproof
+
+  @param[in]  mt   The Merkle tree
+  @param[in]  idx  The indices of the target hashes, in increasing order
+  @param[in]  n    The number of target hashes
+  @param[out] path A resulting multiproof that contains the leaf hashes.
+  @param[out] root The Merkle root
+
+  return The number of elements in the tree, or 0, leaving path and root
+  unchanged, if n is 0 or idx is not valid as checked by mt_get_paths_pre
+
+  Notes:
+  - The resulting path starts with the n leaf hashes, followed by the
+    sibling hashes needed to recompute the root, level by level from left to
+    right. A sibling that is itself on the way to the root from another target
+    is not included, so the multiproof is never longer than the n paths given
+    by mt_get_path, and is much shorter for neighbouring indices.
+  - For n = 1 the result is the path given by mt_get_path.
+  - The resulting path contains pointers to hashes in the tree, not copies of
+    the hash values.
+  - idx must be within the currently held indices in the tree (past the
+    last flush index).
+*/
+uint32_t
+mt_get_paths(
+  const MerkleTree_Low_merkle_tree *mt,
+  const uint64_t *idx,
+  uint32_t n,
+  MerkleTree_Low_path *path1,
+  uint8_t *root
+);
+
+/*
+  Precondition predicate for mt_get_paths
+*/
+bool
+mt_get_paths_pre(
+  const MerkleTree_Low_merkle_tree *mt,
+  const uint64_t *idx,
+  uint32_t n,
+  const MerkleTree_Low_path *path1,
+  uint8_t *root
+);
+
 /*
   Flush the Merkle tree
 
@@ -307,6 +470,45 @@ mt_verify_pre(
   uint8_t *root
 );
 
+/*
+  Client-side verification of a multiproof
+
+  @param[in]  mt   The Merkle tree
+  @param[in]  tgt  The indices of the target hashes, in increasing order
+  @param[in]  n    The number of target hashes
+  @param[in]  max  The maximum index + 1 of the tree when the multiproof was generated
+  @param[in]  path The multiproof to verify, as given by mt_get_paths
+  @param[in]  root
+
+  return true if the verification succeeded, false otherwise, including when
+  n is 0 or tgt is not valid as checked by mt_verify_multi_pre
+
+  Note: each ancestor shared by several targets is computed once. max - tgt[0]
+  must be less than 2^32.
+*/
+bool
+mt_verify_multi(
+  const MerkleTree_Low_merkle_tree *mt,
+  const uint64_t *tgt,
+  uint32_t n,
+  uint64_t max,
+  const MerkleTree_Low_path *path1,
+  uint8_t *root
+);
+
+/*
+  Precondition predicate for mt_verify_multi
+*/
+bool
+mt_verify_multi_pre(
+  const MerkleTree_Low_merkle_tree *mt,
+  const uint64_t *tgt,
+  uint32_t n,
+  uint64_t max,
+  const MerkleTree_Low_path *path1,
+  uint8_t *root
+);
+
 /*
   Serialization size
 
@@ -375,7 +577,8 @@ MerkleTree_Low_path *mt_deserialize_path(const uint8_t *buf, uint64_t len);
 typedef MerkleTree_Low_merkle_tree *mt_p0;
 
 /*
-  Default hash function
+  Default hash function: one SHA2-256 compression of src1 || src2 from the
+  SHA2-256 initial hash value, without padding
 */
 void mt_sha256_compress(uint8_t *src1, uint8_t *src2, uint8_t *dst);
 
@@ -386,6 +589,28 @@ void mt_sha256_compress(uint8_t *src1, uint8_t *src2, uint8_t *dst);
 */
 MerkleTree_Low_merkle_tree *mt_create(uint8_t *init);
 
+/*
+  Construction wired to sha256 from EverCrypt, with arena storage
+
+  @param[in]  init   The initial hash
+*/
+MerkleTree_Low_merkle_tree *mt_create_arena(uint8_t *init);
+
+/*
+  Construction wired to sha256 from EverCrypt, with memory-mapped file storage
+
+  @param[in]  dir    Directory holding the level files, created if missing
+  @param[in]  init   The initial hash
+*/
+MerkleTree_Low_merkle_tree *mt_create_mmap(const char *dir, uint8_t *init);
+
+/*
+  Reopen a tree written by mt_create_mmap
+
+  @param[in]  dir    Directory holding the level files
+*/
+MerkleTree_Low_merkle_tree *mt_open_mmap(const char *dir);
+
 typedef uint32_t MerkleTree_Low_index_t;
 
 extern uint32_t MerkleTree_Low_uint32_32_max;
@@ -448,7 +673,16 @@ void MerkleTree_Low_mt_free(MerkleTree_Low_merkle_tree *mt);
 
 bool MerkleTree_Low_mt_insert_pre(const MerkleTree_Low_merkle_tree *mt, uint8_t *v);
 
-void MerkleTree_Low_mt_insert(MerkleTree_Low_merkle_tree *mt, uint8_t *v);
+bool MerkleTree_Low_mt_insert(MerkleTree_Low_merkle_tree *mt, uint8_t *v);
+
+bool
+MerkleTree_Low_mt_insert_batch_pre(
+  const MerkleTree_Low_merkle_tree *mt,
+  uint8_t *leaves,
+  uint32_t n
+);
+
+bool MerkleTree_Low_mt_insert_batch(MerkleTree_Low_merkle_tree *mt, uint8_t *leaves, uint32_t n);
 
 MerkleTree_Low_merkle_tree
 *MerkleTree_Low_mt_create_custom(
@@ -457,6 +691,30 @@ MerkleTree_Low_merkle_tree
   void (*hash_fun)(uint8_t *x0, uint8_t *x1, uint8_t *x2)
 );
 
+MerkleTree_Low_merkle_tree
+*MerkleTree_Low_mt_create_custom_arena(
+  uint32_t hsz,
+  uint8_t *init,
+  void (*hash_fun)(uint8_t *x0, uint8_t *x1, uint8_t *x2)
+);
+
+MerkleTree_Low_merkle_tree
+*MerkleTree_Low_mt_create_custom_mmap(
+  const char *dir,
+  uint32_t hsz,
+  uint8_t *init,
+  void (*hash_fun)(uint8_t *x0, uint8_t *x1, uint8_t *x2)
+);
+
+MerkleTree_Low_merkle_tree
+*MerkleTree_Low_mt_open_custom_mmap(
+  const char *dir,
+  uint32_t hsz,
+  void (*hash_fun)(uint8_t *x0, uint8_t *x1, uint8_t *x2)
+);
+
+bool MerkleTree_Low_mt_sync(MerkleTree_Low_merkle_tree *mt);
+
 bool MerkleTree_Low_uu___is_Path(MerkleTree_Low_path projectee);
 
 uint32_t MerkleTree_Low___proj__Path__item__hash_size(MerkleTree_Low_path projectee);
@@ -532,6 +790,44 @@ MerkleTree_Low_mt_verify(
   uint8_t *rt
 );
 
+bool
+MerkleTree_Low_mt_get_paths_pre(
+  const MerkleTree_Low_merkle_tree *mt,
+  const uint64_t *idx,
+  uint32_t n,
+  const MerkleTree_Low_path *p,
+  uint8_t *root
+);
+
+uint32_t
+MerkleTree_Low_mt_get_paths(
+  const MerkleTree_Low_merkle_tree *mt,
+  const uint64_t *idx,
+  uint32_t n,
+  MerkleTree_Low_path *p,
+  uint8_t *root
+);
+
+bool
+MerkleTree_Low_mt_verify_multi_pre(
+  const MerkleTree_Low_merkle_tree *mt,
+  const uint64_t *k,
+  uint32_t n,
+  uint64_t j,
+  const MerkleTree_Low_path *p,
+  uint8_t *rt
+);
+
+bool
+MerkleTree_Low_mt_verify_multi(
+  const MerkleTree_Low_merkle_tree *mt,
+  const uint64_t *k,
+  uint32_t n,
+  uint64_t j,
+  const MerkleTree_Low_path *p,
+  uint8_t *rt
+);
+
 typedef uint8_t MerkleTree_Low_Serialization_uint8_t;
 
 typedef uint16_t MerkleTree_Low_Serialization_uint16_t;
@@ -0,0 +1,76 @@
+#ifdef __GNUC__
+#if defined(__x86_64__) || defined(_M_X64)
+#pragma once
+#include <inttypes.h>
+
+// Computes res[0..len) += a[0..len) * b and returns the carry limb.
+// Uses two independent carry chains: adcx propagates the high half of the
+// previous product (CF) while adox accumulates the limbs of res (OF).
+// Requires BMI2 and ADX.
+static inline uint64_t bn_mul1_add_adx (uint64_t *res, uint64_t *a, uint64_t b, uint64_t len)
+{
+  uint64_t carry_r;
+  uint64_t rem = len & (uint64_t)3U;
+  uint64_t blocks = len >> 2;
+
+  asm volatile(
+    // Clear CF, OF and the running high half
+    "  xor %%eax, %%eax;"
+
+    // Leading limbs, one at a time
+    "  mov %4, %%rcx;"
+    "  jrcxz 2f;"
+    "1:"
+    "  mulxq 0(%1), %%r8, %%r9;"
+    "  adcxq %%rax, %%r8;"
+    "  adoxq 0(%0), %%r8;"
+    "  movq %%r8, 0(%0);"
+    "  movq %%r9, %%rax;"
+    "  leaq 8(%1), %1;"
+    "  leaq 8(%0), %0;"
+    "  leaq -1(%%rcx), %%rcx;"
+    "  jrcxz 2f;"
+    "  jmp 1b;"
+
+    // Four limbs per iteration
+    "2:"
+    "  mov %5, %%rcx;"
+    "  jrcxz 4f;"
+    "3:"
+    "  mulxq 0(%1), %%r8, %%r9;"
+    "  adcxq %%rax, %%r8;"
+    "  adoxq 0(%0), %%r8;"
+    "  movq %%r8, 0(%0);"
+    "  mulxq 8(%1), %%r8, %%rax;"
+    "  adcxq %%r9, %%r8;"
+    "  adoxq 8(%0), %%r8;"
+    "  movq %%r8, 8(%0);"
+    "  mulxq 16(%1), %%r8, %%r9;"
+    "  adcxq %%rax, %%r8;"
+    "  adoxq 16(%0), %%r8;"
+    "  movq %%r8, 16(%0);"
+    "  mulxq 24(%1), %%r8, %%rax;"
+    "  adcxq %%r9, %%r8;"
+    "  adoxq 24(%0), %%r8;"
+    "  movq %%r8, 24(%0);"
+    "  leaq 32(%1), %1;"
+    "  leaq 32(%0), %0;"
+    "  leaq -1(%%rcx), %%rcx;"
+    "  jrcxz 4f;"
+    "  jmp 3b;"
+
+    // Fold both carry bits into the last high half
+    "4:"
+    "  movq $0, %%r8;"
+    "  adcxq %%r8, %%rax;"
+    "  adoxq %%r8, %%rax;"
+  : "+&r" (res), "+&r" (a), "=&a" (carry_r)
+  : "d" (b), "r" (rem), "r" (blocks)
+  : "%rcx", "%r8", "%r9", "memory", "cc"
+  );
+
+  return carry_r;
+}
+
+#endif /* defined(__x86_64__) || defined(_M_X64) */
+#endif /* __GNUC__ */
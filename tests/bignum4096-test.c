@@ -5,6 +5,9 @@
 #include <stdbool.h>
 
 #include "Hacl_Bignum4096.h"
+#include "Hacl_Bignum256.h"
+#include "Hacl_Bignum64.h"
+#include "EverCrypt_AutoConfig2.h"
 
 #include "test_helpers.h"
 #include "bignum4096_vectors.h"
@@ -112,8 +115,7 @@ bool print_test(
 }
 
 
-int main() {
-
+bool run_vectors() {
   bool ok = true;
   for (int i = 0; i < sizeof(vectors_be)/sizeof(bignum4096_bytes_be_test_vector); ++i) {
     ok &= print_test_bytes_be_precomp(vectors_be[i].nBytes, vectors_be[i].aBytes, vectors_be[i].bBits, vectors_be[i].bBytes, vectors_be[i].resBytes);
@@ -126,6 +128,210 @@ int main() {
   for (int i = 0; i < sizeof(vectors)/sizeof(bignum4096_test_vector); ++i) {
     ok &= print_test(vectors[i].n, vectors[i].a, vectors[i].bBits, vectors[i].b, vectors[i].res);
   }
+  return ok;
+}
+
+#define RAND_TESTS 8
+#define GEN_LEN 33
+
+uint64_t rn[RAND_TESTS][64], ra[RAND_TESTS][64], rb[RAND_TESTS][64];
+uint64_t res4096[RAND_TESTS][64], res256[RAND_TESTS][4], res_gen[RAND_TESTS][GEN_LEN];
+
+uint64_t rand64(uint64_t *x) {
+  *x ^= *x << 13;
+  *x ^= *x >> 7;
+  *x ^= *x << 17;
+  return *x;
+}
+
+// Random modular exponentiations with Bignum4096, Bignum256 and the generic
+// Bignum64 (with a length that is not a multiple of 4); `store` records the
+// results, otherwise they are compared against the recorded ones
+bool random_mod_exp(bool store) {
+  bool ok = true;
+  uint64_t r[64];
+  for (int i = 0; i < RAND_TESTS; i++) {
+    Hacl_Bignum4096_mod_exp_consttime(rn[i], ra[i], 4096, rb[i], r);
+    if (store) memcpy(res4096[i], r, sizeof res4096[i]);
+    else ok &= memcmp(res4096[i], r, sizeof res4096[i]) == 0;
+    Hacl_Bignum4096_mod_exp_vartime(rn[i], ra[i], 4096, rb[i], r);
+    ok &= memcmp(res4096[i], r, sizeof res4096[i]) == 0;
+
+    Hacl_Bignum256_mod_exp_consttime(rn[i], ra[i], 256, rb[i], r);
+    if (store) memcpy(res256[i], r, sizeof res256[i]);
+    else ok &= memcmp(res256[i], r, sizeof res256[i]) == 0;
+
+    uint64_t n[GEN_LEN], a[GEN_LEN];
+    memcpy(n, rn[i], sizeof n);
+    memcpy(a, ra[i], sizeof a);
+    n[GEN_LEN - 1] |= (uint64_t)1U << 63;
+    a[GEN_LEN - 1] >>= 1;
+    Hacl_Bignum64_mod_exp_consttime(GEN_LEN, n, a, 64 * GEN_LEN, rb[i], r);
+    if (store) memcpy(res_gen[i], r, sizeof res_gen[i]);
+    else ok &= memcmp(res_gen[i], r, sizeof res_gen[i]) == 0;
+    Hacl_Bignum64_mod_exp_vartime(GEN_LEN, n, a, 64 * GEN_LEN, rb[i], r);
+    ok &= memcmp(res_gen[i], r, sizeof res_gen[i]) == 0;
+  }
+  return ok;
+}
+
+// The sliding-window vartime exponentiation picks its window from bBits:
+// compare it with the constant-time one across all window widths
+bool vartime_exp_widths() {
+  uint32_t widths[12] = { 1, 2, 17, 23, 24, 79, 80, 239, 240, 671, 672, 2049 };
+  bool ok = true;
+  for (int i = 0; i < RAND_TESTS; i++) {
+    for (int w = 0; w < 12; w++) {
+      uint32_t bBits = widths[w];
+      uint64_t b[64] = { 0 };
+      memcpy(b, rb[i], sizeof b);
+      for (uint32_t j = bBits; j < 64 * 64; j++) b[j / 64] &= ~((uint64_t)1U << j % 64);
+      uint64_t r0[64], r1[64], r2[GEN_LEN], r3[GEN_LEN];
+      Hacl_Bignum4096_mod_exp_consttime(rn[i], ra[i], bBits, b, r0);
+      Hacl_Bignum4096_mod_exp_vartime(rn[i], ra[i], bBits, b, r1);
+      ok &= memcmp(r0, r1, sizeof r0) == 0;
+
+      uint64_t n[GEN_LEN], a[GEN_LEN];
+      memcpy(n, rn[i], sizeof n);
+      memcpy(a, ra[i], sizeof a);
+      n[GEN_LEN - 1] |= (uint64_t)1U << 63;
+      a[GEN_LEN - 1] >>= 1;
+      Hacl_Bignum64_mod_exp_consttime(GEN_LEN, n, a, bBits, b, r2);
+      Hacl_Bignum64_mod_exp_vartime(GEN_LEN, n, a, bBits, b, r3);
+      ok &= memcmp(r2, r3, sizeof r2) == 0;
+    }
+  }
+  printf("\n mod_exp_vartime across window widths: %s\n", ok ? "Success!" : "**FAILED**");
+  return ok;
+}
+
+// The squaring kernels fold the doubled cross products and the squares in a
+// single pass: check them against the general multiplication, including
+// all-ones operands where every doubling carries
+bool sqr_vs_mul() {
+  bool ok = true;
+  for (int i = 0; i <= RAND_TESTS; i++) {
+    uint64_t a[64], r0[128], r1[128];
+    if (i < RAND_TESTS) memcpy(a, ra[i], sizeof a);
+    else memset(a, 0xff, sizeof a);
+    Hacl_Bignum4096_mul(a, a, r0);
+    Hacl_Bignum4096_sqr(a, r1);
+    ok &= memcmp(r0, r1, sizeof r0) == 0;
+    Hacl_Bignum256_mul(a, a, r0);
+    Hacl_Bignum256_sqr(a, r1);
+    ok &= memcmp(r0, r1, 8 * sizeof (uint64_t)) == 0;
+  }
+  printf("\n sqr vs mul: %s\n", ok ? "Success!" : "**FAILED**");
+  return ok;
+}
+
+// Any window width must give the same result as the default one
+bool consttime_exp_windows() {
+  bool ok = true;
+  for (int i = 0; i < RAND_TESTS; i++) {
+    uint64_t n[GEN_LEN], a[GEN_LEN], r2[GEN_LEN], r0[GEN_LEN], r1[GEN_LEN];
+    memcpy(n, rn[i], sizeof n);
+    memcpy(a, ra[i], sizeof a);
+    n[GEN_LEN - 1] |= (uint64_t)1U << 63;
+    a[GEN_LEN - 1] >>= 1;
+    Hacl_Bignum_Montgomery_bn_precomp_r2_mod_n_u64(GEN_LEN, 64 * GEN_LEN - 1, n, r2);
+    uint64_t mu = Hacl_Bignum_ModInvLimb_mod_inv_uint64(n[0]);
+    uint32_t bBits = 64 * GEN_LEN - 7 * i;
+    Hacl_Bignum_Exponentiation_bn_mod_exp_consttime_precomp_u64(GEN_LEN, n, mu, r2, a, bBits, rb[i], r0);
+    for (uint32_t l = 1; l <= 8; l++) {
+      Hacl_Bignum_Exponentiation_bn_mod_exp_consttime_precomp_fw_u64(GEN_LEN, l, n, mu, r2, a, bBits, rb[i], r1);
+      ok &= memcmp(r0, r1, sizeof r0) == 0;
+    }
+  }
+  printf("\n mod_exp_consttime across window widths: %s\n", ok ? "Success!" : "**FAILED**");
+  return ok;
+}
+
+// Cost of each window width for full-size exponents, next to the default
+// picked by Hacl_Bignum_Exponentiation_bn_get_window_consttime
+void bench_consttime_windows() {
+  uint32_t lens[4] = { 16, 32, 48, 64 };
+  for (int k = 0; k < 4; k++) {
+    uint32_t len = lens[k];
+    uint64_t n[64], a[64], r2[64], r[64];
+    memcpy(n, rn[0], sizeof n);
+    memcpy(a, ra[0], sizeof a);
+    n[len - 1] |= (uint64_t)1U << 63;
+    a[len - 1] >>= 1;
+    Hacl_Bignum_Montgomery_bn_precomp_r2_mod_n_u64(len, 64 * len - 1, n, r2);
+    uint64_t mu = Hacl_Bignum_ModInvLimb_mod_inv_uint64(n[0]);
+    uint32_t bBits = 64 * len;
+    printf("mod_exp_consttime %u bits (default l = %u):", bBits,
+           Hacl_Bignum_Exponentiation_bn_get_window_consttime(len, bBits));
+    for (uint32_t l = 3; l <= 7; l++) {
+      uint64_t best = ~(uint64_t)0U;
+      for (int j = 0; j < 5; j++) {
+        cycles c0 = cpucycles_begin();
+        Hacl_Bignum_Exponentiation_bn_mod_exp_consttime_precomp_fw_u64(len, l, n, mu, r2, a, bBits, rb[0], r);
+        cycles c1 = cpucycles_end();
+        if ((uint64_t)(c1 - c0) < best) best = (uint64_t)(c1 - c0);
+      }
+      printf(" l=%u %" PRIu64, l, best);
+    }
+    printf(" cycles\n");
+  }
+}
+
+int main() {
+  bool ok = true;
+
+  uint64_t x = 0x0123456789abcdefULL;
+  for (int i = 0; i < RAND_TESTS; i++) {
+    for (int j = 0; j < 64; j++) {
+      rn[i][j] = rand64(&x);
+      ra[i][j] = rand64(&x);
+      rb[i][j] = rand64(&x);
+    }
+    // Odd moduli with the top bit set, a < n
+    rn[i][0] |= 1;
+    rn[i][3] |= (uint64_t)1U << 63;
+    rn[i][63] |= (uint64_t)1U << 63;
+    ra[i][3] >>= 1;
+    ra[i][63] >>= 1;
+  }
+
+  // Portable code first, then whatever AutoConfig2 selects (mulx/adcx/adox on
+  // CPUs with BMI2 and ADX)
+  ok &= run_vectors();
+  ok &= random_mod_exp(true);
+  EverCrypt_AutoConfig2_init();
+  ok &= run_vectors();
+  bool ok1 = random_mod_exp(false);
+  printf("\n mod_exp with runtime dispatch vs portable: %s\n", ok1 ? "Success!" : "**FAILED**");
+  ok &= ok1;
+  ok &= vartime_exp_widths();
+  ok &= consttime_exp_windows();
+  ok &= sqr_vs_mul();
+
+  cycles a, b;
+  uint64_t r[64];
+  a = cpucycles_begin();
+  for (int j = 0; j < 10; j++)
+    Hacl_Bignum4096_mod_exp_consttime(rn[0], ra[0], 4096, rb[0], r);
+  b = cpucycles_end();
+  printf("Bignum4096 mod_exp_consttime: %" PRIu64 " cycles\n", (uint64_t)(b - a) / 10);
+  a = cpucycles_begin();
+  for (int j = 0; j < 10; j++)
+    Hacl_Bignum4096_mod_exp_vartime(rn[0], ra[0], 4096, rb[0], r);
+  b = cpucycles_end();
+  printf("Bignum4096 mod_exp_vartime: %" PRIu64 " cycles\n", (uint64_t)(b - a) / 10);
+  uint64_t n[32], a0[32];
+  memcpy(n, rn[0], sizeof n);
+  memcpy(a0, ra[0], sizeof a0);
+  n[31] |= (uint64_t)1U << 63;
+  a0[31] >>= 1;
+  a = cpucycles_begin();
+  for (int j = 0; j < 10; j++)
+    Hacl_Bignum64_mod_exp_vartime(32, n, a0, 2048, rb[0], r);
+  b = cpucycles_end();
+  printf("Bignum64 (2048 bits) mod_exp_vartime: %" PRIu64 " cycles\n", (uint64_t)(b - a) / 10);
+
+  bench_consttime_windows();
 
   if (ok) return EXIT_SUCCESS;
   else return EXIT_FAILURE;
@@ -12,6 +12,7 @@
 #include "test_helpers.h"
 
 #include "Hacl_Chacha20Poly1305_256.h"
+#include "Hacl_Chacha20Poly1305_32.h"
 
 #include "EverCrypt_AutoConfig2.h"
 
@@ -47,6 +48,49 @@ bool print_test(int in_len, uint8_t* in, uint8_t* key, uint8_t* nonce, int aad_l
   return ok;
 }
 
+// Cross-check against the portable implementation on lengths around the
+// chunk boundaries of the single-pass encryption
+bool test_lengths(){
+  uint8_t key[32];
+  uint8_t nonce[12];
+  uint8_t aad[13];
+  uint8_t plain[4200];
+  uint8_t cipher[4200];
+  uint8_t cipher_ref[4200];
+  uint8_t decrypted[4200];
+  uint8_t mac[16];
+  uint8_t mac_ref[16];
+  bool ok = true;
+
+  for (int i = 0; i < 32; i++) key[i] = (uint8_t)(3 * i + 1);
+  for (int i = 0; i < 12; i++) nonce[i] = (uint8_t)(5 * i);
+  for (int i = 0; i < 13; i++) aad[i] = (uint8_t)(7 * i);
+  for (int i = 0; i < 4200; i++) plain[i] = (uint8_t)(i * 31 + (i >> 8));
+
+  uint32_t lens[] = { 0, 1, 15, 16, 63, 64, 255, 256, 511, 512, 1023, 1024, 1025, 2047, 2048, 2049, 3000, 4095, 4096, 4097, 4200 };
+  for (int i = 0; i < sizeof(lens)/sizeof(lens[0]); i++) {
+    uint32_t len = lens[i];
+    Hacl_Chacha20Poly1305_256_aead_encrypt(key, nonce, 13, aad, len, plain, cipher, mac);
+    Hacl_Chacha20Poly1305_32_aead_encrypt(key, nonce, 13, aad, len, plain, cipher_ref, mac_ref);
+    ok = ok && memcmp(cipher, cipher_ref, len) == 0 && memcmp(mac, mac_ref, 16) == 0;
+    ok = ok && Hacl_Chacha20Poly1305_256_aead_decrypt(key, nonce, 13, aad, len, decrypted, cipher, mac) == 0;
+    ok = ok && memcmp(decrypted, plain, len) == 0;
+    // In place
+    memcpy(decrypted, plain, len);
+    Hacl_Chacha20Poly1305_256_aead_encrypt(key, nonce, 13, aad, len, decrypted, decrypted, mac);
+    ok = ok && memcmp(decrypted, cipher_ref, len) == 0;
+    ok = ok && Hacl_Chacha20Poly1305_256_aead_decrypt(key, nonce, 13, aad, len, decrypted, decrypted, mac) == 0;
+    ok = ok && memcmp(decrypted, plain, len) == 0;
+    // A bad tag is rejected before anything is written, even in place
+    mac[i % 16] ^= 1;
+    memcpy(decrypted, cipher, len);
+    ok = ok && Hacl_Chacha20Poly1305_256_aead_decrypt(key, nonce, 13, aad, len, decrypted, decrypted, mac) == 1;
+    ok = ok && memcmp(decrypted, cipher, len) == 0;
+  }
+  printf("Chacha20Poly1305 (256-bit) lengths: %s\n", ok ? "Success!" : "**FAILED**");
+  return ok;
+}
+
 int main(){
   EverCrypt_AutoConfig2_init();
   if (!EverCrypt_AutoConfig2_has_vec256()) {
@@ -61,6 +105,7 @@ int main(){
   for (int i = 0; i < sizeof(vectors)/sizeof(chacha20poly1305_test_vector); ++i) {
     ok &= print_test(vectors[i].input_len,vectors[i].input,vectors[i].key,vectors[i].nonce,vectors[i].aad_len,vectors[i].aad,vectors[i].tag,vectors[i].cipher);
   }
+  ok &= test_lengths();
 
   uint8_t plain[SIZE];
   uint8_t cipher[SIZE];
@@ -66,6 +66,63 @@ bool test_nist()
 }
 
 
+// The fixed-base multiplication of dh_i must agree with the generic ladder of
+// dh_r run on the base point, including on scalars with zero or maximal windows
+bool test_keygen()
+{
+	static uint8_t basePoint[64] = {
+	0x6b, 0x17, 0xd1, 0xf2, 0xe1, 0x2c, 0x42, 0x47,
+	0xf8, 0xbc, 0xe6, 0xe5, 0x63, 0xa4, 0x40, 0xf2,
+	0x77, 0x03, 0x7d, 0x81, 0x2d, 0xeb, 0x33, 0xa0,
+	0xf4, 0xa1, 0x39, 0x45, 0xd8, 0x98, 0xc2, 0x96,
+	0x4f, 0xe3, 0x42, 0xe2, 0xfe, 0x1a, 0x7f, 0x9b,
+	0x8e, 0xe7, 0xeb, 0x4a, 0x7c, 0x0f, 0x9e, 0x16,
+	0x2b, 0xce, 0x33, 0x57, 0x6b, 0x31, 0x5e, 0xce,
+	0xcb, 0xb6, 0x40, 0x68, 0x37, 0xbf, 0x51, 0xf5};
+
+	static uint8_t orderMinusOne[32] = {
+	0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xbc, 0xe6, 0xfa, 0xad, 0xa7, 0x17, 0x9e, 0x84,
+	0xf3, 0xb9, 0xca, 0xc2, 0xfc, 0x63, 0x25, 0x50};
+
+	printf("ECDH keygen vs. ladder test\n");
+
+	uint8_t scalar[32];
+	uint8_t result_i[64];
+	uint8_t result_r[64];
+	bool ok = true;
+
+	for (int i = 0; i < 64; i++)
+	{
+		if (i == 0)
+			memcpy(scalar, orderMinusOne, 32);
+		else
+			for (int j = 0; j < 32; j++)
+			{
+				// Mix random-looking scalars with sparse ones (single words, all-ones nibbles)
+				if (i % 4 == 1)
+					scalar[j] = (j % 8 == i % 8) ? (uint8_t) i : 0;
+				else if (i % 4 == 2)
+					scalar[j] = (j < 8) ? 0 : 0xf0 | (uint8_t) j;
+				else
+					scalar[j] = (uint8_t) (i * 73 + j * 29 + (i >> 2));
+			}
+		bool success_i = Hacl_P256_ecp256dh_i(result_i, scalar);
+		bool success_r = Hacl_P256_ecp256dh_r(result_r, basePoint, scalar);
+		ok = ok && success_i && success_r;
+		ok = ok && memcmp(result_i, result_r, 64) == 0;
+	}
+
+	// [n - 1]G = -G has the x-coordinate of G
+	Hacl_P256_ecp256dh_i(result_i, orderMinusOne);
+	ok = ok && memcmp(result_i, basePoint, 32) == 0;
+
+	printf("%s\n", ok ? "Success!" : "**FAILED**");
+	return ok;
+}
+
+
 bool test_compression()
 {
 	// The start of compression tests
@@ -222,6 +279,11 @@ int main()
   		printf("%s\n", "ECDH NIST tests have failed");
     	return EXIT_FAILURE;
     }
+  if (!test_keygen())
+     {
+  		printf("%s\n", "ECDH keygen tests have failed");
+    	return EXIT_FAILURE;
+    }
   if (!test_compression())
      {
   		printf("%s\n", "ECDSA Compression tests have failed");
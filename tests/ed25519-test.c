@@ -0,0 +1,281 @@
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include <stdbool.h>
+
+#include <openssl/evp.h>
+#include <openssl/bn.h>
+
+#include "Hacl_Ed25519.h"
+
+#include "test_helpers.h"
+#include "ed25519_vectors.h"
+
+#define BATCH 20
+#define MSG_LEN 64
+#define ROUNDS 256
+
+bool print_test(uint8_t* sk, uint8_t* pk, uint32_t msg_len, uint8_t* msg, uint8_t* sig){
+  uint8_t pk_c[32];
+  uint8_t sig_c[64];
+
+  bool ok = true;
+  Hacl_Ed25519_secret_to_public(pk_c, sk);
+  printf("Ed25519 secret_to_public:\n");
+  ok &= compare_and_print(32, pk_c, pk);
+
+  Hacl_Ed25519_sign(sig_c, sk, msg_len, msg);
+  printf("Ed25519 sign:\n");
+  ok &= compare_and_print(64, sig_c, sig);
+
+  bool ver = Hacl_Ed25519_verify(pk, msg_len, msg, sig);
+  printf("Ed25519 verify: %s\n", ver ? "Success!" : "**FAILED**");
+  return ok && ver;
+}
+
+uint8_t sks[BATCH][32];
+uint8_t pks[BATCH][32];
+uint8_t msgs[BATCH][MSG_LEN];
+uint8_t sigs[BATCH][64];
+
+static uint32_t len_of(int i) { return (uint32_t)(i % MSG_LEN); }
+
+bool test_batch(){
+  uint8_t *pk[BATCH];
+  uint8_t *msg[BATCH];
+  uint8_t *sig[BATCH];
+  uint32_t len[BATCH];
+  bool res[BATCH];
+
+  for (int i = 0; i < BATCH; i++) {
+    for (int j = 0; j < 32; j++) sks[i][j] = (uint8_t)(7 * i + j);
+    for (int j = 0; j < MSG_LEN; j++) msgs[i][j] = (uint8_t)(i ^ j);
+    len[i] = len_of(i);
+    Hacl_Ed25519_secret_to_public(pks[i], sks[i]);
+    Hacl_Ed25519_sign(sigs[i], sks[i], len[i], msgs[i]);
+    pk[i] = pks[i];
+    msg[i] = msgs[i];
+    sig[i] = sigs[i];
+  }
+
+  bool ok = Hacl_Ed25519_verify_batch_cofactored(BATCH, pk, len, msg, sig, res);
+  for (int i = 0; i < BATCH; i++) ok &= res[i];
+  printf("Ed25519 verify_batch_cofactored (valid): %s\n", ok ? "Success!" : "**FAILED**");
+
+  // Corrupt one signature and one message: the batch must fail and pinpoint them
+  sigs[3][40] ^= 1;
+  msgs[13][0] ^= 1;
+  bool all = Hacl_Ed25519_verify_batch_cofactored(BATCH, pk, len, msg, sig, res);
+  bool ok1 = !all;
+  for (int i = 0; i < BATCH; i++) ok1 &= (res[i] == (i != 3 && i != 13));
+  printf("Ed25519 verify_batch_cofactored (invalid): %s\n", ok1 ? "Success!" : "**FAILED**");
+  sigs[3][40] ^= 1;
+  msgs[13][0] ^= 1;
+
+  bool ok2 = Hacl_Ed25519_verify_batch_cofactored(0, pk, len, msg, sig, res);
+  printf("Ed25519 verify_batch_cofactored (empty): %s\n", ok2 ? "Success!" : "**FAILED**");
+  return ok && ok1 && ok2;
+}
+
+// h = SHA-512(r || a || msg) mod q, as a BIGNUM
+static BIGNUM *challenge(const uint8_t *r, const uint8_t *a, uint32_t len, const uint8_t *msg, const BIGNUM *q, BN_CTX *bn) {
+  uint8_t buf[64 + MSG_LEN], d[64];
+  memcpy(buf, r, 32);
+  memcpy(buf + 32, a, 32);
+  memcpy(buf + 64, msg, len);
+  EVP_Digest(buf, 64 + len, d, NULL, EVP_sha512(), NULL);
+  BIGNUM *h = BN_lebin2bn(d, 64, NULL);
+  BN_nnmod(h, h, q, bn);
+  return h;
+}
+
+// A signature whose R is moved by the point of order 2 and whose s is
+// recomputed for the new challenge satisfies the cofactored equation only:
+// Hacl_Ed25519_verify rejects it, verify_batch_cofactored accepts its chunk.
+bool test_batch_small_order(){
+  BN_CTX *bn = BN_CTX_new();
+  BIGNUM *p = BN_new(), *q = NULL, *t = BN_new();
+  BN_set_bit(p, 255);
+  BN_sub_word(p, 19);
+  BN_hex2bn(&q, "1000000000000000000000000000000014def9dea2f79cd65812631a5cf5d3ed");
+
+  uint8_t ks[96];
+  Hacl_Ed25519_expand_keys(ks, sks[0]);
+  uint8_t sig[64];
+  memcpy(sig, sigs[0], 64);
+
+  // R + (0, -1) = (-x, -y): negate y and flip the sign bit of x
+  uint8_t y[32];
+  memcpy(y, sig, 32);
+  y[31] &= 0x7f;
+  BN_lebin2bn(y, 32, t);
+  BN_sub(t, p, t);
+  BN_bn2lebinpad(t, y, 32);
+  y[31] |= (sig[31] & 0x80) ^ 0x80;
+
+  BIGNUM *h = challenge(sig, pks[0], len_of(0), msgs[0], q, bn);
+  BIGNUM *h1 = challenge(y, pks[0], len_of(0), msgs[0], q, bn);
+  BIGNUM *a = BN_lebin2bn(ks + 32, 32, NULL);
+  BIGNUM *s = BN_lebin2bn(sig + 32, 32, NULL);
+  BN_mod_sub(t, h1, h, q, bn);
+  BN_mod_mul(t, t, a, q, bn);
+  BN_mod_add(s, s, t, q, bn);
+  memcpy(sig, y, 32);
+  BN_bn2lebinpad(s, sig + 32, 32);
+
+  uint8_t *pk[8], *msg[8], *sg[8];
+  uint32_t len[8];
+  bool res[8];
+  for (int i = 0; i < 8; i++) {
+    pk[i] = pks[i];
+    msg[i] = msgs[i];
+    sg[i] = sigs[i];
+    len[i] = len_of(i);
+  }
+  sg[0] = sig;
+  bool ok = !Hacl_Ed25519_verify(pks[0], len_of(0), msgs[0], sig);
+  ok = ok && Hacl_Ed25519_verify_batch_cofactored(8, pk, len, msg, sg, res) && res[0];
+  printf("Ed25519 verify_batch_cofactored (small-order component): %s\n", ok ? "Success!" : "**FAILED**");
+  BN_free(p); BN_free(q); BN_free(t); BN_free(h); BN_free(h1); BN_free(a); BN_free(s);
+  BN_CTX_free(bn);
+  return ok;
+}
+
+bool test_ctx(){
+  bool ok = true;
+  for (int i = 0; i < BATCH; i++) {
+    Hacl_Ed25519_pub_ctx *ctx = Hacl_Ed25519_new_pub_ctx(pks[i]);
+    uint32_t len = (uint32_t)(i % MSG_LEN);
+    ok &= ctx != NULL;
+    ok &= Hacl_Ed25519_verify_with_ctx(ctx, len, msgs[i], sigs[i]);
+    msgs[i][0] ^= 1;
+    ok &= !Hacl_Ed25519_verify_with_ctx(ctx, len == 0 ? 1 : len, msgs[i], sigs[i]);
+    msgs[i][0] ^= 1;
+    Hacl_Ed25519_pub_ctx_free(ctx);
+  }
+  // y = 2 is not on the curve
+  uint8_t bad[32] = { 2 };
+  ok &= Hacl_Ed25519_new_pub_ctx(bad) == NULL;
+  printf("Ed25519 verify_with_ctx: %s\n", ok ? "Success!" : "**FAILED**");
+  return ok;
+}
+
+// Cross-check the fixed-base multiplication against OpenSSL on many keys
+bool test_openssl(){
+  bool ok = true;
+  for (int i = 0; i < 256; i++) {
+    uint8_t sk[32];
+    uint8_t pk[32];
+    uint8_t pk_ossl[32];
+    size_t pk_len = 32;
+    for (int j = 0; j < 32; j++) sk[j] = (uint8_t)(i * 131 + j * 17 + (i >> 3));
+    Hacl_Ed25519_secret_to_public(pk, sk);
+    EVP_PKEY *key = EVP_PKEY_new_raw_private_key(EVP_PKEY_ED25519, NULL, sk, 32);
+    EVP_PKEY_get_raw_public_key(key, pk_ossl, &pk_len);
+    EVP_PKEY_free(key);
+    ok &= memcmp(pk, pk_ossl, 32) == 0;
+  }
+  printf("Ed25519 secret_to_public vs OpenSSL: %s\n", ok ? "Success!" : "**FAILED**");
+  return ok;
+}
+
+void bench_sign(){
+  uint8_t sig[64];
+  uint8_t pk[32];
+  cycles a,c;
+  clock_t t1,t2;
+  t1 = clock();
+  a = cpucycles_begin();
+  for (int j = 0; j < ROUNDS; j++)
+    Hacl_Ed25519_sign(sig, sks[j % BATCH], MSG_LEN, msgs[j % BATCH]);
+  c = cpucycles_end();
+  t2 = clock();
+  printf("Ed25519 sign: %" PRIu64 " cycles, %.2f us per signature\n",
+         (uint64_t)(c - a) / ROUNDS,
+         (double)(t2 - t1) * 1000000.0 / CLOCKS_PER_SEC / ROUNDS);
+
+  t1 = clock();
+  a = cpucycles_begin();
+  for (int j = 0; j < ROUNDS; j++)
+    Hacl_Ed25519_secret_to_public(pk, sks[j % BATCH]);
+  c = cpucycles_end();
+  t2 = clock();
+  printf("Ed25519 secret_to_public: %" PRIu64 " cycles, %.2f us per key\n",
+         (uint64_t)(c - a) / ROUNDS,
+         (double)(t2 - t1) * 1000000.0 / CLOCKS_PER_SEC / ROUNDS);
+}
+
+void bench_verify(){
+  uint8_t *pk[BATCH];
+  uint8_t *msg[BATCH];
+  uint8_t *sig[BATCH];
+  uint32_t len[BATCH];
+  bool res[BATCH];
+  bool b = true;
+  for (int i = 0; i < BATCH; i++) {
+    pk[i] = pks[i];
+    msg[i] = msgs[i];
+    sig[i] = sigs[i];
+    len[i] = (uint32_t)(i % MSG_LEN);
+  }
+
+  cycles a,c;
+  clock_t t1,t2;
+  t1 = clock();
+  a = cpucycles_begin();
+  for (int j = 0; j < ROUNDS; j++)
+    for (int i = 0; i < BATCH; i++)
+      b &= Hacl_Ed25519_verify(pk[i], len[i], msg[i], sig[i]);
+  c = cpucycles_end();
+  t2 = clock();
+  printf("Ed25519 verify: %" PRIu64 " cycles per signature, %.2f us per signature\n",
+         (uint64_t)(c - a) / (ROUNDS * BATCH),
+         (double)(t2 - t1) * 1000000.0 / CLOCKS_PER_SEC / (ROUNDS * BATCH));
+
+  Hacl_Ed25519_pub_ctx *ctx[BATCH];
+  for (int i = 0; i < BATCH; i++) ctx[i] = Hacl_Ed25519_new_pub_ctx(pk[i]);
+  t1 = clock();
+  a = cpucycles_begin();
+  for (int j = 0; j < ROUNDS; j++)
+    for (int i = 0; i < BATCH; i++)
+      b &= Hacl_Ed25519_verify_with_ctx(ctx[i], len[i], msg[i], sig[i]);
+  c = cpucycles_end();
+  t2 = clock();
+  for (int i = 0; i < BATCH; i++) Hacl_Ed25519_pub_ctx_free(ctx[i]);
+  printf("Ed25519 verify_with_ctx: %" PRIu64 " cycles per signature, %.2f us per signature\n",
+         (uint64_t)(c - a) / (ROUNDS * BATCH),
+         (double)(t2 - t1) * 1000000.0 / CLOCKS_PER_SEC / (ROUNDS * BATCH));
+
+  t1 = clock();
+  a = cpucycles_begin();
+  for (int j = 0; j < ROUNDS; j++)
+    b &= Hacl_Ed25519_verify_batch_cofactored(BATCH, pk, len, msg, sig, res);
+  c = cpucycles_end();
+  t2 = clock();
+  printf("Ed25519 verify_batch_cofactored: %" PRIu64 " cycles per signature, %.2f us per signature\n",
+         (uint64_t)(c - a) / (ROUNDS * BATCH),
+         (double)(t2 - t1) * 1000000.0 / CLOCKS_PER_SEC / (ROUNDS * BATCH));
+  if (!b) printf("**FAILED**\n");
+}
+
+int main() {
+  bool ok = true;
+  for (int i = 0; i < sizeof(vectors)/sizeof(ed25519_test_vector); ++i) {
+    ok &= print_test(vectors[i].sk,vectors[i].pk,vectors[i].msg_len,vectors[i].msg,vectors[i].sig);
+  }
+  ok &= test_batch();
+  ok &= test_batch_small_order();
+  ok &= test_ctx();
+  ok &= test_openssl();
+  bench_sign();
+  bench_verify();
+
+  if (ok) return EXIT_SUCCESS;
+  else return EXIT_FAILURE;
+}
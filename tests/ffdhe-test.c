@@ -6,9 +6,11 @@
 #include <sys/stat.h>
 #include <fcntl.h>
 #include <unistd.h>
+#include <time.h>
 #include <stdbool.h>
 
 #include "Hacl_FFDHE.h"
+#include "EverCrypt_AutoConfig2.h"
 
 #include "test_helpers.h"
 #include "ffdhe_vectors.h"
@@ -44,15 +46,96 @@ bool print_test(Spec_FFDHE_ffdhe_alg a, uint8_t* sk1, uint8_t* pk1, uint8_t* sk2
   printf("FFDHE ss1 =? exp:\n");
   ok &= compare_and_print(len,ss1,exp);
 
+  // Fixed-base comb; the extended context also serves shared_secret_precomp
+  uint64_t *p_r2_g = Hacl_FFDHE_new_ffdhe_precomp_p_g(a);
+  memset (pk_c1, 0U, len * sizeof (uint8_t));
+  memset (ss1, 0U, len * sizeof (uint8_t));
+  Hacl_FFDHE_ffdhe_secret_to_public_precomp_g(a, p_r2_g, sk1, pk_c1);
+  Hacl_FFDHE_ffdhe_shared_secret_precomp(a, p_r2_g, sk1, pk2, ss1);
+  free(p_r2_g);
+
+  printf("FFDHE pk1 =? pk_c1 (comb): ");
+  ok &= compare(len,pk_c1,pk1);
+
+  printf("FFDHE ss1 =? exp (comb): ");
+  ok &= compare(len,ss1,exp);
+
+  return ok;
+}
+
+Spec_FFDHE_ffdhe_alg algs[5] = {
+  Spec_FFDHE_FFDHE2048, Spec_FFDHE_FFDHE3072, Spec_FFDHE_FFDHE4096,
+  Spec_FFDHE_FFDHE6144, Spec_FFDHE_FFDHE8192
+};
+
+// The comb must agree with the generic exponentiation on arbitrary keys,
+// including all-zero and all-one ones
+bool test_comb(Spec_FFDHE_ffdhe_alg a){
+  uint32_t len = Hacl_FFDHE_ffdhe_len(a);
+  uint8_t sk[len];
+  uint8_t pk[len];
+  uint8_t pk_c[len];
+  uint64_t *p_r2_g = Hacl_FFDHE_new_ffdhe_precomp_p_g(a);
+  bool ok = true;
+  for (int i = 0; i < 6; i++) {
+    for (uint32_t j = 0; j < len; j++)
+      sk[j] = i == 0 ? 0 : i == 1 ? 0xff : (uint8_t)(i * 97 + j * 31 + (j >> 5));
+    Hacl_FFDHE_ffdhe_secret_to_public(a, sk, pk);
+    Hacl_FFDHE_ffdhe_secret_to_public_precomp_g(a, p_r2_g, sk, pk_c);
+    ok &= memcmp(pk, pk_c, len) == 0;
+  }
+  free(p_r2_g);
+  printf("FFDHE%u comb vs generic exponentiation: %s\n", len * 8, ok ? "Success!" : "**FAILED**");
   return ok;
 }
 
+#define ROUNDS 20
+
+void bench(Spec_FFDHE_ffdhe_alg a){
+  uint32_t len = Hacl_FFDHE_ffdhe_len(a);
+  uint8_t sk[len];
+  uint8_t pk[len];
+  for (uint32_t j = 0; j < len; j++) sk[j] = (uint8_t)(j * 13 + 7);
+  uint64_t *p_r2_n = Hacl_FFDHE_new_ffdhe_precomp_p(a);
+  uint64_t *p_r2_g = Hacl_FFDHE_new_ffdhe_precomp_p_g(a);
+
+  cycles c0, c1;
+  clock_t t1, t2;
+  t1 = clock();
+  c0 = cpucycles_begin();
+  for (int j = 0; j < ROUNDS; j++)
+    Hacl_FFDHE_ffdhe_secret_to_public_precomp(a, p_r2_n, sk, pk);
+  c1 = cpucycles_end();
+  t2 = clock();
+  printf("FFDHE%u secret_to_public_precomp: %" PRIu64 " cycles, %.2f ms\n", len * 8,
+         (uint64_t)(c1 - c0) / ROUNDS, (double)(t2 - t1) * 1000.0 / CLOCKS_PER_SEC / ROUNDS);
+
+  t1 = clock();
+  c0 = cpucycles_begin();
+  for (int j = 0; j < ROUNDS; j++)
+    Hacl_FFDHE_ffdhe_secret_to_public_precomp_g(a, p_r2_g, sk, pk);
+  c1 = cpucycles_end();
+  t2 = clock();
+  printf("FFDHE%u secret_to_public_precomp_g: %" PRIu64 " cycles, %.2f ms\n", len * 8,
+         (uint64_t)(c1 - c0) / ROUNDS, (double)(t2 - t1) * 1000.0 / CLOCKS_PER_SEC / ROUNDS);
+  free(p_r2_n);
+  free(p_r2_g);
+}
+
 
 int main() {
   bool ok = true;
   for (int i = 0; i < sizeof(vectors)/sizeof(ffdhe_test_vector); ++i) {
     ok &= print_test(vectors[i].alg,vectors[i].sk1,vectors[i].pk1,vectors[i].sk2,vectors[i].pk2,vectors[i].ss);
   }
+  for (int i = 0; i < 5; i++)
+    ok &= test_comb(algs[i]);
+  bench(Spec_FFDHE_FFDHE4096);
+
+  EverCrypt_AutoConfig2_init();
+  for (int i = 0; i < 5; i++)
+    ok &= test_comb(algs[i]);
+  bench(Spec_FFDHE_FFDHE4096);
 
   if (ok) return EXIT_SUCCESS;
   else return EXIT_FAILURE;
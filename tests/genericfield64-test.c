@@ -0,0 +1,253 @@
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <stdbool.h>
+
+#include "Hacl_GenericField64.h"
+#include "Hacl_Impl_FFDHE_Constants.h"
+
+#include "test_helpers.h"
+
+#define LEN 64
+#define MAX_BASES 24
+#define ROUNDS 10
+
+static uint64_t rnd_state = 0x243f6a8885a308d3ULL;
+
+static uint64_t rnd64()
+{
+  rnd_state ^= rnd_state << 13;
+  rnd_state ^= rnd_state >> 7;
+  rnd_state ^= rnd_state << 17;
+  return rnd_state;
+}
+
+static void rnd_bn(uint32_t len, uint64_t *a)
+{
+  for (uint32_t i = 0; i < len; i++) a[i] = rnd64();
+}
+
+// Random odd len-limb modulus with the top bit set
+static void rnd_modulus(uint32_t len, uint64_t *n)
+{
+  rnd_bn(len, n);
+  n[0] |= 1;
+  n[len - 1] |= (uint64_t)1 << 63;
+}
+
+// Random exponent of at most bBits bits
+static void rnd_exp(uint32_t bBits, uint64_t *b)
+{
+  uint32_t bLen = (bBits - 1) / 64 + 1;
+  rnd_bn(bLen, b);
+  if (bBits % 64 != 0) b[bLen - 1] &= ((uint64_t)1 << (bBits % 64)) - 1;
+}
+
+// Reference: product of the individual exponentiations
+static void multi_exp_ref(Hacl_Bignum_MontArithmetic_bn_mont_ctx_u64 *k, uint32_t nBases,
+                          uint64_t *aM, uint32_t bBits, uint64_t *b, uint64_t *resM, bool ct)
+{
+  uint32_t len = Hacl_GenericField64_field_get_len(k);
+  uint32_t bLen = (bBits - 1) / 64 + 1;
+  uint64_t tmp[LEN];
+  Hacl_GenericField64_one(k, resM);
+  for (uint32_t i = 0; i < nBases; i++) {
+    if (ct)
+      Hacl_GenericField64_exp_consttime(k, aM + i * len, bBits, b + i * bLen, tmp);
+    else
+      Hacl_GenericField64_exp_vartime(k, aM + i * len, bBits, b + i * bLen, tmp);
+    Hacl_GenericField64_mul(k, resM, tmp, resM);
+  }
+}
+
+bool test_multi_exp(uint32_t len, uint32_t nBases, uint32_t bBits)
+{
+  uint32_t bLen = (bBits - 1) / 64 + 1;
+  uint64_t n[LEN];
+  uint64_t a[MAX_BASES * LEN];
+  uint64_t aM[MAX_BASES * LEN];
+  uint64_t b[MAX_BASES * LEN];
+  uint64_t res_ref[LEN];
+  uint64_t res_ct[LEN];
+  uint64_t res_vt[LEN];
+
+  rnd_modulus(len, n);
+  Hacl_Bignum_MontArithmetic_bn_mont_ctx_u64 *k = Hacl_GenericField64_field_init(len, n);
+  for (uint32_t i = 0; i < nBases; i++) {
+    rnd_bn(len, a + i * len);
+    a[i * len + len - 1] >>= 1;
+    Hacl_GenericField64_to_field(k, a + i * len, aM + i * len);
+    rnd_exp(bBits, b + i * bLen);
+  }
+  // Exercise zero windows and a zero exponent
+  b[0] &= ~(uint64_t)0xff0;
+  if (nBases > 2) memset(b + 2 * bLen, 0, bLen * sizeof(uint64_t));
+
+  multi_exp_ref(k, nBases, aM, bBits, b, res_ref, true);
+  Hacl_GenericField64_multi_exp_consttime(k, nBases, aM, bBits, b, res_ct);
+  Hacl_GenericField64_multi_exp_vartime(k, nBases, aM, bBits, b, res_vt);
+  Hacl_GenericField64_field_free(k);
+
+  bool ok = memcmp(res_ref, res_ct, len * sizeof(uint64_t)) == 0;
+  ok = ok && memcmp(res_ref, res_vt, len * sizeof(uint64_t)) == 0;
+  printf("GenericField64 multi_exp (%u limbs, %u bases, %u-bit exponents): %s\n",
+         len, nBases, bBits, ok ? "Success!" : "**FAILED**");
+  return ok;
+}
+
+void bench_multi_exp(uint32_t nBases, uint32_t bBits)
+{
+  uint32_t len = LEN;
+  uint32_t bLen = (bBits - 1) / 64 + 1;
+  uint64_t n[LEN];
+  uint64_t aM[MAX_BASES * LEN];
+  uint64_t b[MAX_BASES * LEN];
+  uint64_t res[LEN];
+
+  rnd_modulus(len, n);
+  Hacl_Bignum_MontArithmetic_bn_mont_ctx_u64 *k = Hacl_GenericField64_field_init(len, n);
+  for (uint32_t i = 0; i < nBases; i++) {
+    rnd_bn(len, aM + i * len);
+    aM[i * len + len - 1] >>= 1;
+    rnd_exp(bBits, b + i * bLen);
+  }
+
+  for (int ct = 1; ct >= 0; ct--) {
+    cycles c0, c1;
+    clock_t t1, t2;
+    t1 = clock();
+    c0 = cpucycles_begin();
+    for (int j = 0; j < ROUNDS; j++)
+      multi_exp_ref(k, nBases, aM, bBits, b, res, ct);
+    c1 = cpucycles_end();
+    t2 = clock();
+    printf("%u x exp_%s + mul: %" PRIu64 " cycles, %.2f ms\n", nBases,
+           ct ? "consttime" : "vartime", (uint64_t)(c1 - c0) / ROUNDS,
+           (double)(t2 - t1) * 1000.0 / CLOCKS_PER_SEC / ROUNDS);
+
+    t1 = clock();
+    c0 = cpucycles_begin();
+    for (int j = 0; j < ROUNDS; j++) {
+      if (ct)
+        Hacl_GenericField64_multi_exp_consttime(k, nBases, aM, bBits, b, res);
+      else
+        Hacl_GenericField64_multi_exp_vartime(k, nBases, aM, bBits, b, res);
+    }
+    c1 = cpucycles_end();
+    t2 = clock();
+    printf("multi_exp_%s (%u bases): %" PRIu64 " cycles, %.2f ms\n",
+           ct ? "consttime" : "vartime", nBases, (uint64_t)(c1 - c0) / ROUNDS,
+           (double)(t2 - t1) * 1000.0 / CLOCKS_PER_SEC / ROUNDS);
+  }
+  Hacl_GenericField64_field_free(k);
+}
+
+#define MAX_ELEMS 256
+
+// Load a big-endian prime from the FFDHE constants as len limbs
+static void load_prime(uint32_t len, const uint8_t *p, uint64_t *n)
+{
+  for (uint32_t i = 0; i < len; i++) {
+    uint64_t x = 0;
+    for (uint32_t j = 0; j < 8; j++) x = x << 8 | p[(len - 1 - i) * 8 + j];
+    n[i] = x;
+  }
+}
+
+bool test_inverse_batch(uint32_t len, const uint8_t *p, uint32_t nElems)
+{
+  uint64_t n[LEN];
+  uint64_t *aM = malloc(nElems * len * sizeof(uint64_t));
+  uint64_t *aInvM = malloc(nElems * len * sizeof(uint64_t));
+  uint64_t ref[LEN];
+  uint64_t one[LEN];
+  uint64_t tmp[LEN];
+
+  load_prime(len, p, n);
+  Hacl_Bignum_MontArithmetic_bn_mont_ctx_u64 *k = Hacl_GenericField64_field_init(len, n);
+  for (uint32_t i = 0; i < nElems; i++) {
+    rnd_bn(len, aM + i * len);
+    aM[i * len + len - 1] >>= 1;
+  }
+  // The element 1 in Montgomery form
+  if (nElems > 1) Hacl_GenericField64_one(k, aM + len);
+  Hacl_GenericField64_inverse_batch(k, nElems, aM, aInvM);
+
+  bool ok = true;
+  Hacl_GenericField64_one(k, one);
+  for (uint32_t i = 0; i < nElems; i++) {
+    Hacl_GenericField64_inverse(k, aM + i * len, ref);
+    ok &= memcmp(ref, aInvM + i * len, len * sizeof(uint64_t)) == 0;
+    Hacl_GenericField64_mul(k, aM + i * len, aInvM + i * len, tmp);
+    ok &= memcmp(one, tmp, len * sizeof(uint64_t)) == 0;
+  }
+  Hacl_GenericField64_field_free(k);
+  free(aM);
+  free(aInvM);
+  printf("GenericField64 inverse_batch (%u limbs, %u elements): %s\n",
+         len, nElems, ok ? "Success!" : "**FAILED**");
+  return ok;
+}
+
+void bench_inverse_batch(uint32_t len, const uint8_t *p, uint32_t nElems)
+{
+  uint64_t n[LEN];
+  uint64_t *aM = malloc(nElems * len * sizeof(uint64_t));
+  uint64_t *aInvM = malloc(nElems * len * sizeof(uint64_t));
+
+  load_prime(len, p, n);
+  Hacl_Bignum_MontArithmetic_bn_mont_ctx_u64 *k = Hacl_GenericField64_field_init(len, n);
+  for (uint32_t i = 0; i < nElems; i++) {
+    rnd_bn(len, aM + i * len);
+    aM[i * len + len - 1] >>= 1;
+  }
+
+  cycles c0, c1;
+  clock_t t1, t2;
+  t1 = clock();
+  c0 = cpucycles_begin();
+  for (uint32_t i = 0; i < nElems; i++)
+    Hacl_GenericField64_inverse(k, aM + i * len, aInvM + i * len);
+  c1 = cpucycles_end();
+  t2 = clock();
+  printf("%u x inverse (%u limbs): %" PRIu64 " cycles per element, %.2f ms\n", nElems, len,
+         (uint64_t)(c1 - c0) / nElems, (double)(t2 - t1) * 1000.0 / CLOCKS_PER_SEC);
+
+  t1 = clock();
+  c0 = cpucycles_begin();
+  Hacl_GenericField64_inverse_batch(k, nElems, aM, aInvM);
+  c1 = cpucycles_end();
+  t2 = clock();
+  printf("inverse_batch of %u (%u limbs): %" PRIu64 " cycles per element, %.2f ms\n", nElems, len,
+         (uint64_t)(c1 - c0) / nElems, (double)(t2 - t1) * 1000.0 / CLOCKS_PER_SEC);
+  Hacl_GenericField64_field_free(k);
+  free(aM);
+  free(aInvM);
+}
+
+int main()
+{
+  bool ok = true;
+  ok &= test_multi_exp(LEN, 1, 4096);
+  ok &= test_multi_exp(LEN, 3, 4093);
+  ok &= test_multi_exp(LEN, 5, 1027);
+  ok &= test_multi_exp(33, 4, 2110);
+  ok &= test_multi_exp(4, 8, 3);
+  ok &= test_multi_exp(1, 2, 64);
+  // More bases than one group of window tables
+  ok &= test_multi_exp(4, 19, 200);
+  ok &= test_multi_exp(2, 16, 128);
+
+  ok &= test_inverse_batch(32, Hacl_Impl_FFDHE_Constants_ffdhe_p2048, 1);
+  ok &= test_inverse_batch(32, Hacl_Impl_FFDHE_Constants_ffdhe_p2048, 2);
+  ok &= test_inverse_batch(32, Hacl_Impl_FFDHE_Constants_ffdhe_p2048, 37);
+  ok &= test_inverse_batch(LEN, Hacl_Impl_FFDHE_Constants_ffdhe_p4096, 9);
+
+  bench_multi_exp(4, 4096);
+  bench_inverse_batch(32, Hacl_Impl_FFDHE_Constants_ffdhe_p2048, MAX_ELEMS);
+
+  if (ok) return EXIT_SUCCESS;
+  else return EXIT_FAILURE;
+}
@@ -1,6 +1,9 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include <assert.h>
+#include <inttypes.h>
+#include <time.h>
+#include <unistd.h>
 
 #include "EverCrypt_AutoConfig2.h"
 #include "MerkleTree.h"
@@ -32,6 +35,532 @@ void print_tree(const mt_p mt, size_t num_elts) {
   }
 }
 
+static void fill_hash(uint8_t *h, uint64_t i) {
+  memset(h, 0, hash_size);
+  for (uint32_t b = 0; b < 8; b++)
+    h[b] = (uint8_t)(i >> (8 * b));
+  h[hash_size-1] = 0xA5;
+}
+
+static bool same_root(mt_p a, mt_p b) {
+  uint8_t ra[32], rb[32];
+  mt_get_root(a, ra);
+  mt_get_root(b, rb);
+  return memcmp(ra, rb, hash_size) == 0;
+}
+
+static bool same_paths(mt_p a, mt_p b, uint64_t from, uint64_t to) {
+  uint8_t ra[32], rb[32];
+  bool ok = true;
+  for (uint64_t k = from; k < to; k++) {
+    MerkleTree_Low_path *pa = mt_init_path(hash_size);
+    MerkleTree_Low_path *pb = mt_init_path(hash_size);
+    uint32_t ja = mt_get_path(a, k, pa, ra);
+    uint32_t jb = mt_get_path(b, k, pb, rb);
+    ok = ok && ja == jb && memcmp(ra, rb, hash_size) == 0;
+    ok = ok && mt_get_path_length(pa) == mt_get_path_length(pb);
+    for (uint32_t l = 0; ok && l < mt_get_path_length(pa); l++)
+      ok = memcmp(mt_get_path_step(pa, l), mt_get_path_step(pb, l), hash_size) == 0;
+    ok = ok && mt_verify(b, k, jb, pb, rb);
+    mt_free_path(pa);
+    mt_free_path(pb);
+  }
+  return ok;
+}
+
+// Arena-backed trees must agree with the default ones through inserts,
+// flushes and retractions, including across chunk boundaries
+bool test_arena() {
+  uint8_t h[32];
+  bool ok = true;
+  uint64_t sizes[] = { 1, 2, 3, 127, 128, 129, 300, 1000 };
+  for (size_t t = 0; t < sizeof(sizes)/sizeof(sizes[0]); t++) {
+    uint64_t n = sizes[t];
+    fill_hash(h, 0);
+    mt_p mt = mt_create(h);
+    fill_hash(h, 0);
+    mt_p ma = mt_create_arena(h);
+    for (uint64_t i = 1; i < n; i++) {
+      fill_hash(h, i);
+      mt_insert(mt, h);
+      fill_hash(h, i);
+      mt_insert(ma, h);
+    }
+    ok = ok && same_root(mt, ma) && same_paths(mt, ma, 0, n);
+
+    uint64_t flush_to = n / 3;
+    mt_flush_to(mt, flush_to);
+    mt_flush_to(ma, flush_to);
+    ok = ok && same_paths(mt, ma, flush_to, n);
+
+    uint64_t retract_to = flush_to + (n - flush_to) / 2;
+    mt_retract_to(mt, retract_to);
+    mt_retract_to(ma, retract_to);
+    ok = ok && same_root(mt, ma) && same_paths(mt, ma, flush_to, retract_to + 1);
+
+    for (uint64_t i = retract_to + 1; i < n + 200; i++) {
+      fill_hash(h, 3 * i);
+      mt_insert(mt, h);
+      fill_hash(h, 3 * i);
+      mt_insert(ma, h);
+    }
+    flush_to = retract_to + (n + 200 - retract_to) / 2;
+    mt_flush_to(mt, flush_to);
+    mt_flush_to(ma, flush_to);
+    ok = ok && same_root(mt, ma) && same_paths(mt, ma, flush_to, n + 200);
+
+    size_t num_bytes = mt_serialize_size(ma);
+    uint8_t *buf = malloc(num_bytes);
+    uint64_t written = mt_serialize(ma, buf, num_bytes);
+    ok = ok && written == num_bytes;
+    merkle_tree *md = mt_deserialize(buf, written, mt_sha256_compress);
+    ok = ok && md != NULL && same_root(md, mt) && same_paths(md, ma, flush_to, n + 200);
+    free(buf);
+    mt_free(md);
+
+    mt_free(mt);
+    mt_free(ma);
+  }
+  printf("Arena storage: %s\n", ok ? "Success!" : "**FAILED**");
+  return ok;
+}
+
+static void xor_compress(uint8_t *src1, uint8_t *src2, uint8_t *dst) {
+  uint8_t t[32];
+  for (uint32_t i = 0; i < hash_size; i++)
+    t[i] = (uint8_t)(src1[i] ^ (src2[i] * 3) ^ i);
+  memcpy(dst, t, hash_size);
+}
+
+static mt_p create_tree(int kind, uint8_t *init) {
+  switch (kind) {
+  case 0: return mt_create(init);
+  case 1: return mt_create_arena(init);
+  default: return mt_create_custom(hash_size, init, xor_compress);
+  }
+}
+
+// Batches must build the same tree as one-by-one insertion, whatever the
+// batch sizes, the storage mode and the hash function
+bool test_insert_batch() {
+  static uint8_t leaves[700 * 32];
+  uint8_t h[32];
+  bool ok = true;
+  uint32_t batches[] = { 0, 1, 2, 3, 7, 8, 9, 63, 64, 65, 130, 300 };
+  for (uint32_t i = 0; i < 700; i++)
+    fill_hash(leaves + 32 * i, i + 1);
+  for (int kind = 0; kind < 3; kind++) {
+    fill_hash(h, 0);
+    mt_p ms = create_tree(kind, h);
+    fill_hash(h, 0);
+    mt_p mb = create_tree(kind, h);
+    uint32_t next = 0;
+    for (size_t t = 0; t < sizeof(batches)/sizeof(batches[0]); t++) {
+      uint32_t n = batches[t];
+      ok = ok && mt_insert_batch_pre(mb, leaves + 32 * next, n);
+      mt_insert_batch(mb, leaves + 32 * next, n);
+      for (uint32_t k = 0; k < n; k++) {
+        memcpy(h, leaves + 32 * (next + k), hash_size);
+        mt_insert(ms, h);
+      }
+      next += n;
+      ok = ok && same_root(ms, mb) && same_paths(ms, mb, next / 2, next + 1);
+      if (t == 6) {
+        mt_flush_to(ms, next / 2 + 1);
+        mt_flush_to(mb, next / 2 + 1);
+      }
+    }
+    mt_free(ms);
+    mt_free(mb);
+  }
+  printf("mt_insert_batch: %s\n", ok ? "Success!" : "**FAILED**");
+  return ok;
+}
+
+static void remove_tree_files(const char *dir) {
+  char path[256];
+  for (uint32_t lv = 0; lv < 32; lv++) {
+    snprintf(path, sizeof path, "%s/level%02u", dir, lv);
+    unlink(path);
+  }
+  rmdir(dir);
+}
+
+// Memory-mapped trees must agree with the default ones, and reopening one
+// must give back the tree as of its last mt_sync or mt_free
+bool test_mmap() {
+  char tmp[] = "/tmp/mt_mmap_XXXXXX";
+  char dir[64];
+  uint8_t h[32];
+  bool ok = mkdtemp(tmp) != NULL;
+  snprintf(dir, sizeof dir, "%s/tree", tmp);
+  uint64_t sizes[] = { 1, 2, 3, 129, 1000, 5000 };
+  for (size_t t = 0; ok && t < sizeof(sizes)/sizeof(sizes[0]); t++) {
+    uint64_t n = sizes[t];
+    fill_hash(h, 0);
+    mt_p mt = mt_create(h);
+    fill_hash(h, 0);
+    mt_p mm = mt_create_mmap(dir, h);
+    ok = ok && mm != NULL;
+    if (!ok)
+      break;
+    fill_hash(h, 0);
+    ok = ok && mt_create_mmap(dir, h) == NULL;
+    for (uint64_t i = 1; i < n; i++) {
+      fill_hash(h, i);
+      mt_insert(mt, h);
+      fill_hash(h, i);
+      mt_insert(mm, h);
+    }
+    ok = ok && same_root(mt, mm) && same_paths(mt, mm, 0, n);
+
+    uint64_t flush_to = n / 3;
+    mt_flush_to(mt, flush_to);
+    mt_flush_to(mm, flush_to);
+    uint64_t retract_to = flush_to + (n - flush_to) / 2;
+    mt_retract_to(mt, retract_to);
+    mt_retract_to(mm, retract_to);
+    ok = ok && mt_sync(mm) && same_root(mt, mm);
+    mt_free(mm);
+    mm = mt_open_mmap(dir);
+    ok = ok && mm != NULL && same_root(mt, mm) && same_paths(mt, mm, flush_to, retract_to + 1);
+    if (!ok)
+      break;
+
+    // Inserts after reopening go to the end of the level files
+    uint8_t *leaves = malloc(hash_size * 300);
+    for (uint64_t i = 0; i < 300; i++) {
+      fill_hash(h, 5 * i);
+      mt_insert(mt, h);
+      fill_hash(leaves + hash_size * i, 5 * i);
+    }
+    mt_insert_batch(mm, leaves, 300);
+    free(leaves);
+    uint64_t last = retract_to + 301;
+    flush_to = retract_to + 150;
+    mt_flush_to(mt, flush_to);
+    mt_flush_to(mm, flush_to);
+    ok = ok && same_root(mt, mm);
+    mt_free(mm);
+    mm = mt_open_mmap(dir);
+    ok = ok && mm != NULL && same_root(mt, mm) && same_paths(mt, mm, flush_to, last);
+    ok = ok && mt_open_custom_mmap(dir, 64, xor_compress) == NULL;
+    if (!ok)
+      break;
+
+    // Inserting after a retraction must not overwrite the hashes on disk:
+    // a crash at that point reopens the retracted tree
+    mt_retract_to(mt, last - 50);
+    mt_retract_to(mm, last - 50);
+    for (uint64_t i = 0; i < 20; i++) {
+      fill_hash(h, 7 * i + 1);
+      ok = ok && mt_insert(mm, h);
+    }
+    mt_p mc = mt_open_mmap(dir);
+    ok = ok && mc != NULL && same_root(mt, mc);
+    mt_free(mm);
+    if (mc != NULL)
+      mt_free(mc);
+    mm = mt_open_mmap(dir);
+    ok = ok && mm != NULL && same_root(mt, mm);
+
+    mt_free(mt);
+    if (mm != NULL)
+      mt_free(mm);
+    remove_tree_files(dir);
+  }
+  ok = ok && mt_open_mmap(dir) == NULL;
+  rmdir(tmp);
+  printf("Memory-mapped storage: %s\n", ok ? "Success!" : "**FAILED**");
+  return ok;
+}
+
+void bench_mmap() {
+  const uint32_t n = 1 << 20;
+  char tmp[] = "/tmp/mt_mmap_XXXXXX";
+  char dir[64];
+  uint8_t h[32], r1[32], r2[32];
+  clock_t t1, t2;
+  if (mkdtemp(tmp) == NULL)
+    return;
+  snprintf(dir, sizeof dir, "%s/tree", tmp);
+  uint8_t *leaves = malloc((size_t)hash_size * n);
+  for (uint32_t i = 0; i < n; i++)
+    fill_hash(leaves + hash_size * i, i + 1);
+
+  fill_hash(h, 0);
+  mt_p mt = mt_create_arena(h);
+  mt_insert_batch(mt, leaves, n - 1);
+  size_t num_bytes = mt_serialize_size(mt);
+  uint8_t *buf = malloc(num_bytes);
+  uint64_t written = mt_serialize(mt, buf, num_bytes);
+  mt_free(mt);
+  t1 = clock();
+  mt = mt_deserialize(buf, written, mt_sha256_compress);
+  mt_get_root(mt, r1);
+  t2 = clock();
+  mt_free(mt);
+  free(buf);
+  printf("Reload %" PRIu32 " leaves with mt_deserialize: %.2f ms\n", n,
+         (double)(t2 - t1) * 1000.0 / CLOCKS_PER_SEC);
+
+  fill_hash(h, 0);
+  mt = mt_create_mmap(dir, h);
+  mt_insert_batch(mt, leaves, n - 1);
+  mt_free(mt);
+  t1 = clock();
+  mt = mt_open_mmap(dir);
+  mt_get_root(mt, r2);
+  t2 = clock();
+  mt_free(mt);
+  printf("Reload %" PRIu32 " leaves with mt_open_mmap: %.2f ms (%s root)\n", n,
+         (double)(t2 - t1) * 1000.0 / CLOCKS_PER_SEC,
+         memcmp(r1, r2, hash_size) == 0 ? "same" : "**different**");
+  free(leaves);
+  remove_tree_files(dir);
+  rmdir(tmp);
+}
+
+// Pick a sorted subset of [from, to) with clusters and isolated indices
+static uint32_t pick_indices(uint64_t *idx, uint32_t max_n, uint64_t from, uint64_t to, uint64_t seed) {
+  uint32_t n = 0;
+  uint64_t x = seed * 2654435761u + 1;
+  for (uint64_t k = from; k < to && n < max_n; k++) {
+    x = x * 6364136223846793005ull + 1442695040888963407ull;
+    if ((x >> 60) < 3 || k + 1 == to)
+      idx[n++] = k;
+  }
+  return n;
+}
+
+// Multiproofs must verify, agree with mt_get_path for a single index, never
+// be longer than the separate paths, and reject tampered hashes
+bool test_multiproof() {
+  uint8_t h[32], root[32], r1[32];
+  uint64_t idx[512];
+  bool ok = true;
+  uint64_t sizes[] = { 1, 2, 3, 7, 8, 9, 100, 1000 };
+  for (size_t t = 0; t < sizeof(sizes)/sizeof(sizes[0]); t++) {
+    uint64_t n = sizes[t];
+    for (int kind = 0; kind < 3; kind++) {
+      fill_hash(h, 0);
+      mt_p mt = create_tree(kind, h);
+      for (uint64_t i = 1; i < n; i++) {
+        fill_hash(h, i);
+        mt_insert(mt, h);
+      }
+      for (uint64_t from = 0; from < n; from += n / 3 + 1) {
+        if (from > 0)
+          mt_flush_to(mt, from);
+        for (uint64_t seed = 0; seed < 4; seed++) {
+          uint32_t m = pick_indices(idx, 512, from, n, seed);
+          MerkleTree_Low_path *p = mt_init_path(hash_size);
+          ok = ok && mt_get_paths_pre(mt, idx, m, p, root);
+          uint32_t j = mt_get_paths(mt, idx, m, p, root);
+          ok = ok && mt_verify_multi_pre(mt, idx, m, j, p, root);
+          ok = ok && mt_verify_multi(mt, idx, m, j, p, root);
+
+          uint32_t singles = 0;
+          for (uint32_t l = 0; l < m; l++) {
+            MerkleTree_Low_path *q = mt_init_path(hash_size);
+            mt_get_path(mt, idx[l], q, r1);
+            singles += mt_get_path_length(q);
+            if (m == 1) {
+              ok = ok && mt_get_path_length(q) == mt_get_path_length(p);
+              for (uint32_t s = 0; ok && s < mt_get_path_length(p); s++)
+                ok = memcmp(mt_get_path_step(p, s), mt_get_path_step(q, s), hash_size) == 0;
+            }
+            mt_free_path(q);
+          }
+          ok = ok && mt_get_path_length(p) <= singles;
+
+          // Tampering with any hash of the multiproof, or the root, fails
+          uint32_t len = mt_get_path_length(p);
+          for (uint32_t s = 0; s < len; s += len / 5 + 1) {
+            uint8_t *step = mt_get_path_step(p, s);
+            uint8_t saved[32];
+            memcpy(saved, step, hash_size);
+            memcpy(h, step, hash_size);
+            h[s % hash_size] ^= 1;
+            p->hashes.vs[s] = h;
+            ok = ok && !mt_verify_multi(mt, idx, m, j, p, root);
+            p->hashes.vs[s] = step;
+            ok = ok && memcmp(saved, step, hash_size) == 0;
+          }
+          root[0] ^= 1;
+          ok = ok && !mt_verify_multi(mt, idx, m, j, p, root);
+          // A truncated multiproof is rejected rather than read past its end
+          p->hashes.sz--;
+          root[0] ^= 1;
+          ok = ok && (p->hashes.sz < m || !mt_verify_multi(mt, idx, m, j, p, root));
+          p->hashes.sz++;
+
+          // Invalid indices are rejected without relying on the _pre checks
+          MerkleTree_Low_path *e = mt_init_path(hash_size);
+          ok = ok && !mt_verify_multi(mt, idx, 0, j, p, root);
+          ok = ok && mt_get_paths(mt, idx, 0, e, r1) == 0;
+          ok = ok && !mt_verify_multi(mt, idx, m, idx[m - 1], p, root);
+          uint64_t last = idx[m - 1];
+          idx[m - 1] = n;
+          ok = ok && mt_get_paths(mt, idx, m, e, r1) == 0;
+          idx[m - 1] = last;
+          if (m > 1) {
+            idx[0] = idx[1];
+            ok = ok && !mt_verify_multi(mt, idx, m, j, p, root);
+            ok = ok && mt_get_paths(mt, idx, m, e, r1) == 0;
+          }
+          if (from > 0) {
+            idx[0] = from - 1;
+            ok = ok && mt_get_paths(mt, idx, m, e, r1) == 0;
+          }
+          ok = ok && mt_get_path_length(e) == 0;
+          mt_free_path(e);
+          mt_free_path(p);
+        }
+      }
+      mt_free(mt);
+    }
+  }
+  printf("Multiproofs: %s\n", ok ? "Success!" : "**FAILED**");
+  return ok;
+}
+
+void bench_multiproof() {
+  const uint32_t n = 1 << 20;
+  const uint32_t m = 1000;
+  uint8_t h[32], root[32];
+  uint64_t *idx = malloc(sizeof(uint64_t) * m);
+  clock_t t1, t2;
+  uint8_t *leaves = malloc((size_t)hash_size * n);
+  for (uint32_t i = 0; i < n; i++)
+    fill_hash(leaves + hash_size * i, i + 1);
+  fill_hash(h, 0);
+  mt_p mt = mt_create_arena(h);
+  mt_insert_batch(mt, leaves, n - 1);
+  free(leaves);
+  // A contiguous audit range
+  for (uint32_t l = 0; l < m; l++)
+    idx[l] = 300000 + l;
+  bool ok = true;
+
+  uint32_t len1 = 0;
+  t1 = clock();
+  for (uint32_t l = 0; l < m; l++) {
+    MerkleTree_Low_path *q = mt_init_path(hash_size);
+    uint32_t j = mt_get_path(mt, idx[l], q, root);
+    ok = ok && mt_verify(mt, idx[l], j, q, root);
+    len1 += mt_get_path_length(q);
+    mt_free_path(q);
+  }
+  t2 = clock();
+  printf("%" PRIu32 " paths with mt_get_path/mt_verify: %" PRIu32 " hashes, %.2f ms\n", m, len1,
+         (double)(t2 - t1) * 1000.0 / CLOCKS_PER_SEC);
+
+  t1 = clock();
+  MerkleTree_Low_path *p = mt_init_path(hash_size);
+  uint32_t j = mt_get_paths(mt, idx, m, p, root);
+  ok = ok && mt_verify_multi(mt, idx, m, j, p, root);
+  uint32_t len2 = mt_get_path_length(p);
+  mt_free_path(p);
+  t2 = clock();
+  printf("%" PRIu32 " paths with mt_get_paths/mt_verify_multi: %" PRIu32 " hashes, %.2f ms%s\n", m, len2,
+         (double)(t2 - t1) * 1000.0 / CLOCKS_PER_SEC, ok ? "" : " **FAILED**");
+  mt_free(mt);
+  free(idx);
+}
+
+// The default node hash must agree with the agile EverCrypt_Hash path it
+// short-circuits: one SHA2-256 block from the initial hash, no padding
+bool test_sha256_compress() {
+  uint8_t src1[32], src2[32], dst[32], expected[32], block[64];
+  bool ok = true;
+  for (uint64_t i = 0; i < 64; i++) {
+    fill_hash(src1, 2 * i);
+    fill_hash(src2, 2 * i + 1);
+    memcpy(block, src1, 32);
+    memcpy(block + 32, src2, 32);
+    EverCrypt_Hash_state_s *st = EverCrypt_Hash_create(Spec_Hash_Definitions_SHA2_256);
+    EverCrypt_Hash_init(st);
+    EverCrypt_Hash_update2(st, 0, block);
+    EverCrypt_Hash_finish(st, expected);
+    EverCrypt_Hash_free(st);
+    mt_sha256_compress(src1, src2, dst);
+    ok &= memcmp(dst, expected, 32) == 0;
+    // The destination may be one of the children, as in mt_insert
+    mt_sha256_compress(src1, src2, src1);
+    ok &= memcmp(src1, expected, 32) == 0;
+  }
+  printf("mt_sha256_compress: %s\n", ok ? "Success!" : "**FAILED**");
+  return ok;
+}
+
+void bench_insert_batch() {
+  const uint32_t block = 10000;
+  const uint32_t blocks = 20;
+  uint8_t *leaves = malloc(block * hash_size);
+  uint8_t h[32];
+  clock_t t1, t2;
+  for (uint32_t i = 0; i < block; i++)
+    fill_hash(leaves + hash_size * i, i);
+
+  fill_hash(h, 0);
+  mt_p mt = mt_create_arena(h);
+  t1 = clock();
+  for (uint32_t b = 0; b < blocks; b++)
+    for (uint32_t i = 0; i < block; i++) {
+      memcpy(h, leaves + hash_size * i, hash_size);
+      mt_insert(mt, h);
+    }
+  t2 = clock();
+  mt_free(mt);
+  printf("mt_insert, %d blocks of %d leaves: %.2f ms\n", blocks, block,
+         (double)(t2 - t1) * 1000.0 / CLOCKS_PER_SEC);
+
+  fill_hash(h, 0);
+  mt = mt_create_arena(h);
+  t1 = clock();
+  for (uint32_t b = 0; b < blocks; b++)
+    mt_insert_batch(mt, leaves, block);
+  t2 = clock();
+  mt_free(mt);
+  printf("mt_insert_batch, %d blocks of %d leaves: %.2f ms\n", blocks, block,
+         (double)(t2 - t1) * 1000.0 / CLOCKS_PER_SEC);
+  free(leaves);
+}
+
+static mt_p bench_build(mt_p mt, uint64_t n) {
+  uint8_t h[32];
+  for (uint64_t i = 1; i < n; i++) {
+    fill_hash(h, i);
+    mt_insert(mt, h);
+  }
+  return mt;
+}
+
+void bench_arena() {
+  const uint64_t n = 1 << 18;
+  uint8_t h[32];
+  clock_t t1, t2;
+
+  fill_hash(h, 0);
+  t1 = clock();
+  mt_p mt = bench_build(mt_create(h), n);
+  mt_flush_to(mt, n - 1);
+  mt_free(mt);
+  t2 = clock();
+  printf("Build+flush %" PRIu64 " leaves (per-hash allocation): %.2f ms\n", n,
+         (double)(t2 - t1) * 1000.0 / CLOCKS_PER_SEC);
+
+  fill_hash(h, 0);
+  t1 = clock();
+  mt = bench_build(mt_create_arena(h), n);
+  mt_flush_to(mt, n - 1);
+  mt_free(mt);
+  t2 = clock();
+  printf("Build+flush %" PRIu64 " leaves (arena): %.2f ms\n", n,
+         (double)(t2 - t1) * 1000.0 / CLOCKS_PER_SEC);
+}
+
 int main(int argc, char *argv[]) {
 
   uint64_t num_elts = 1;
@@ -209,5 +738,26 @@ int main(int argc, char *argv[]) {
 
   printf("The Merkle tree is freed\n");
 
+  if (!test_arena())
+    return 1;
+  bench_arena();
+
+  if (!test_sha256_compress() || !test_insert_batch())
+    return 1;
+  bench_insert_batch();
+  // Without SHA-NI, the new nodes of a level go through the vector lanes
+  EverCrypt_AutoConfig2_disable_shaext();
+  if (!test_sha256_compress() || !test_insert_batch())
+    return 1;
+  bench_insert_batch();
+
+  if (!test_mmap())
+    return 1;
+  bench_mmap();
+
+  if (!test_multiproof())
+    return 1;
+  bench_multiproof();
+
   return 0;
 }
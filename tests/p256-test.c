@@ -103,6 +103,38 @@ bool testImplementationHacl()
 	return s0 && s1 && flag;
 }
 
+// Sign/verify round trips over many keys and nonces: exercises the wNAF
+// double-scalar multiplication of verification on varied u1, u2
+bool testSignVerify()
+{
+	uint8_t sk[32];
+	uint8_t k[32];
+	uint8_t msg[32];
+	uint8_t pk[64];
+	uint8_t sig[64];
+	bool ok = true;
+
+	for (int i = 0; i < 64; i++)
+	{
+		for (int j = 0; j < 32; j++)
+		{
+			sk[j] = (uint8_t) (i * 37 + j * 11 + 1);
+			k[j] = (uint8_t) (i * 91 + j * 7 + 3);
+			msg[j] = (uint8_t) (i ^ (j * 5));
+		}
+		ok = ok && Hacl_P256_ecp256dh_i(pk, sk);
+		ok = ok && Hacl_P256_ecdsa_sign_p256_without_hash(sig, 32, msg, sk, k);
+		ok = ok && Hacl_P256_ecdsa_verif_without_hash(32, msg, pk, sig, sig + 32);
+		msg[i % 32] ^= 1;
+		ok = ok && !Hacl_P256_ecdsa_verif_without_hash(32, msg, pk, sig, sig + 32);
+		msg[i % 32] ^= 1;
+		sig[i % 64] ^= 0x10;
+		ok = ok && !Hacl_P256_ecdsa_verif_without_hash(32, msg, pk, sig, sig + 32);
+	}
+	printf("ECDSA sign/verify round trips: %s\n", ok ? "Success!" : "**FAILED**");
+	return ok;
+}
+
 void handleErrors()
 {
 	printf("%s\n", "OpenSSl exception");
@@ -116,6 +148,9 @@ int main()
 		return -1;
 	}
 
+	if (!testSignVerify())
+		return -1;
+
 
   	cycles a,b;
 	clock_t t1,t2;
@@ -166,6 +201,22 @@ int main()
 	clock_t tdiff3 = t2 - t1;
 	cycles cdiff3 = b - a;
 
+	uint8_t sig[64];
+	uint8_t vpk[64];
+	Hacl_P256_ecp256dh_i(vpk, prKey);
+	Hacl_P256_ecdsa_sign_p256_without_hash(sig, 32, digest, prKey, nonce);
+
+	t1 = clock();
+	a = cpucycles_begin();
+
+	for (int j = 0; j < ROUNDS; j++)
+		res ^= Hacl_P256_ecdsa_verif_without_hash(32, digest, vpk, sig, sig + 32);
+
+	b = cpucycles_end();
+	t2 = clock();
+	clock_t tdiff4 = t2 - t1;
+	cycles cdiff4 = b - a;
+
 
 	
 	uint64_t count = ROUNDS * SIZE;
@@ -174,4 +225,7 @@ int main()
 
 	printf("Hacl ECDH PERF: %d\n"); 
 	print_time(count,tdiff3,cdiff3);  
+
+	printf("Hacl ECDSA verification (without hashing) PERF:\n");
+	print_time(count,tdiff4,cdiff4);
 }
@@ -9,7 +9,11 @@
 #include <stdbool.h>
 #include <time.h>
 
+#include <openssl/bn.h>
+#include <openssl/rsa.h>
+
 #include "Hacl_RSAPSS.h"
+#include "EverCrypt_AutoConfig2.h"
 
 #include "test_helpers.h"
 #include "rsapss_vectors.h"
@@ -47,17 +51,333 @@ bool print_test(
   bool ver = Hacl_RSAPSS_rsapss_verify(Spec_Hash_Definitions_SHA2_256, modBits, eBits, pkey, saltLen, nbLen, sgnt, msgLen, msg);
   if (ver) printf("Success!\n");
   ok = ok && ver;
+
+  uint8_t sgnt_ctx[nbLen];
+  Hacl_RSAPSS_skey_ctx *sctx = Hacl_RSAPSS_new_rsapss_load_skey_ctx(modBits, eBits, dBits, nb, eb, db);
+  Hacl_RSAPSS_pkey_ctx *pctx = Hacl_RSAPSS_new_rsapss_load_pkey_ctx(modBits, eBits, nb, eb);
+  bool ok_ctx = sctx != NULL && pctx != NULL;
+  ok_ctx = ok_ctx && Hacl_RSAPSS_rsapss_sign_ctx(Spec_Hash_Definitions_SHA2_256, sctx, saltLen, salt, msgLen, msg, sgnt_ctx);
+  ok_ctx = ok_ctx && memcmp(sgnt_ctx, sgnt_expected, nbLen) == 0;
+  ok_ctx = ok_ctx && Hacl_RSAPSS_rsapss_verify_ctx(Spec_Hash_Definitions_SHA2_256, pctx, saltLen, nbLen, sgnt_ctx, msgLen, msg);
+  ok_ctx = ok_ctx && Hacl_RSAPSS_rsapss_verify_ctx(Spec_Hash_Definitions_SHA2_256, &sctx->pkey, saltLen, nbLen, sgnt_ctx, msgLen, msg);
+  printf("RSAPSS sign_ctx/verify_ctx: %s\n", ok_ctx ? "Success!" : "**FAILED**");
+  Hacl_RSAPSS_skey_ctx_free(sctx);
+  Hacl_RSAPSS_pkey_ctx_free(pctx);
+  Hacl_RSAPSS_skey_ctx_free(NULL);
+  Hacl_RSAPSS_pkey_ctx_free(NULL);
+  free(pkey);
+  free(skey);
+  return ok && ok_ctx;
+}
+
+
+#define ROUNDS 20
+
+// Sign with a fresh OpenSSL key through both the (n, e, d) and the CRT private
+// key formats: PSS with a fixed salt is deterministic, so the outputs must match
+bool test_crt(uint32_t modBits) {
+  uint32_t pBits = modBits / 2;
+  uint32_t nbLen = (modBits - 1) / 8 + 1;
+  uint32_t pbLen = (pBits - 1) / 8 + 1;
+  uint8_t nb[nbLen], db[nbLen], eb[3], pb[pbLen], qb[pbLen], dpb[pbLen], dqb[pbLen], qinvb[pbLen];
+  uint8_t sgnt[nbLen], sgnt_crt[nbLen];
+  uint8_t salt[20], msg[100];
+  memset(salt, 0x5a, 20);
+  memset(msg, 0xa5, 100);
+
+  RSA *rsa = RSA_new();
+  BIGNUM *f4 = BN_new();
+  BN_set_word(f4, RSA_F4);
+  RSA_generate_key_ex(rsa, modBits, f4, NULL);
+  const BIGNUM *n, *e, *d, *p, *q, *dp, *dq, *qinv;
+  RSA_get0_key(rsa, &n, &e, &d);
+  RSA_get0_factors(rsa, &p, &q);
+  RSA_get0_crt_params(rsa, &dp, &dq, &qinv);
+  BN_bn2binpad(n, nb, nbLen);
+  BN_bn2binpad(e, eb, 3);
+  BN_bn2binpad(d, db, nbLen);
+  BN_bn2binpad(p, pb, pbLen);
+  BN_bn2binpad(q, qb, pbLen);
+  BN_bn2binpad(dp, dpb, pbLen);
+  BN_bn2binpad(dq, dqb, pbLen);
+  BN_bn2binpad(qinv, qinvb, pbLen);
+  RSA_free(rsa);
+  BN_free(f4);
+
+  uint64_t *pkey = Hacl_RSAPSS_new_rsapss_load_pkey(modBits, 17, nb, eb);
+  uint64_t *skey = Hacl_RSAPSS_new_rsapss_load_skey(modBits, 17, modBits, nb, eb, db);
+  uint64_t *skey_crt =
+    Hacl_RSAPSS_new_rsapss_load_skey_crt(modBits, 17, pBits, nb, eb, pb, qb, dpb, dqb, qinvb);
+  bool ok = pkey != NULL && skey != NULL && skey_crt != NULL;
+  if (!ok) {
+    printf("RSAPSS-%u CRT key loading: **FAILED**\n", modBits);
+    return false;
+  }
+
+  ok &= Hacl_RSAPSS_rsapss_sign(Spec_Hash_Definitions_SHA2_256, modBits, 17, modBits, skey, 20, salt, 100, msg, sgnt);
+  ok &= Hacl_RSAPSS_rsapss_sign_crt(Spec_Hash_Definitions_SHA2_256, modBits, 17, pBits, skey_crt, 20, salt, 100, msg, sgnt_crt);
+  ok &= memcmp(sgnt, sgnt_crt, nbLen) == 0;
+  ok &= Hacl_RSAPSS_rsapss_verify(Spec_Hash_Definitions_SHA2_256, modBits, 17, pkey, 20, nbLen, sgnt_crt, 100, msg);
+  ok &= Hacl_RSAPSS_rsapss_skey_sign_crt(Spec_Hash_Definitions_SHA2_256, modBits, 17, pBits, nb, eb, pb, qb, dpb, dqb, qinvb, 20, salt, 100, msg, sgnt_crt);
+  ok &= memcmp(sgnt, sgnt_crt, nbLen) == 0;
+
+  // A faulty half-exponentiation must be caught by the verify-after-sign check
+  uint32_t nLen = (modBits - 1) / 64 + 1;
+  uint32_t pLen = (pBits - 1) / 64 + 1;
+  uint64_t *dp_limbs = skey_crt + 2 * nLen + 1 + 4 * pLen;
+  dp_limbs[0] ^= 2;
+  ok &= !Hacl_RSAPSS_rsapss_sign_crt(Spec_Hash_Definitions_SHA2_256, modBits, 17, pBits, skey_crt, 20, salt, 100, msg, sgnt_crt);
+  dp_limbs[0] ^= 2;
+
+  // Inconsistent keys are rejected
+  qb[pbLen - 1] ^= 2;
+  ok &= Hacl_RSAPSS_new_rsapss_load_skey_crt(modBits, 17, pBits, nb, eb, pb, qb, dpb, dqb, qinvb) == NULL;
+  qb[pbLen - 1] ^= 2;
+
+  printf("RSAPSS-%u CRT sign: %s\n", modBits, ok ? "Success!" : "**FAILED**");
+
+  cycles a, b;
+  clock_t t1, t2;
+  t1 = clock();
+  a = cpucycles_begin();
+  for (int j = 0; j < ROUNDS; j++)
+    Hacl_RSAPSS_rsapss_sign(Spec_Hash_Definitions_SHA2_256, modBits, 17, modBits, skey, 20, salt, 100, msg, sgnt);
+  b = cpucycles_end();
+  t2 = clock();
+  printf("RSAPSS-%u sign: %" PRIu64 " cycles, %.2f us per signature\n", modBits,
+         (uint64_t)(b - a) / ROUNDS, (double)(t2 - t1) * 1000000.0 / CLOCKS_PER_SEC / ROUNDS);
+  t1 = clock();
+  a = cpucycles_begin();
+  for (int j = 0; j < ROUNDS; j++)
+    Hacl_RSAPSS_rsapss_sign_crt(Spec_Hash_Definitions_SHA2_256, modBits, 17, pBits, skey_crt, 20, salt, 100, msg, sgnt);
+  b = cpucycles_end();
+  t2 = clock();
+  printf("RSAPSS-%u sign_crt: %" PRIu64 " cycles, %.2f us per signature\n", modBits,
+         (uint64_t)(b - a) / ROUNDS, (double)(t2 - t1) * 1000000.0 / CLOCKS_PER_SEC / ROUNDS);
+
+  free(pkey);
+  free(skey);
+  free(skey_crt);
   return ok;
 }
 
+#define VERIFY_ROUNDS 2000
+
+// Verification through a cached public-key context, for e = 3 and e = 65537
+bool test_ctx(uint32_t modBits, unsigned long e_word, uint32_t eBits) {
+  uint32_t nbLen = (modBits - 1) / 8 + 1;
+  uint32_t ebLen = (eBits - 1) / 8 + 1;
+  uint8_t nb[nbLen], db[nbLen], eb[ebLen];
+  uint8_t sgnt[nbLen];
+  uint8_t salt[20], msg[100];
+  memset(salt, 0x3c, 20);
+  memset(msg, 0xc3, 100);
+
+  RSA *rsa = RSA_new();
+  BIGNUM *bn_e = BN_new();
+  BN_set_word(bn_e, e_word);
+  RSA_generate_key_ex(rsa, modBits, bn_e, NULL);
+  const BIGNUM *n, *e, *d;
+  RSA_get0_key(rsa, &n, &e, &d);
+  BN_bn2binpad(n, nb, nbLen);
+  BN_bn2binpad(e, eb, ebLen);
+  BN_bn2binpad(d, db, nbLen);
+  RSA_free(rsa);
+  BN_free(bn_e);
+
+  uint64_t *pkey = Hacl_RSAPSS_new_rsapss_load_pkey(modBits, eBits, nb, eb);
+  Hacl_RSAPSS_pkey_ctx *pctx = Hacl_RSAPSS_new_rsapss_load_pkey_ctx(modBits, eBits, nb, eb);
+  Hacl_RSAPSS_skey_ctx *sctx = Hacl_RSAPSS_new_rsapss_load_skey_ctx(modBits, eBits, modBits, nb, eb, db);
+  bool ok = pkey != NULL && pctx != NULL && sctx != NULL;
+  if (!ok) {
+    printf("RSAPSS-%u ctx key loading: **FAILED**\n", modBits);
+    return false;
+  }
+
+  ok &= Hacl_RSAPSS_rsapss_sign_ctx(Spec_Hash_Definitions_SHA2_256, sctx, 20, salt, 100, msg, sgnt);
+  ok &= Hacl_RSAPSS_rsapss_verify(Spec_Hash_Definitions_SHA2_256, modBits, eBits, pkey, 20, nbLen, sgnt, 100, msg);
+  ok &= Hacl_RSAPSS_rsapss_verify_ctx(Spec_Hash_Definitions_SHA2_256, pctx, 20, nbLen, sgnt, 100, msg);
+  msg[7] ^= 1;
+  ok &= !Hacl_RSAPSS_rsapss_verify_ctx(Spec_Hash_Definitions_SHA2_256, pctx, 20, nbLen, sgnt, 100, msg);
+  msg[7] ^= 1;
+  sgnt[nbLen / 2] ^= 0x40;
+  ok &= !Hacl_RSAPSS_rsapss_verify_ctx(Spec_Hash_Definitions_SHA2_256, pctx, 20, nbLen, sgnt, 100, msg);
+  sgnt[nbLen / 2] ^= 0x40;
+  // A signature that is not reduced modulo n is rejected
+  uint8_t big[nbLen];
+  memset(big, 0xff, nbLen);
+  ok &= !Hacl_RSAPSS_rsapss_verify_ctx(Spec_Hash_Definitions_SHA2_256, pctx, 20, nbLen, big, 100, msg);
+  printf("RSAPSS-%u e=%lu verify_ctx: %s\n", modBits, e_word, ok ? "Success!" : "**FAILED**");
+
+  bool b = true;
+  cycles a, c;
+  clock_t t1, t2;
+  t1 = clock();
+  a = cpucycles_begin();
+  for (int j = 0; j < VERIFY_ROUNDS; j++)
+    b &= Hacl_RSAPSS_rsapss_pkey_verify(Spec_Hash_Definitions_SHA2_256, modBits, eBits, nb, eb, 20, nbLen, sgnt, 100, msg);
+  c = cpucycles_end();
+  t2 = clock();
+  printf("RSAPSS-%u pkey_verify: %" PRIu64 " cycles, %.2f us per signature\n", modBits,
+         (uint64_t)(c - a) / VERIFY_ROUNDS, (double)(t2 - t1) * 1000000.0 / CLOCKS_PER_SEC / VERIFY_ROUNDS);
+  t1 = clock();
+  a = cpucycles_begin();
+  for (int j = 0; j < VERIFY_ROUNDS; j++)
+    b &= Hacl_RSAPSS_rsapss_verify(Spec_Hash_Definitions_SHA2_256, modBits, eBits, pkey, 20, nbLen, sgnt, 100, msg);
+  c = cpucycles_end();
+  t2 = clock();
+  printf("RSAPSS-%u verify: %" PRIu64 " cycles, %.2f us per signature\n", modBits,
+         (uint64_t)(c - a) / VERIFY_ROUNDS, (double)(t2 - t1) * 1000000.0 / CLOCKS_PER_SEC / VERIFY_ROUNDS);
+  t1 = clock();
+  a = cpucycles_begin();
+  for (int j = 0; j < VERIFY_ROUNDS; j++)
+    b &= Hacl_RSAPSS_rsapss_verify_ctx(Spec_Hash_Definitions_SHA2_256, pctx, 20, nbLen, sgnt, 100, msg);
+  c = cpucycles_end();
+  t2 = clock();
+  printf("RSAPSS-%u verify_ctx: %" PRIu64 " cycles, %.2f us per signature\n", modBits,
+         (uint64_t)(c - a) / VERIFY_ROUNDS, (double)(t2 - t1) * 1000000.0 / CLOCKS_PER_SEC / VERIFY_ROUNDS);
+  if (!b) printf("**FAILED**\n");
+
+  free(pkey);
+  Hacl_RSAPSS_pkey_ctx_free(pctx);
+  Hacl_RSAPSS_skey_ctx_free(sctx);
+  return ok && b;
+}
+
+#define BATCH 16
+
+// Verify a batch mixing key sizes, public exponents and salt lengths, then
+// check that corrupted entries are singled out
+bool test_batch() {
+  uint32_t modBits[5] = { 2048, 2048, 2048, 3072, 2047 };
+  unsigned long e_words[5] = { RSA_F4, RSA_F4, 3, RSA_F4, RSA_F4 };
+  uint32_t eBits_k[5] = { 17, 24, 2, 17, 17 };
+  Hacl_RSAPSS_pkey_ctx *pctx[5];
+  Hacl_RSAPSS_skey_ctx *sctx[5];
+  bool ok = true;
+  for (int i = 0; i < 5; i++) {
+    uint32_t nbLen = (modBits[i] - 1) / 8 + 1;
+    uint32_t ebLen = (eBits_k[i] - 1) / 8 + 1;
+    uint8_t nb[nbLen], db[nbLen], eb[ebLen];
+    RSA *rsa = RSA_new();
+    BIGNUM *bn_e = BN_new();
+    BN_set_word(bn_e, e_words[i]);
+    RSA_generate_key_ex(rsa, modBits[i], bn_e, NULL);
+    const BIGNUM *n, *e, *d;
+    RSA_get0_key(rsa, &n, &e, &d);
+    BN_bn2binpad(n, nb, nbLen);
+    BN_bn2binpad(e, eb, ebLen);
+    BN_bn2binpad(d, db, nbLen);
+    RSA_free(rsa);
+    BN_free(bn_e);
+    pctx[i] = Hacl_RSAPSS_new_rsapss_load_pkey_ctx(modBits[i], eBits_k[i], nb, eb);
+    sctx[i] = Hacl_RSAPSS_new_rsapss_load_skey_ctx(modBits[i], eBits_k[i], modBits[i], nb, eb, db);
+    ok &= pctx[i] != NULL && sctx[i] != NULL;
+  }
+  if (!ok) {
+    printf("RSAPSS verify_batch key loading: **FAILED**\n");
+    return false;
+  }
+
+  Hacl_RSAPSS_pkey_ctx *ctx[BATCH];
+  uint32_t saltLen[BATCH], sgntLen[BATCH], msgLen[BATCH];
+  uint8_t *sgnt[BATCH], *msg[BATCH];
+  uint8_t salt[32];
+  bool res[BATCH];
+  memset(salt, 0x17, 32);
+  for (int i = 0; i < BATCH; i++) {
+    int key = i % 5;
+    ctx[i] = pctx[key];
+    saltLen[i] = (uint32_t)(i % 3) * 16;
+    sgntLen[i] = (modBits[key] - 1) / 8 + 1;
+    msgLen[i] = 40 + i;
+    msg[i] = malloc(msgLen[i]);
+    sgnt[i] = malloc(sgntLen[i]);
+    for (uint32_t j = 0; j < msgLen[i]; j++) msg[i][j] = (uint8_t)(i * 7 + j);
+    ok &= Hacl_RSAPSS_rsapss_sign_ctx(Spec_Hash_Definitions_SHA2_256, sctx[key], saltLen[i], salt, msgLen[i], msg[i], sgnt[i]);
+  }
+
+  bool all = Hacl_RSAPSS_rsapss_verify_batch(Spec_Hash_Definitions_SHA2_256, BATCH, ctx, saltLen, sgntLen, sgnt, msgLen, msg, res);
+  ok &= all;
+  for (int i = 0; i < BATCH; i++) ok &= res[i];
+
+  sgnt[2][5] ^= 1;
+  msg[9][0] ^= 1;
+  sgntLen[12] -= 1;
+  all = Hacl_RSAPSS_rsapss_verify_batch(Spec_Hash_Definitions_SHA2_256, BATCH, ctx, saltLen, sgntLen, sgnt, msgLen, msg, res);
+  ok &= !all;
+  for (int i = 0; i < BATCH; i++) ok &= res[i] == (i != 2 && i != 9 && i != 12);
+  sgnt[2][5] ^= 1;
+  msg[9][0] ^= 1;
+  sgntLen[12] += 1;
+
+  // The batch result must not depend on the batch size
+  for (uint32_t k = 0; k <= 6; k++) {
+    ok &= Hacl_RSAPSS_rsapss_verify_batch(Spec_Hash_Definitions_SHA2_256, k, ctx + 3, saltLen + 3, sgntLen + 3, sgnt + 3, msgLen + 3, msg + 3, res);
+  }
+  printf("RSAPSS verify_batch: %s\n", ok ? "Success!" : "**FAILED**");
+
+  // Throughput on a batch of RSA-2048, e = 65537 signatures
+  for (int i = 0; i < BATCH; i++) {
+    int key = i % 2;
+    ctx[i] = pctx[key];
+    sgntLen[i] = 256;
+    free(sgnt[i]);
+    sgnt[i] = malloc(256);
+    Hacl_RSAPSS_rsapss_sign_ctx(Spec_Hash_Definitions_SHA2_256, sctx[key], saltLen[i], salt, msgLen[i], msg[i], sgnt[i]);
+  }
+  bool b = true;
+  cycles a, c;
+  clock_t t1, t2;
+  t1 = clock();
+  a = cpucycles_begin();
+  for (int j = 0; j < VERIFY_ROUNDS / BATCH; j++)
+    for (int i = 0; i < BATCH; i++)
+      b &= Hacl_RSAPSS_rsapss_verify_ctx(Spec_Hash_Definitions_SHA2_256, ctx[i], saltLen[i], sgntLen[i], sgnt[i], msgLen[i], msg[i]);
+  c = cpucycles_end();
+  t2 = clock();
+  uint32_t total = VERIFY_ROUNDS / BATCH * BATCH;
+  printf("RSAPSS-2048 verify_ctx: %" PRIu64 " cycles, %.2f us per signature\n",
+         (uint64_t)(c - a) / total, (double)(t2 - t1) * 1000000.0 / CLOCKS_PER_SEC / total);
+  t1 = clock();
+  a = cpucycles_begin();
+  for (int j = 0; j < VERIFY_ROUNDS / BATCH; j++)
+    b &= Hacl_RSAPSS_rsapss_verify_batch(Spec_Hash_Definitions_SHA2_256, BATCH, ctx, saltLen, sgntLen, sgnt, msgLen, msg, res);
+  c = cpucycles_end();
+  t2 = clock();
+  printf("RSAPSS-2048 verify_batch: %" PRIu64 " cycles, %.2f us per signature\n",
+         (uint64_t)(c - a) / total, (double)(t2 - t1) * 1000000.0 / CLOCKS_PER_SEC / total);
+  if (!b) printf("**FAILED**\n");
+
+  for (int i = 0; i < BATCH; i++) {
+    free(msg[i]);
+    free(sgnt[i]);
+  }
+  for (int i = 0; i < 5; i++) {
+    Hacl_RSAPSS_pkey_ctx_free(pctx[i]);
+    Hacl_RSAPSS_skey_ctx_free(sctx[i]);
+  }
+  return ok && b;
+}
 
 int main() {
+  EverCrypt_AutoConfig2_init();
   bool ok = true;
   for (int i = 0; i < sizeof(vectors)/sizeof(rsapss_test_vector); ++i) {
     ok &= print_test(vectors[i].modBits,vectors[i].n,vectors[i].eBits,vectors[i].e,vectors[i].dBits,vectors[i].d,
 		     vectors[i].msgLen,vectors[i].msg,vectors[i].saltLen,vectors[i].salt,vectors[i].sgnt_expected);
   }
 
+  ok &= test_crt(2048);
+  ok &= test_crt(3072);
+  ok &= test_crt(4096);
+
+  ok &= test_ctx(2048, 3, 2);
+  ok &= test_ctx(2048, RSA_F4, 17);
+  ok &= test_ctx(4096, RSA_F4, 17);
+
+  ok &= test_batch();
+
   if (ok) return EXIT_SUCCESS;
   else return EXIT_FAILURE;
 }
@@ -0,0 +1,166 @@
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include <stdbool.h>
+#include "Hacl_Hash.h"
+#include "Hacl_SHA2_Vec256.h"
+#include "EverCrypt_AutoConfig2.h"
+#include "EverCrypt_Hash.h"
+
+#include "test_helpers.h"
+
+#define LANES 8
+#define MAX_LEN 300
+#define BATCH 64
+#define MSG_LEN 64
+#define ROUNDS 16384
+
+uint8_t msgs[LANES][MAX_LEN];
+
+// Every length up to MAX_LEN covers the one- and two-block padding cases
+// and the block boundaries; each lane holds a different message
+bool test_lanes(){
+  uint8_t digests[LANES][32];
+  uint8_t expected[32];
+  uint8_t *in[LANES];
+  uint8_t *out[LANES];
+  bool ok = true;
+  for (int j = 0; j < LANES; j++) {
+    for (int i = 0; i < MAX_LEN; i++) msgs[j][i] = (uint8_t)(j * 29 + i * 7 + (i >> 5));
+    in[j] = msgs[j];
+    out[j] = digests[j];
+  }
+  for (uint32_t len = 0; len <= MAX_LEN; len++) {
+    Hacl_SHA2_Vec256_sha256_8(out[0], out[1], out[2], out[3], out[4], out[5], out[6], out[7], len, in[0], in[1], in[2], in[3], in[4], in[5], in[6], in[7]);
+    for (int j = 0; j < LANES; j++) {
+      Hacl_Hash_SHA2_hash_256(in[j], len, expected);
+      ok &= memcmp(digests[j], expected, 32) == 0;
+    }
+  }
+  printf("SHA2-256 8-lane multi-buffer: %s\n", ok ? "Success!" : "**FAILED**");
+  return ok;
+}
+
+// Mixed lengths: runs of equal lengths are batched, the rest hashed one by one
+bool test_dispatch(){
+  static uint8_t buf[BATCH][MAX_LEN];
+  uint8_t digests[BATCH][32];
+  uint8_t expected[32];
+  uint8_t *in[BATCH];
+  uint8_t *out[BATCH];
+  uint32_t lens[BATCH];
+  bool ok = true;
+  for (int i = 0; i < BATCH; i++) {
+    for (int j = 0; j < MAX_LEN; j++) buf[i][j] = (uint8_t)(i ^ (j * 3));
+    in[i] = buf[i];
+    out[i] = digests[i];
+    lens[i] = i < 20 ? 64 : (i < 23 ? 55 : (uint32_t)(i * 5) % MAX_LEN);
+  }
+  EverCrypt_Hash_hash_256_mb(BATCH, in, lens, out);
+  for (int i = 0; i < BATCH; i++) {
+    Hacl_Hash_SHA2_hash_256(in[i], lens[i], expected);
+    ok &= memcmp(digests[i], expected, 32) == 0;
+  }
+  memset(digests, 0, sizeof digests);
+  Hacl_Hash_SHA2_256_mb(BATCH, in, lens, out);
+  for (int i = 0; i < BATCH; i++) {
+    Hacl_Hash_SHA2_hash_256(in[i], lens[i], expected);
+    ok &= memcmp(digests[i], expected, 32) == 0;
+  }
+  EverCrypt_Hash_hash_256_mb(0, in, lens, out);
+  Hacl_Hash_SHA2_256_mb(0, in, lens, out);
+  printf("SHA2-256 hash_256_mb: %s\n", ok ? "Success!" : "**FAILED**");
+  return ok;
+}
+
+// Single compressions of 64-byte blocks split in two halves, as for
+// Merkle tree nodes
+bool test_compress(){
+  uint8_t lo[8][32];
+  uint8_t hi[8][32];
+  uint8_t digests[8][32];
+  uint8_t expected[32];
+  uint8_t *src1[8];
+  uint8_t *src2[8];
+  uint8_t *dst[8];
+  bool ok = true;
+  for (int j = 0; j < 8; j++) {
+    for (int i = 0; i < 32; i++) {
+      lo[j][i] = (uint8_t)(j * 13 + i);
+      hi[j][i] = (uint8_t)(j ^ (i * 5));
+    }
+    src1[j] = lo[j];
+    src2[j] = hi[j];
+    dst[j] = digests[j];
+  }
+  Hacl_SHA2_Vec256_sha256_compress8(dst, src1, src2);
+  for (int j = 0; j < 8; j++) {
+    uint8_t block[64];
+    uint32_t st[8];
+    memcpy(block, lo[j], 32);
+    memcpy(block + 32, hi[j], 32);
+    Hacl_Hash_Core_SHA2_init_256(st);
+    Hacl_Hash_SHA2_update_multi_256(st, block, 1);
+    Hacl_Hash_Core_SHA2_finish_256(st, expected);
+    ok &= memcmp(digests[j], expected, 32) == 0;
+  }
+  printf("SHA2-256 8-lane compression: %s\n", ok ? "Success!" : "**FAILED**");
+  return ok;
+}
+
+int main(){
+  EverCrypt_AutoConfig2_init();
+  bool ok = test_lanes();
+  ok &= test_compress();
+  ok &= test_dispatch();
+  // Without SHA-NI, equal-length runs go through the vector lanes
+  EverCrypt_AutoConfig2_disable_shaext();
+  ok &= test_dispatch();
+
+  uint8_t plain[LANES][MSG_LEN];
+  uint8_t digests[LANES][32];
+  uint8_t *in[LANES];
+  uint8_t *out[LANES];
+  cycles a,b;
+  clock_t t1,t2;
+  for (int j = 0; j < LANES; j++) {
+    memset(plain[j], 'P' + j, MSG_LEN);
+    in[j] = plain[j];
+    out[j] = digests[j];
+  }
+
+  // Short independent messages, as in Merkle tree and content-addressing workloads
+  t1 = clock();
+  a = cpucycles_begin();
+  for (int r = 0; r < ROUNDS; r++) {
+    for (int j = 0; j < LANES; j++)
+      Hacl_Hash_SHA2_hash_256(in[j], MSG_LEN, out[j]);
+  }
+  b = cpucycles_end();
+  t2 = clock();
+  double cdiff1 = b - a;
+  double tdiff1 = t2 - t1;
+
+  t1 = clock();
+  a = cpucycles_begin();
+  for (int r = 0; r < ROUNDS; r++) {
+    Hacl_SHA2_Vec256_sha256_8(out[0], out[1], out[2], out[3], out[4], out[5], out[6], out[7], MSG_LEN, in[0], in[1], in[2], in[3], in[4], in[5], in[6], in[7]);
+  }
+  b = cpucycles_end();
+  t2 = clock();
+  double cdiff2 = b - a;
+  double tdiff2 = t2 - t1;
+
+  uint64_t count = (uint64_t)ROUNDS * LANES * MSG_LEN;
+  printf("SHA2-256 (32-bit) on %d-byte messages PERF: %d\n", MSG_LEN, (int)digests[0][0]); print_time(count,tdiff1,cdiff1);
+  printf("SHA2-256 (8-lane multi-buffer) on %d-byte messages PERF: %d\n", MSG_LEN, (int)digests[0][0]); print_time(count,tdiff2,cdiff2);
+
+  if (ok) return EXIT_SUCCESS;
+  else return EXIT_FAILURE;
+}
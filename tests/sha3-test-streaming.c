@@ -0,0 +1,140 @@
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include "Hacl_SHA3.h"
+#include "Hacl_Streaming_SHA3.h"
+#include "EverCrypt_Hash.h"
+
+#include "test_helpers.h"
+
+#define MSG_LEN 1000
+#define XOF_LEN 600
+
+static uint8_t msg[MSG_LEN];
+
+static uint8_t sha3_256_abc[32] = {
+  0x3a, 0x98, 0x5d, 0xa7, 0x4f, 0xe2, 0x25, 0xb2, 0x04, 0x5c, 0x17, 0x2d, 0x6b, 0xd3, 0x90, 0xbd,
+  0x85, 0x5f, 0x08, 0x6e, 0x3e, 0x9d, 0x52, 0x5b, 0x46, 0xbf, 0xe2, 0x45, 0x11, 0x43, 0x15, 0x32
+};
+
+static uint8_t shake128_empty[16] = {
+  0x7f, 0x9c, 0x2b, 0xa4, 0xe8, 0x8f, 0x82, 0x7d, 0x61, 0x60, 0x45, 0x50, 0x76, 0x05, 0x85, 0x3e
+};
+
+static void oneshot(Spec_Hash_Definitions_hash_alg a, uint32_t len, uint8_t *input, uint32_t out_len, uint8_t *out) {
+  switch (a) {
+    case Spec_Hash_Definitions_SHA3_224: Hacl_SHA3_sha3_224(len, input, out); break;
+    case Spec_Hash_Definitions_SHA3_256: Hacl_SHA3_sha3_256(len, input, out); break;
+    case Spec_Hash_Definitions_SHA3_384: Hacl_SHA3_sha3_384(len, input, out); break;
+    case Spec_Hash_Definitions_SHA3_512: Hacl_SHA3_sha3_512(len, input, out); break;
+    case Spec_Hash_Definitions_Shake128: Hacl_SHA3_shake128_hacl(len, input, out_len, out); break;
+    case Spec_Hash_Definitions_Shake256: Hacl_SHA3_shake256_hacl(len, input, out_len, out); break;
+    default: break;
+  }
+}
+
+// Feed the message in chunks of `step` bytes and compare against the one-shot API
+static bool test_chunked(Spec_Hash_Definitions_hash_alg a, uint32_t out_len, uint32_t step) {
+  uint8_t expected[XOF_LEN];
+  uint8_t computed[XOF_LEN];
+  bool shake = a == Spec_Hash_Definitions_Shake128 || a == Spec_Hash_Definitions_Shake256;
+  bool ok = true;
+  Hacl_Streaming_SHA3_state_sha3 *s = Hacl_Streaming_SHA3_create_in(a);
+  for (uint32_t len = 0; len <= MSG_LEN; len += 97) {
+    Hacl_Streaming_SHA3_init(s);
+    Hacl_Streaming_SHA3_update(s, NULL, 0);
+    for (uint32_t i = 0; i < len; i += step)
+      ok &= Hacl_Streaming_SHA3_update(s, msg + i, len - i < step ? len - i : step);
+    oneshot(a, len, msg, out_len, expected);
+    if (shake) {
+      // Squeeze in uneven pieces to cross rate boundaries
+      uint32_t off = 0;
+      while (off < out_len) {
+        uint32_t n = out_len - off < 61 ? out_len - off : 61;
+        ok &= Hacl_Streaming_SHA3_squeeze(s, computed + off, n);
+        off += n;
+      }
+      ok &= !Hacl_Streaming_SHA3_update(s, msg, 1);
+      ok &= !Hacl_Streaming_SHA3_finish(s, computed);
+    } else {
+      ok &= Hacl_Streaming_SHA3_finish(s, computed);
+      // finish leaves the state untouched: more input can follow
+      ok &= Hacl_Streaming_SHA3_finish(s, computed);
+      ok &= !Hacl_Streaming_SHA3_squeeze(s, computed, 1);
+    }
+    ok &= memcmp(computed, expected, out_len) == 0;
+  }
+  Hacl_Streaming_SHA3_free(s);
+  return ok;
+}
+
+static bool test_evercrypt(Spec_Hash_Definitions_hash_alg a, uint32_t out_len) {
+  uint8_t expected[64];
+  uint8_t computed[64];
+  uint8_t oneshot_ev[64];
+  bool ok = true;
+  Hacl_Streaming_Functor_state_s___EverCrypt_Hash_state_s____ *s =
+    EverCrypt_Hash_Incremental_create_in(a);
+  for (uint32_t len = 0; len <= MSG_LEN; len += 131) {
+    EverCrypt_Hash_Incremental_init(s);
+    for (uint32_t i = 0; i < len; i += 37)
+      EverCrypt_Hash_Incremental_update(s, msg + i, len - i < 37 ? len - i : 37);
+    EverCrypt_Hash_Incremental_finish(s, computed);
+    oneshot(a, len, msg, out_len, expected);
+    EverCrypt_Hash_hash(a, oneshot_ev, msg, len);
+    ok &= memcmp(computed, expected, out_len) == 0;
+    ok &= memcmp(oneshot_ev, expected, out_len) == 0;
+  }
+  ok &= EverCrypt_Hash_Incremental_alg_of_state(s) == a;
+  ok &= Hacl_Hash_Definitions_hash_len(a) == out_len;
+  ok &= Hacl_Hash_Definitions_block_len(a) == 200 - 2 * out_len;
+  ok &= Hacl_Hash_Definitions_word_len(a) == 8;
+  EverCrypt_Hash_Incremental_free(s);
+  return ok;
+}
+
+int main() {
+  bool ok = true;
+  for (int i = 0; i < MSG_LEN; i++) msg[i] = (uint8_t)(i * 7 + 3);
+
+  uint8_t tag[32];
+  Hacl_Streaming_SHA3_state_sha3 *s = Hacl_Streaming_SHA3_create_in(Spec_Hash_Definitions_SHA3_256);
+  Hacl_Streaming_SHA3_update(s, (uint8_t *)"a", 1);
+  Hacl_Streaming_SHA3_update(s, (uint8_t *)"bc", 2);
+  Hacl_Streaming_SHA3_finish(s, tag);
+  ok &= compare_and_print(32, tag, sha3_256_abc);
+  Hacl_Streaming_SHA3_free(s);
+
+  s = Hacl_Streaming_SHA3_create_in(Spec_Hash_Definitions_Shake128);
+  Hacl_Streaming_SHA3_squeeze(s, tag, 16);
+  ok &= compare_and_print(16, tag, shake128_empty);
+  Hacl_Streaming_SHA3_free(s);
+
+  ok &= Hacl_Streaming_SHA3_create_in(Spec_Hash_Definitions_SHA2_256) == NULL;
+
+  uint32_t steps[4] = { 1, 17, 136, 500 };
+  for (int i = 0; i < 4; i++) {
+    ok &= test_chunked(Spec_Hash_Definitions_SHA3_224, 28, steps[i]);
+    ok &= test_chunked(Spec_Hash_Definitions_SHA3_256, 32, steps[i]);
+    ok &= test_chunked(Spec_Hash_Definitions_SHA3_384, 48, steps[i]);
+    ok &= test_chunked(Spec_Hash_Definitions_SHA3_512, 64, steps[i]);
+    ok &= test_chunked(Spec_Hash_Definitions_Shake128, XOF_LEN, steps[i]);
+    ok &= test_chunked(Spec_Hash_Definitions_Shake256, XOF_LEN, steps[i]);
+  }
+  printf("SHA3/SHAKE streaming vs one-shot: %s\n", ok ? "Success!" : "**FAILED**");
+
+  bool ok1 = true;
+  ok1 &= test_evercrypt(Spec_Hash_Definitions_SHA3_224, 28);
+  ok1 &= test_evercrypt(Spec_Hash_Definitions_SHA3_256, 32);
+  ok1 &= test_evercrypt(Spec_Hash_Definitions_SHA3_384, 48);
+  ok1 &= test_evercrypt(Spec_Hash_Definitions_SHA3_512, 64);
+  printf("EverCrypt_Hash SHA3: %s\n", ok1 ? "Success!" : "**FAILED**");
+
+  if (ok && ok1)
+    return EXIT_SUCCESS;
+  else
+    return EXIT_FAILURE;
+}
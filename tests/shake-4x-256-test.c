@@ -0,0 +1,93 @@
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <stdbool.h>
+
+#include "Hacl_SHA3.h"
+#include "Hacl_SHA3_Vec256.h"
+#include "EverCrypt_AutoConfig2.h"
+
+#include "test_helpers.h"
+
+#define MAX_IN 400
+#define MAX_OUT 700
+#define ROUNDS 4096
+#define OUT_LEN 2688
+
+uint8_t in[4][MAX_IN];
+uint8_t out[4][MAX_OUT];
+uint8_t expected[MAX_OUT];
+
+// Input and output lengths straddle the SHAKE128 (168) and SHAKE256 (136) rates
+bool test_lengths(){
+  uint32_t in_lens[] = { 0, 1, 18, 135, 136, 137, 167, 168, 169, 300, 400 };
+  uint32_t out_lens[] = { 0, 1, 32, 136, 168, 300, 336, 700 };
+  bool ok = true;
+  for (int j = 0; j < 4; j++)
+    for (int i = 0; i < MAX_IN; i++) in[j][i] = (uint8_t)(j * 101 + i * 13 + (i >> 4));
+  for (int a = 0; a < sizeof(in_lens)/sizeof(uint32_t); a++) {
+    for (int b = 0; b < sizeof(out_lens)/sizeof(uint32_t); b++) {
+      uint32_t il = in_lens[a];
+      uint32_t ol = out_lens[b];
+      Hacl_SHA3_Vec256_shake128_vec256(il, in[0], in[1], in[2], in[3], ol, out[0], out[1], out[2], out[3]);
+      for (int j = 0; j < 4; j++) {
+        Hacl_SHA3_shake128_hacl(il, in[j], ol, expected);
+        ok &= memcmp(out[j], expected, ol) == 0;
+      }
+      Hacl_SHA3_Vec256_shake256_vec256(il, in[0], in[1], in[2], in[3], ol, out[0], out[1], out[2], out[3]);
+      for (int j = 0; j < 4; j++) {
+        Hacl_SHA3_shake256_hacl(il, in[j], ol, expected);
+        ok &= memcmp(out[j], expected, ol) == 0;
+      }
+    }
+  }
+  printf("SHAKE128/SHAKE256 4-lane vs scalar: %s\n", ok ? "Success!" : "**FAILED**");
+  return ok;
+}
+
+int main(){
+  EverCrypt_AutoConfig2_init();
+  if (!EverCrypt_AutoConfig2_has_vec256()) {
+      printf("The current hardware doesn't support vec256: aborting\n");
+      return EXIT_SUCCESS;
+  }
+  else {
+      printf("The current hardware supports vec256: performing the tests\n");
+  }
+
+  bool ok = test_lengths();
+
+  // FrodoKEM-1344 matrix rows: 18-byte seeds, 2 * 1344 bytes of output
+  static uint8_t r[4][OUT_LEN];
+  cycles a,b;
+  clock_t t1,t2;
+
+  t1 = clock();
+  a = cpucycles_begin();
+  for (int i = 0; i < ROUNDS; i++) {
+    for (int j = 0; j < 4; j++)
+      Hacl_SHA3_shake128_hacl(18, in[j], OUT_LEN, r[j]);
+  }
+  b = cpucycles_end();
+  t2 = clock();
+  double cdiff1 = b - a;
+  double tdiff1 = t2 - t1;
+
+  t1 = clock();
+  a = cpucycles_begin();
+  for (int i = 0; i < ROUNDS; i++)
+    Hacl_SHA3_Vec256_shake128_vec256(18, in[0], in[1], in[2], in[3], OUT_LEN, r[0], r[1], r[2], r[3]);
+  b = cpucycles_end();
+  t2 = clock();
+  double cdiff2 = b - a;
+  double tdiff2 = t2 - t1;
+
+  uint64_t count = (uint64_t)ROUNDS * 4 * OUT_LEN;
+  printf("SHAKE128 (scalar, 4 inputs) PERF: %d\n", (int)r[0][0]); print_time(count,tdiff1,cdiff1);
+  printf("SHAKE128 (4-lane vec256) PERF: %d\n", (int)r[0][0]); print_time(count,tdiff2,cdiff2);
+
+  if (ok) return EXIT_SUCCESS;
+  else return EXIT_FAILURE;
+}